@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.graph;
+
+import java.io.BufferedReader;
+import java.io.BufferedWriter;
+import java.io.File;
+import java.io.FileReader;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.nio.channels.FileChannel;
+import java.nio.file.StandardOpenOption;
+import java.util.Arrays;
+import java.util.Random;
+
+/**
+ * Throughput benchmark for the .gr parsers of the GraphFactory. It compares the line based parser
+ * (graphFromBufferedReaderGR) with the byte level GrParser, the ParallelGrParser, and with loading a binary snapshot of
+ * the same graph, both for reading only and for building the final graph, and reports the throughput in MB/s.
+ *
+ * Usage: GrParserBenchmark [file.gr] or GrParserBenchmark -random n m (writes a random graph to a temporary file).
+ * With gradle: gradle core:parserBenchmark -Pargs="-random 1000000 5000000"
+ *
+ * @author Max Bannach
+ */
+public class GrParserBenchmark {
+
+    /* number of measured runs per parser */
+    private static final int RUNS = 3;
+
+    public static void main(String[] args) throws Exception {
+        File file;
+        if (args.length == 3 && args[0].equals("-random")) {
+            file = File.createTempFile("jdrasil-benchmark", ".gr");
+            file.deleteOnExit();
+            writeRandomGraph(file, Integer.parseInt(args[1]), Integer.parseInt(args[2]), 123456789);
+        } else if (args.length == 1) {
+            file = new File(args[0]);
+        } else {
+            System.err.println("usage: GrParserBenchmark <file.gr> | -random <n> <m>");
+            return;
+        }
+        double mb = file.length() / (1024.0 * 1024.0);
+        System.out.printf("input: %s (%.1f MB)%n", file, mb);
+
+        // the parsers have to agree on the graph
+        Graph<Integer> expected = readWithReader(file);
+        Graph<Integer> actual = GraphFactory.graphFromGr(file);
+        if (expected.getNumVertices() != actual.getNumVertices() || expected.getNumberOfEdges() != actual.getNumberOfEdges()) {
+            throw new IllegalStateException("Parsers disagree on the graph!");
+        }
+        for (Integer v : expected) {
+            if (!expected.getNeighborhood(v).equals(actual.getNeighborhood(v)) || expected.getFillInValue(v) != actual.getFillInValue(v)) {
+                throw new IllegalStateException("Parsers disagree on vertex " + v);
+            }
+        }
+
+        // the parallel parser has to build the same graph
+        IntGraph<Integer> sequential, parallel;
+        try (FileChannel in = FileChannel.open(file.toPath(), StandardOpenOption.READ)) {
+            sequential = new GrParser(in).parse().toIntGraph();
+        }
+        try (FileChannel in = FileChannel.open(file.toPath(), StandardOpenOption.READ)) {
+            parallel = new ParallelGrParser(in).parse().toIntGraph();
+        }
+        if (sequential.getNumVertices() != parallel.getNumVertices() || !Arrays.equals(sequential.getTargets(), parallel.getTargets())) {
+            throw new IllegalStateException("Parallel parser disagrees on the graph!");
+        }
+        for (int v = 0; v < sequential.getNumVertices(); v++) {
+            if (sequential.neighborhoodStart(v) != parallel.neighborhoodStart(v)) {
+                throw new IllegalStateException("Parallel parser disagrees on vertex " + sequential.getVertex(v));
+            }
+        }
+
+        // a binary snapshot has to store the same graph
+        File snapshot = File.createTempFile("jdrasil-benchmark", ".snapshot");
+        snapshot.deleteOnExit();
+        GraphWriter.writeSnapshot(actual, snapshot);
+        Graph<Integer> loaded = GraphFactory.graphFromSnapshot(snapshot);
+        for (Integer v : expected) {
+            if (!expected.getNeighborhood(v).equals(loaded.getNeighborhood(v)) || expected.getFillInValue(v) != loaded.getFillInValue(v)) {
+                throw new IllegalStateException("Snapshot differs on vertex " + v);
+            }
+        }
+        double snapshotMb = snapshot.length() / (1024.0 * 1024.0);
+        System.out.printf("snapshot: %.1f MB%n", snapshotMb);
+
+        // measure
+        for (int run = 0; run < RUNS; run++) {
+            long t = System.nanoTime();
+            readWithReader(file);
+            report("line based parser + graph", mb, t);
+
+            t = System.nanoTime();
+            GrParser parser;
+            try (FileChannel in = FileChannel.open(file.toPath(), StandardOpenOption.READ)) {
+                parser = new GrParser(in).parse();
+            }
+            report("GrParser (parse only)", mb, t);
+
+            t = System.nanoTime();
+            parser.toIntGraph();
+            report("GrParser (to IntGraph)", mb, t);
+
+            t = System.nanoTime();
+            GraphFactory.graphFromGr(file);
+            report("GrParser + graph", mb, t);
+
+            t = System.nanoTime();
+            try (FileChannel in = FileChannel.open(file.toPath(), StandardOpenOption.READ)) {
+                new ParallelGrParser(in).parse();
+            }
+            report("ParallelGrParser (IntGraph)", mb, t);
+
+            t = System.nanoTime();
+            GraphFactory.snapshotFromFile(snapshot);
+            report("snapshot (load only)", snapshotMb, t);
+
+            t = System.nanoTime();
+            GraphFactory.graphFromSnapshot(snapshot);
+            report("snapshot + graph", snapshotMb, t);
+        }
+    }
+
+    /** Parse the file with the line based parser. */
+    private static Graph<Integer> readWithReader(File file) throws IOException {
+        try (BufferedReader in = new BufferedReader(new FileReader(file))) {
+            return GraphFactory.graphFromBufferedReaderGR(in);
+        }
+    }
+
+    /** Print the throughput of a measurement that started at time t. */
+    private static void report(String name, double mb, long t) {
+        double seconds = (System.nanoTime() - t) / 1e9;
+        System.out.printf("%-28s %8.3f s %10.1f MB/s%n", name, seconds, mb / seconds);
+    }
+
+    /** Write a random graph with n vertices and (about) m edges in .gr format. */
+    private static void writeRandomGraph(File file, int n, int m, long seed) throws IOException {
+        Random rng = new Random(seed);
+        try (BufferedWriter out = new BufferedWriter(new FileWriter(file), 1 << 16)) {
+            out.write("c random graph\n");
+            out.write("p tw " + n + " " + m + "\n");
+            for (int i = 0; i < m; i++) {
+                int u = 1 + rng.nextInt(n);
+                int v = 1 + rng.nextInt(n);
+                if (u == v) v = 1 + (v % n);
+                out.write(u + " " + v + "\n");
+            }
+        }
+    }
+}
@@ -24,6 +24,7 @@ import jdrasil.algorithms.lowerbounds.MinorMinWidthLowerbound;
 import jdrasil.algorithms.preprocessing.GraphReducer;
 import jdrasil.graph.Graph;
 import jdrasil.graph.GraphFactory;
+import jdrasil.graph.GraphWriter;
 import jdrasil.graph.TreeDecomposition;
 import jdrasil.utilities.JdrasilProperties;
 import jdrasil.utilities.logging.JdrasilLogger;
@@ -88,8 +89,7 @@ public class Approximation {
             }
 
             long tend = System.nanoTime();
-            System.out.print(decomposition);
-            System.out.println();
+            GraphWriter.writeTreeDecomposition(decomposition);
 
             LOG.info("");
             LOG.info("Tree-Width: " + decomposition.getWidth());
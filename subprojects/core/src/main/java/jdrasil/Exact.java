@@ -20,16 +20,22 @@ package jdrasil;
 
 import jdrasil.algorithms.GraphSplitter;
 import jdrasil.algorithms.exact.PidBT;
+import jdrasil.algorithms.exact.SpeculativePidBT;
 import jdrasil.algorithms.lowerbounds.MinorMinWidthLowerbound;
 import jdrasil.algorithms.postprocessing.NiceTreeDecomposition;
 import jdrasil.algorithms.preprocessing.GraphReducer;
+import jdrasil.algorithms.preprocessing.GraphRelabeler;
 import jdrasil.algorithms.upperbounds.GreedyPermutationDecomposer;
 import jdrasil.graph.Graph;
 import jdrasil.graph.GraphFactory;
+import jdrasil.graph.GraphWriter;
 import jdrasil.graph.TreeDecomposition;
+import jdrasil.utilities.Checkpoint;
 import jdrasil.utilities.JdrasilProperties;
+import jdrasil.utilities.MemoryBudget;
 import jdrasil.utilities.logging.JdrasilLogger;
 
+import java.io.File;
 import java.io.IOException;
 import java.util.logging.Logger;
 
@@ -50,6 +56,9 @@ public class Exact {
     /** Jdrasils Logger */
     private final static Logger LOG = Logger.getLogger(JdrasilLogger.getName());
 
+    /** Maximal time to wait for the last checkpoint after a signal, in milliseconds. */
+    private static final long SHUTDOWN_TIMEOUT = 60 * 1000;
+
     /**
      * Entry point to Jdrasil in exact mode. The program, started with this method, will read a graph from standard
      * input and compute an exact tree decomposition.
@@ -63,9 +72,22 @@ public class Exact {
         // if Jdrasil is used as standalone, use dimacs logging
         JdrasilLogger.setToDimacsLogging();
 
+        // write a last checkpoint of the running decomposers if we are terminated
+        if (JdrasilProperties.containsKey("c")) {
+            sun.misc.SignalHandler handler = signal -> {
+                LOG.info("received SIG" + signal.getName() + ", writing checkpoint");
+                Checkpoint.requestAll(SHUTDOWN_TIMEOUT);
+                System.exit(1);
+            };
+            sun.misc.Signal.handle( new sun.misc.Signal("TERM"), handler );
+            sun.misc.Signal.handle( new sun.misc.Signal("INT"), handler );
+        }
+
         try {
             // read graph from stdin
             Graph<Integer> input = GraphFactory.graphFromStdin();
+            // store the input as binary snapshot for fast reloading
+            if (JdrasilProperties.containsKey("b")) GraphWriter.writeSnapshot(input, new File(JdrasilProperties.getProperty("b")));
 
 			/* Compute a explicit decomposition */
             long tstart = System.nanoTime();
@@ -80,13 +102,40 @@ public class Exact {
                 int lb = new MinorMinWidthLowerbound<>(H).call();
                 if (lb < 4) lb = 4; // we know this from preprocessing
 
+                // memory budget for the memorization, shared by all PID-BT calls (atoms may be solved in parallel)
+                MemoryBudget budget = new MemoryBudget(JdrasilProperties.containsKey("m")
+                        ? Long.parseLong(JdrasilProperties.getProperty("m")) << 20
+                        : Runtime.getRuntime().maxMemory() / 4);
+
+                // checkpoints of the PID-BT calls, every atom has its own snapshot file named by its fingerprint
+                long checkpointInterval = Checkpoint.getInterval();
+
                 // use the separator based decomposer, i.e., split the graph using safe seperators and decompose the atoms
                 GraphSplitter<Integer> splitter = new GraphSplitter<Integer>(H, atom -> {
                     try {
-                        int atomLB = new MinorMinWidthLowerbound<>(atom).call();
-                        TreeDecomposition<Integer> ubDecomposition = new GreedyPermutationDecomposer<>(atom).call();
-                        PidBT<Integer> pidBT = new PidBT<>(atom, atomLB, ubDecomposition.getWidth(), ubDecomposition);
-                        return pidBT.call();
+                        // number the vertices of the atom such that neighbors are close to each other in the bitsets
+                        GraphRelabeler<Integer> relabeler = new GraphRelabeler<>(atom, GraphRelabeler.Order.RCM);
+                        Graph<Integer> G = relabeler.getRelabeledGraph();
+                        int atomLB = new MinorMinWidthLowerbound<>(G).call();
+                        TreeDecomposition<Integer> ubDecomposition = new GreedyPermutationDecomposer<>(G).call();
+                        int atomUB = ubDecomposition.getWidth();
+
+                        // test several widths at once if the gap is large enough (not with checkpoints), or a single width at a time
+                        if (JdrasilProperties.containsKey("speculative") && !JdrasilProperties.containsKey("c") && atomUB - atomLB > 1) {
+                            int runs = Math.min(atomUB - atomLB, Runtime.getRuntime().availableProcessors());
+                            return relabeler.restoreTreeDecomposition(new SpeculativePidBT<>(G, atomLB, atomUB, ubDecomposition, budget, runs).call());
+                        }
+                        PidBT<Integer> pidBT = new PidBT<>(G, atomLB, atomUB, ubDecomposition, budget);
+                        try {
+                            pidBT.setParallel(JdrasilProperties.containsKey("parallel"));
+                            if (JdrasilProperties.containsKey("c")) {
+                                pidBT.setCheckpoint(new File(JdrasilProperties.getProperty("c")), checkpointInterval);
+                                if (JdrasilProperties.containsKey("resume")) pidBT.resume();
+                            }
+                            return relabeler.restoreTreeDecomposition(pidBT.call());
+                        } finally {
+                            pidBT.release(); // also if resuming failed, such that other atoms can use the budget
+                        }
                     } catch (Exception e) {
                         LOG.warning(e.getMessage());
                         return null;
@@ -100,8 +149,7 @@ public class Exact {
             }
 
             long tend = System.nanoTime();
-            System.out.print(decomposition);
-            System.out.println();
+            GraphWriter.writeTreeDecomposition(decomposition);
 
             LOG.info("");
             LOG.info("Tree-Width: " + decomposition.getWidth());
@@ -24,11 +24,14 @@ import jdrasil.algorithms.upperbounds.PaceGreedyDegreeDecomposer;
 import jdrasil.algorithms.upperbounds.StochasticGreedyPermutationDecomposer;
 import jdrasil.graph.Graph;
 import jdrasil.graph.GraphFactory;
+import jdrasil.graph.GraphWriter;
 import jdrasil.graph.TreeDecomposition;
+import jdrasil.sat.Formula;
 import jdrasil.utilities.JdrasilProperties;
 import jdrasil.utilities.logging.JdrasilLogger;
 import sun.misc.Signal;
 
+import java.io.File;
 import java.io.IOException;
 import java.util.List;
 import java.util.logging.Logger;
@@ -105,6 +108,8 @@ public class Heuristic implements sun.misc.SignalHandler {
         try {
             // read graph from stdin
             input = GraphFactory.graphFromStdin();
+            // store the input as binary snapshot for fast reloading
+            if (JdrasilProperties.containsKey("b")) GraphWriter.writeSnapshot(input, new File(JdrasilProperties.getProperty("b")));
             int upperBound = input.getNumVertices();
             boolean needsPostProcessing = false;
             List<Integer> perm = null;
@@ -195,7 +200,11 @@ public class Heuristic implements sun.misc.SignalHandler {
         }
         this.decomposition.connectComponents();
         tend = System.nanoTime();
-        System.out.println(this.decomposition);
+        try {
+            GraphWriter.writeTreeDecomposition(this.decomposition);
+        } catch (IOException e) {
+            e.printStackTrace();
+        }
         LOG.info("");
         LOG.info("Tree-Width: " + decomposition.getWidth());
         LOG.info("Used " + (tend-tstart)/1000000000 + " seconds");
@@ -208,6 +217,7 @@ public class Heuristic implements sun.misc.SignalHandler {
 
 
         Heuristic.shutdownFlag = true;
+        Formula.signalShutdown();
 //        // catch super early abort
 //        if (input == null) {
 //            LOG.warning("Did not finish reading the graph!");
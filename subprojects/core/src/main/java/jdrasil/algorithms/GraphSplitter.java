@@ -179,7 +179,7 @@ public class GraphSplitter<T extends Comparable<T>> extends RecursiveTask<TreeDe
         if (mode.ordinal() >= targetConnectivity.ordinal()) mode = Connectivity.ATOM;
 
         // if connectivity is set to DC, we will only compute connected components (i.e., there is an empty separator).
-        if (mode == Connectivity.DC && graph.getConnectedComponents().size() > 1) {
+        if (mode == Connectivity.DC && new IntGraph<>(graph).getNumberOfConnectedComponents() > 1) {
             LOG.info("separate into connected components");
             return forkOnSeparator(new HashSet<>(), Connectivity.CC);
         } else if (mode == Connectivity.DC) {
@@ -367,8 +367,8 @@ public class GraphSplitter<T extends Comparable<T>> extends RecursiveTask<TreeDe
     private TreeDecomposition<T> forkOnSeparator(Set<T> S, Connectivity connectivity) {
         LOG.info("Forking on cut of size: " + S.size());
 
-        // 1. compute connected components of G[V\S]
-        Set<Graph<T>> components = new ConnectedComponents<T>(graph, S).getAsSubgraphs();
+        // 1. compute connected components of G[V\S] (on the compressed representation, as this is done at every fork)
+        List<Graph<T>> components = new IntGraph<>(graph).getComponentsAsSubgraphs(S);
 
         // 2. add the separator S as clique to each component
         for (Graph<T> C : components) {
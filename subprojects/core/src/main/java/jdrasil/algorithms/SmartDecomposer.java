@@ -3,6 +3,7 @@ package jdrasil.algorithms;
 import jdrasil.algorithms.exact.CatchAndGlue;
 import jdrasil.algorithms.lowerbounds.MinorMinWidthLowerbound;
 import jdrasil.algorithms.preprocessing.GraphReducer;
+import jdrasil.algorithms.preprocessing.GraphRelabeler;
 import jdrasil.algorithms.upperbounds.PaceGreedyDegreeDecomposer;
 import jdrasil.algorithms.upperbounds.StochasticGreedyPermutationDecomposer;
 import jdrasil.graph.Graph;
@@ -86,7 +87,10 @@ public class SmartDecomposer<T extends Comparable<T>> implements TreeDecomposer<
         int lb = Math.max(4, new MinorMinWidthLowerbound<>(H).call());
         GraphSplitter<T> splitter = new GraphSplitter<T>(H, atom -> {
             try {
-                if (shouldSolveExactly() && atom.getNumVertices() < ATOM_EXACT_CAP) return new CatchAndGlue<T>(atom).call();
+                if (shouldSolveExactly() && atom.getNumVertices() < ATOM_EXACT_CAP) {
+                    GraphRelabeler<T> relabeler = new GraphRelabeler<>(atom, GraphRelabeler.Order.RCM);
+                    return relabeler.restoreTreeDecomposition(new CatchAndGlue<>(relabeler.getRelabeledGraph()).call());
+                }
                 return new StochasticGreedyPermutationDecomposer<>(atom).call();
             } catch (Exception e) {
                 LOG.warning(e.getMessage());
@@ -24,12 +24,13 @@ import java.util.*;
 import jdrasil.algorithms.EliminationOrderDecomposer;
 import jdrasil.algorithms.lowerbounds.MinorMinWidthLowerbound;
 import jdrasil.algorithms.upperbounds.GreedyPermutationDecomposer;
+import jdrasil.datastructures.PartitionRefinement;
+import jdrasil.graph.EliminationGraph;
 import jdrasil.graph.Graph;
 import jdrasil.graph.GraphFactory;
 import jdrasil.graph.TreeDecomposer;
 import jdrasil.graph.TreeDecomposition;
 import jdrasil.graph.TreeDecomposition.TreeDecompositionQuality;
-import jdrasil.graph.invariants.TwinDecomposition;
 
 /**
  * A classical branch and bound algorithm based on QuickBB and its successors.
@@ -43,8 +44,11 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 
 	private static final long serialVersionUID = -6506020235954373541L;
 
-	/** The graph we wish to decompose. (changes during computation) */
-	private final Graph<T> graph, original;
+	/** The graph we wish to decompose. */
+	private final Graph<T> original;
+
+	/** The graph on which the elimination game is played. (changes during computation) */
+	private final EliminationGraph<T> graph;
 	
 	/** The size of the original graph. */
 	private int n;
@@ -54,38 +58,34 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 
 	/** An lower bound on the tree-width of the graph. */
 	private int lb;
-
-	/** Map the vertices of the graph to IDs */
-	private final Map<T, Integer> vertexToID;
 	
 	/** Store the nodes that where already explored. */
 	private final Map<Node, Integer> memorization;
 	
-	/** Store the vertex for every subgraph that has to be eliminated. */
-	private final Map<BitSet, T> vertexToEliminate;
+	/** Store the vertex (id) for every subgraph that has to be eliminated. */
+	private final Map<BitSet, Integer> vertexToEliminate;
 	
 	/** A clique of the graph, we can eliminate this at last. */
-	private Set<T> clique;
+	private Set<Integer> clique;
 	
 	/** The elimination order we try to compute. */
 	private List<T> permutation;
 
+	/** Stamp array used to mark neighborhoods. */
+	private final int[] mark;
+	private int stamp;
+
 	/**
 	 * The default constructor that initializes all the variables and data structures.
 	 * @param graph
 	 */
 	public BranchAndBoundDecomposer(Graph<T> graph) {
-		this.graph = GraphFactory.copy(graph);
+		this.graph = new EliminationGraph<>(graph, true);
 		this.original = GraphFactory.copy(graph);
-		this.n = graph.getCopyOfVertices().size();
-		this.vertexToID = new HashMap<>();
+		this.n = this.graph.getNumIds();
 		this.vertexToEliminate = new HashMap<>();
-		int id = 0;
-		for (T v : graph) {
-			this.vertexToID.put(v, id);
-			id++;
-		}
 		this.memorization = new HashMap<>();
+		this.mark = new int[n];
 		this.ub = n;
 	}
 	
@@ -96,22 +96,23 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 		// all vertices eliminated so far
 		BitSet eliminatedVertices;
 		
-		// vertex currently eliminated
-		T currentVertex;
+		// vertex currently eliminated (-1 at the root)
+		int currentVertex;
 		
 		// width of the (partial) permutation represented by this node.
 		int width;
 		
 		public Node() {
 			this.width = 0;
+			this.currentVertex = -1;
 			this.eliminatedVertices = new BitSet(); 
 		}
 		
-		public Node(Node node, T v) {
+		public Node(Node node, int v) {
 			this.eliminatedVertices = (BitSet) node.eliminatedVertices.clone();
-			this.eliminatedVertices.set(vertexToID.get(v));
+			this.eliminatedVertices.set(v);
 			this.currentVertex = v;
-			this.width = Math.max(node.width, graph.getNeighborhood(v).size());
+			this.width = Math.max(node.width, graph.getDegree(v));
 		}
 				
 		@Override
@@ -124,7 +125,7 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 			if(obj instanceof BranchAndBoundDecomposer.Node) {
 				Node n = (BranchAndBoundDecomposer.Node) obj;
 				return this.eliminatedVertices.equals(n.eliminatedVertices)
-						&& currentVertex.equals(n.currentVertex);
+						&& currentVertex == n.currentVertex;
 			}
 			return  false;
 			//return this.hashCode() == obj.hashCode();
@@ -157,7 +158,7 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 	 * @return
 	 */
 	private boolean solution(Node node) {
-		if (graph.getCopyOfVertices().size() == 0) {
+		if (graph.getNumVertices() == 0) {
 			if (node.width < ub) { // new optimum
 				List<T> tmp = getPermutation();
 				if (tmp != null) permutation = tmp;
@@ -193,6 +194,87 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 		// all prune rules failed
 		return false;
 	}
+
+	/**
+	 * Returns an arbitrary simplicial vertex of the current graph that is not in the forbidden set, or -1.
+	 * The fill-in values are maintained by the elimination graph, so this costs O(n).
+	 * @param forbidden
+	 * @return
+	 */
+	private int getSimplicialVertex(Set<Integer> forbidden) {
+		for (int v = 0; v < n; v++) {
+			if (graph.isEliminated(v) || forbidden.contains(v)) continue;
+			if (graph.getFillInValue(v) == 0) return v;
+		}
+		return -1;
+	}
+
+	/**
+	 * Returns an arbitrary almost simplicial vertex of the current graph that is not in the forbidden set, or -1.
+	 * A vertex is returned if all non-edges in its neighborhood share exactly one common endpoint.
+	 * @param forbidden
+	 * @return
+	 */
+	private int getAlmostSimplicialVertex(Set<Integer> forbidden) {
+		search: for (int v = 0; v < n; v++) {
+			if (graph.isEliminated(v) || forbidden.contains(v)) continue;
+			if (graph.getFillInValue(v) == 0) continue; // no non-edges in the neighborhood
+			int a = -1, b = -1; // the common endpoints of all non-edges seen so far
+			boolean first = true;
+			int d = graph.getDegree(v);
+			for (int i = 0; i < d; i++) {
+				int x = graph.getNeighbor(v, i);
+				int s = nextStamp();
+				for (int k = 0; k < graph.getDegree(x); k++) mark[graph.getNeighbor(x, k)] = s;
+				for (int j = i+1; j < d; j++) {
+					int y = graph.getNeighbor(v, j);
+					if (mark[y] == s) continue;
+					if (first) {
+						a = x; b = y;
+						first = false;
+					} else {
+						if (a != x && a != y) a = -1;
+						if (b != x && b != y) b = -1;
+						if (a == -1 && b == -1) continue search;
+					}
+				}
+			}
+			if (a == -1 || b == -1) return v; // exactly one common endpoint
+		}
+		return -1;
+	}
+
+	/**
+	 * Computes one representative of every twin class of the current graph, since we have to branch to only one vertex
+	 * of each twin group (see TwinDecomposition).
+	 * @return the representatives
+	 */
+	private List<Integer> getTwinRepresentatives() {
+		Set<Integer> universe = new HashSet<>();
+		for (int v = 0; v < n; v++) if (!graph.isEliminated(v)) universe.add(v);
+		// the partition refinement works in place on the given set, so each gets its own copy
+		PartitionRefinement<Integer> trueTwins = new PartitionRefinement<>(new HashSet<>(universe));
+		PartitionRefinement<Integer> falseTwins = new PartitionRefinement<>(new HashSet<>(universe));
+		for (int v : universe) {
+			Set<Integer> Nv = new HashSet<>();
+			for (int i = 0; i < graph.getDegree(v); i++) Nv.add(graph.getNeighbor(v, i));
+			falseTwins.refine(Nv);
+			Nv.add(v);
+			trueTwins.refine(Nv);
+		}
+		Map<Integer, Set<Integer>> trueClasses = trueTwins.getPartition();
+		Map<Integer, Set<Integer>> falseClasses = falseTwins.getPartition();
+		List<Integer> representatives = new ArrayList<>();
+		int s = nextStamp();
+		for (int v : universe) {
+			Set<Integer> S = trueClasses.get(v).size() > falseClasses.get(v).size() ? trueClasses.get(v) : falseClasses.get(v);
+			int w = S.iterator().next();
+			if (mark[w] == s) continue;
+			mark[w] = s;
+			representatives.add(w);
+		}
+		return representatives;
+	}
 	
 	/**
 	 * Compute a list of successor nodes of the given node,
@@ -204,31 +286,27 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 		List<Node> children = new LinkedList<>();
 				
 		// if there is a simplicial vertex, that is not in the clique, we can simply use that
-		T simple = graph.getSimplicialVertex(clique);
-		if (simple != null) {
+		int simple = getSimplicialVertex(clique);
+		if (simple >= 0) {
 			children.add(new Node(node, simple));
 			return children;
 		}
 		
 		// if there is an almost simplicial vertex, that is not in the clique, we can simply use that
-		T almostSimple = graph.getAlmostSimplicialVertex(clique);
-		if (almostSimple != null && graph.getNeighborhood(almostSimple).size()+1 <= lb) {
+		int almostSimple = getAlmostSimplicialVertex(clique);
+		if (almostSimple >= 0 && graph.getDegree(almostSimple)+1 <= lb) {
 			children.add(new Node(node, almostSimple));
 			return children;
 		}
 
 		// compute a twin decomposition of the graph, since we have to branch to only one vertex of each twin group
-		Map<T, Set<T>> twins = new TwinDecomposition<T>(graph).getModel();
-		for (Set<T> S : twins.values()) {
-
-			// we only have to consider one vertex in each set
-			T v = S.iterator().next();
+		for (int v : getTwinRepresentatives()) {
 
 			// we can skip the clique until the graph is almost empty
 			if (clique.contains(v)) continue;
 
 			// we can ignore neighbors, this costs O(1)
-			if (graph.isAdjacent(v, node.currentVertex)) continue;
+			if (node.currentVertex >= 0 && graph.isAdjacent(v, node.currentVertex)) continue;
 
 			// if we reach this point, we have to branch to v
 			children.add(new Node(node, v));
@@ -240,13 +318,13 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 			int fillIn_v = graph.getFillInValue(v.currentVertex);
 			if (fillIn_u < fillIn_v) return 1;
 			if (fillIn_u > fillIn_v) return -1;
-			return u.currentVertex.compareTo(v.currentVertex); // natural ordering
+			return graph.getVertex(u.currentVertex).compareTo(graph.getVertex(v.currentVertex)); // natural ordering
 		});
 
 		// at the end, we simply eliminate the clique
 		if (children.size() == 0) {
-			for (T v : clique) {
-				if (graph.getCopyOfVertices().contains(v)) {
+			for (int v : clique) {
+				if (!graph.isEliminated(v)) {
 					children.add(new Node(node, v));
 					break;
 				}
@@ -259,39 +337,30 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 	
 	/**
 	 * Compute edges for the edge addition rule and add them to the graph.
-	 * @return
+	 * The edges are recorded in the history of the elimination graph and are removed by a rollback.
 	 */
-	private List<T> edgeAdditionRule() {
-		List<T> edgesToAdd = new ArrayList<>();
-		for (T v : graph) {
-			for (T w : graph) {
-				if (v.compareTo(w) < 0 && !graph.isAdjacent(v, w)) {
-					if (Math.min(graph.getNeighborhood(v).size(), graph.getNeighborhood(w).size()) <= ub) continue;
-					int commonNeighbors = 0;
-					for (T x : graph.getNeighborhood(w)) {
-						if (graph.isAdjacent(v, x)) commonNeighbors++;
-					}
-					if (commonNeighbors > ub + 1) {
-						edgesToAdd.add(v);
-						edgesToAdd.add(w);
-					}
+	private void edgeAdditionRule() {
+		List<Integer> edgesToAdd = new ArrayList<>();
+		for (int v = 0; v < n; v++) {
+			if (graph.isEliminated(v) || graph.getDegree(v) <= ub) continue;
+			int s = nextStamp();
+			for (int i = 0; i < graph.getDegree(v); i++) mark[graph.getNeighbor(v, i)] = s;
+			for (int w = v+1; w < n; w++) {
+				if (graph.isEliminated(w) || mark[w] == s) continue;
+				if (graph.getDegree(w) <= ub) continue;
+				int commonNeighbors = 0;
+				for (int i = 0; i < graph.getDegree(w); i++) {
+					if (mark[graph.getNeighbor(w, i)] == s) commonNeighbors++;
+				}
+				if (commonNeighbors > ub + 1) {
+					edgesToAdd.add(v);
+					edgesToAdd.add(w);
 				}
 			}
 		}
 		for (int i = 0; i < edgesToAdd.size()-1; i += 2) {
 			graph.addEdge(edgesToAdd.get(i), edgesToAdd.get(i+1));
 		}
-		return edgesToAdd;
-	}
-	
-	/**
-	 * Revert edge addition rules
-	 * @param edges
-	 */
-	private void removeAddedEdges(List<T> edges) {
-		for (int i = 0; i < edges.size()-1; i += 2) {
-			graph.removeEdge(edges.get(i), edges.get(i+1));
-		}
 	}
 	
 	/**
@@ -308,16 +377,17 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 		if (tw == null) {
 			
 			// the best vertex to branch to
-			T branchVertex = null;
+			int branchVertex = -1;
 			
 			// Edge Addition Rule
-			List<T> edgesToRemove = edgeAdditionRule();
+			int checkpoint = graph.getCheckpoint();
+			edgeAdditionRule();
 			
 			// handle children
 			tw = Integer.MAX_VALUE;
 			for (Node child : branch(node)) {
-				int delta = child.currentVertex == null ? 0 : graph.getNeighborhood(child.currentVertex).size();
-				Graph<T>.EliminationInformation info = graph.eliminateVertex(child.currentVertex);
+				int delta = graph.getDegree(child.currentVertex);
+				graph.eliminateVertex(child.currentVertex);
 				
 				// store current branch
 				vertexToEliminate.put(node.eliminatedVertices, child.currentVertex);
@@ -329,14 +399,14 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 					branchVertex = child.currentVertex;				
 				}
 				
-				graph.deEliminateVertex(info);
+				graph.undo();
 			}
 			
 			// remove added edges
-			removeAddedEdges(edgesToRemove);
+			graph.rollback(checkpoint);
 			
 			// node is completely handled, store the result
-			vertexToEliminate.put(node.eliminatedVertices, branchVertex);
+			vertexToEliminate.put(node.eliminatedVertices, branchVertex >= 0 ? branchVertex : null);
 			remember(node, tw);	
 		}
 		
@@ -353,31 +423,42 @@ public class BranchAndBoundDecomposer<T extends Comparable<T>> implements TreeDe
 
 		// recompute the permutation
 		BitSet subgraph = new BitSet();
-		while (subgraph.cardinality() < original.getCopyOfVertices().size()) {
-			T v = vertexToEliminate.get(subgraph);
+		while (subgraph.cardinality() < n) {
+			Integer v = vertexToEliminate.get(subgraph);
 			if (v == null) return null; // this happens if BB() does not improve the ub -> fast prune
-			permutation.add(v);
-			subgraph.set(vertexToID.get(v));
+			permutation.add(graph.getVertex(v));
+			subgraph.set(v);
 		}	
 		
 		return permutation;
 	}
+
+	/**
+	 * A fresh stamp for the mark array.
+	 */
+	private int nextStamp() {
+		if (stamp == Integer.MAX_VALUE) {
+			Arrays.fill(mark, 0);
+			stamp = 0;
+		}
+		return ++stamp;
+	}
 	
 	@Override
 	public TreeDecomposition<T> call() throws Exception {		
 		
 		// catch the empty graph
-		if (graph.getCopyOfVertices().size() == 0) return new TreeDecomposition<T>(graph);
+		if (n == 0) return new TreeDecomposition<T>(original);
 				
 		// compute upper and lower bounds
-		GreedyPermutationDecomposer<T> MinFill = new GreedyPermutationDecomposer<T>(graph);
+		GreedyPermutationDecomposer<T> MinFill = new GreedyPermutationDecomposer<T>(original);
 		ub = MinFill.call().getWidth();
-		lb = new MinorMinWidthLowerbound<T>(graph).call();
+		lb = new MinorMinWidthLowerbound<T>(original).call();
 		permutation = MinFill.getPermutation();
 
 		// we can safely eliminate a clique at last
 //		this.clique = new Clique<T>(graph).getClique();
-		this.clique = new HashSet<T>();
+		this.clique = new HashSet<Integer>();
 
 		// call the branch and bound algorithm to find an optimal solution, this is any time so the currently best
 		//  solution is always available
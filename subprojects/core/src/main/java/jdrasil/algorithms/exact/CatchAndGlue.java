@@ -22,6 +22,7 @@ import jdrasil.algorithms.lowerbounds.MinorMinWidthLowerbound;
 import jdrasil.algorithms.upperbounds.GreedyPermutationDecomposer;
 import jdrasil.graph.*;
 import jdrasil.datastructures.BitSetTrie;
+import jdrasil.datastructures.VertexSet;
 import jdrasil.utilities.logging.JdrasilLogger;
 
 import java.util.*;
@@ -81,7 +82,7 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
      * As the cops have a winning strategy if \(V\) is a winning configuration, we will use a priority queue to
      * handle big subgraphs first (in the hope of reaching \(V\) faster).
      */
-    private PriorityQueue<BitSet> queue;
+    private PriorityQueue<VertexSet> queue;
 
     /** Number of configurations processed during the run (i.e. configurations that where added to the queue) */
     private int configurations;
@@ -93,7 +94,10 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
     private Map<Integer, BitSetTrie> tries;
 
     /** Each element added to the queue is glued from one or more previous winning configurations. */
-    private Map<BitSet, BitSet[]> from;
+    private Map<VertexSet, VertexSet[]> from;
+
+    /* Scratch sets used by offer() and decompose(). */
+    private VertexSet neighbors, delta, mask, neighborsPrime, currentNeighbors, glueMask, glueNeighbors;
 
     /**
      * Initialize data structures and transform the graph into a BitSetGraph.
@@ -106,6 +110,13 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
         this.memory = new BitSetTrie();
         this.from   = new HashMap<>();
         this.tries  = new HashMap<>();
+        this.neighbors        = new VertexSet(n);
+        this.delta            = new VertexSet(n);
+        this.mask             = new VertexSet(n);
+        this.neighborsPrime   = new VertexSet(n);
+        this.currentNeighbors = new VertexSet(n);
+        this.glueMask         = new VertexSet(n);
+        this.glueNeighbors    = new VertexSet(n);
         setMode(Mode.improveLowerbound);
     }
 
@@ -142,7 +153,7 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
      * @param from array of win-configurations from which S was glued (may be at least one)
      * @return
      */
-    private boolean offer(BitSet S, int k, BitSet... from) {
+    private boolean offer(VertexSet S, int k, VertexSet... from) {
 
         // Prune 1: we have to handle each configuration just ones
         if (memory.contains(S)) return false;
@@ -150,9 +161,9 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
         // Prune 2: if the configuration requires to many cops, we can prune it as well
         // The configuration needs cops on its border (otherwise the robber could escape), as well as the cops
         // that are used to produce the next configuration by "fly" on the new vertices (as the robber can move in between).
-        BitSet neighbors = graph.computeExteriorBorder(S);
-        BitSet delta = (BitSet) S.clone();
-        for (BitSet f : from) delta.andNot(f);
+        graph.computeExteriorBorder(S, neighbors);
+        delta.assign(S);
+        for (VertexSet f : from) delta.andNot(f);
         if (neighbors.cardinality() + delta.cardinality() > k + 1) return false; // not enough cops
 
         // we will eventually add S to the queue, store how we have glued it
@@ -163,32 +174,22 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
         if (S.cardinality() >= n - k - 1) {
             // create extra bag for remaining vertices
             if (S.cardinality() < n) {
-                BitSet all = new BitSet();
-                all.set(0, n);
-                this.from.put(all, new BitSet[]{S});
+                VertexSet all = new VertexSet(n).setAll();
+                this.from.put(all, new VertexSet[]{S});
             }
             return true;
         }
 
         // Prune 3: if we have handled a superset of S and N(S), we can prune S
-        BitSet mask = (BitSet) S.clone();
-        mask.or(neighbors);
+        mask.assign(S).or(neighbors);
         if (memory.getSuperSets(mask).iterator().hasNext()) {
             this.memory.insert(S);
             return false;
         }
 
         // Prune 4: if we have handled a superset S' of S such that N(S') is a subset of N(S) we can prune
-        for (BitSet Sprime : memory.getSuperSets(S)) {
-            BitSet neighborsPrime = graph.computeExteriorBorder(Sprime);
-            boolean cut = true;
-            for (int v = neighborsPrime.nextSetBit(0); v >= 0; v = neighborsPrime.nextSetBit(v + 1)) {
-                if (!neighbors.get(v)) {
-                    cut = false;
-                    break;
-                }
-            }
-            if (cut) {
+        for (VertexSet Sprime : memory.getSuperSets(S)) {
+            if (graph.computeExteriorBorder(Sprime, neighborsPrime).isSubsetOf(neighbors)) {
                 this.memory.insert(S);
                 return false;
             }
@@ -223,7 +224,7 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
 
         // pre-fill the queue with trivial win-configurations
         for (int v = 0; v < n; v++) {
-            BitSet S = new BitSet();
+            VertexSet S = new VertexSet(n);
             S.set(v);
             graph.saturate(S);
             if (offer(S, k)) return true;
@@ -233,46 +234,42 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
         while (!queue.isEmpty()) {
             configurations++;
             // get currently largest win-configuration
-            BitSet S = queue.poll();
-            BitSet delta = graph.computeExteriorBorder(S);
+            VertexSet S = queue.poll();
+            VertexSet border = graph.computeExteriorBorder(S);
 
             // handle the neighbors of S
-            for (int v = delta.nextSetBit(0); v >= 0; v = delta.nextSetBit(v+1)) {
+            for (int v = border.nextSetBit(0); v >= 0; v = border.nextSetBit(v+1)) {
 
                 // 1. add S to the trie of v
                 tries.get(v).insert(S);
 
                 // 2. try to extend S by removing a cop from v, i.e., find a direct predecessor configuration
-                BitSet newS = (BitSet) S.clone();
+                VertexSet newS = new VertexSet(S);
                 newS.set(v);
                 graph.saturate(newS);
                 if (offer(newS, k, S)) return true;
 
                 // 3. try to glue S to other win-configurations
-                Stack<BitSet> stack = new Stack<>();
+                Stack<VertexSet> stack = new Stack<>();
                 stack.push(S);
                 while (!stack.isEmpty()) {
-                    BitSet current = (BitSet) stack.pop().clone();
-                    BitSet currentNeighbors = graph.computeExteriorBorder(current);
-                    BitSet mask = (BitSet) current.clone();
-                    mask.or(currentNeighbors);
-                    mask.flip(0,n);
-                    for (BitSet toGlue : tries.get(v).getSubSets(mask)) {
-                        BitSet glueNeighbors = graph.computeExteriorBorder(toGlue);
-                        glueNeighbors.or(currentNeighbors);
+                    VertexSet current = stack.pop();
+                    graph.computeExteriorBorder(current, currentNeighbors);
+                    glueMask.assign(current).or(currentNeighbors).complement();
+                    for (VertexSet toGlue : tries.get(v).getSubSets(glueMask)) {
+                        graph.computeExteriorBorder(toGlue, glueNeighbors).or(currentNeighbors);
                         if (glueNeighbors.cardinality() > k+1) continue; // not enough cops
-                        newS = (BitSet) current.clone();
-                        newS.or(toGlue);
+                        newS = new VertexSet(current).or(toGlue);
 
                         int absorbable = graph.absorbable(newS);
                         if (absorbable < 0 || absorbable == v) {
-                            BitSet tmp = (BitSet) newS.clone();
+                            VertexSet tmp = new VertexSet(newS);
                             tmp.set(v); // may prevent us from offering
                             graph.saturate(tmp);
                             if (offer(tmp, k, current, toGlue)) return true;
                         }
                         if (absorbable < 0) {
-                            from.put(newS, new BitSet[]{current, toGlue});
+                            from.put(newS, new VertexSet[]{current, toGlue});
                             stack.push(newS);
                         }
 
@@ -294,16 +291,16 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
      * @param td
      * @return
      */
-    private Bag<T> extractTreeDecomposition(BitSet S, TreeDecomposition<T> td) {
+    private Bag<T> extractTreeDecomposition(VertexSet S, TreeDecomposition<T> td) {
         // 1. create current bag
-        BitSet bagVertices = (BitSet) S.clone();
+        VertexSet bagVertices = new VertexSet(S);
 
-        for (BitSet f : from.get(S)) bagVertices.andNot(f); // reduce to delta
+        for (VertexSet f : from.get(S)) bagVertices.andNot(f); // reduce to delta
         bagVertices.or(graph.computeExteriorBorder(S));            // add neighbors
         Bag<T> bag = td.createBag(graph.getVertexSet(bagVertices));
 
         // 2. compute children and glue to them
-        for (BitSet child : from.get(S)) {
+        for (VertexSet child : from.get(S)) {
             Bag<T> childBag = extractTreeDecomposition(child, td);
             td.addTreeEdge(bag, childBag);
         }
@@ -320,8 +317,7 @@ public class CatchAndGlue<T extends Comparable<T>> implements TreeDecomposer<T>
         int k = 0;
 
         // helper mask for the whole graph
-        BitSet all = new BitSet();
-        all.set(0,n);
+        VertexSet all = new VertexSet(n).setAll();
 
         // either improve a lower- or an upper-bound
         switch (this.mode) {
@@ -108,7 +108,7 @@ public class CopsAndRobber<T extends Comparable<T>> implements TreeDecomposer<T>
 		this.vertexToInt = new HashMap<>();
 		this.intToVertex = new HashMap<>();
 		int i = 0;
-		for (T v : graph) {
+		for (T v : graph.getSortedVertices()) {
 			vertexToInt.put(v, i);
 			intToVertex.put(i,v);
 			i = i+1;			
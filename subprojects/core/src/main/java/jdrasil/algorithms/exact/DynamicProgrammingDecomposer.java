@@ -18,7 +18,12 @@
  */
 package jdrasil.algorithms.exact;
 
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.IOException;
 import java.io.Serializable;
+import java.util.Arrays;
 import java.util.BitSet;
 import java.util.HashMap;
 import java.util.HashSet;
@@ -28,17 +33,30 @@ import java.util.Map;
 import java.util.Queue;
 import java.util.Set;
 import java.util.Stack;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.stream.IntStream;
 
 import jdrasil.algorithms.EliminationOrderDecomposer;
+import jdrasil.datastructures.LongIntHashMap;
 import jdrasil.graph.Graph;
 import jdrasil.graph.TreeDecomposer;
 import jdrasil.graph.TreeDecomposition;
 import jdrasil.graph.TreeDecomposition.TreeDecompositionQuality;
+import jdrasil.utilities.Checkpoint;
+import jdrasil.utilities.JdrasilProperties;
 
 /**
  * This class implements exact exponential time (and exponential space) algorithms to compute a tree-decomposition via dynamic programming.
  * The algorithms are based on "On Exact Algorithms for Treewidth" from Bodlaender, Fomin, Koster, Kratsch, and Thilikos (ESA 2006)
  * 
+ * In TWDP mode, the computation can be stored in a checkpoint (@see setCheckpoint(File, long)) after each completed layer
+ * TW_i, together with the vertices to eliminate. The memorization of Q is not stored, as it can be recomputed. If no
+ * checkpoint was set, @see call() uses the one given by the properties -c, -i, and -resume.
+ * 
+ * The mode parallelTWDP computes the layers of TWDP in parallel for graphs with at most 64 vertices, using 64 bit keys
+ * and primitive hash tables (@see parallelTWDP(int, java.util.BitSet)). For larger graphs, it falls back to TWDP.
+ * 
  * @param <T>
  * @author Max Bannach
  */
@@ -74,16 +92,22 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 	/** A clique in the graph */
 	private BitSet clique;
 	
-	/** Three implementation modes of the cited paper. The optimized (and default) version is TWDP. */
+	/** Three implementation modes of the cited paper. The optimized (and default) version is TWDP, which also has a parallel version. */
 	public enum Mode {
 		simpleDP,
 		recursiveDP,
-		TWDP
+		TWDP,
+		parallelTWDP
 	}
 	
 	/** The used mode. */
 	private final Mode mode;
 	
+	/** Checkpoint of TWDP, and the layer and upper bound restored from it (or -1) */
+	private transient Checkpoint checkpoint;
+	private int resumeLayer = -1;
+	private int resumeUB;
+	
 	
 	/**
 	 * The default constructor that initializes variables and data structures.
@@ -103,7 +127,7 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 		this.vertexToInt = new HashMap<>();
 		this.intToVertex = new HashMap<>();
 		int i = 0;
-		for (T v : graph) {
+		for (T v : graph.getSortedVertices()) {
 			vertexToInt.put(v, i);
 			intToVertex.put(i,v);
 			i = i+1;			
@@ -156,6 +180,92 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 		this(graph, graph.getCopyOfVertices().size()-1, new HashSet<T>(), mode);
 	}
 	
+	/**
+	 * Store the layers of TWDP periodically in a file, see @see jdrasil.utilities.Checkpoint.
+	 * @param file the base name of the file that stores the snapshot, which is extended by the fingerprint
+	 * @param intervalMillis the interval between two snapshots in milliseconds
+	 */
+	public void setCheckpoint(File file, long intervalMillis) {
+		this.checkpoint = new Checkpoint(file, intervalMillis, "DynamicProgrammingDecomposer", fingerprint());
+	}
+	
+	/**
+	 * A fingerprint of the graph (with the numbering of the vertices) and of the clique, which identifies the snapshots.
+	 * @return a hash of the adjacency of the graph
+	 */
+	private long fingerprint() {
+		long fingerprint = n;
+		for (int v = 0; v < n; v++) {
+			BitSet row = new BitSet();
+			for (T w : graph.getNeighborhood(intToVertex.get(v))) row.set(vertexToInt.get(w));
+			fingerprint = fingerprint * 0x9E3779B97F4A7C15L + row.hashCode();
+		}
+		return fingerprint * 31 + clique.hashCode();
+	}
+	
+	/**
+	 * Restore the last completed layer of TWDP from the checkpoint, if there is a snapshot for this graph. The next call
+	 * of @see call() continues with the following layer.
+	 * @return true if a snapshot was restored
+	 * @throws IOException if the snapshot could not be read
+	 */
+	public boolean resume() throws IOException {
+		if (checkpoint == null || mode != Mode.TWDP) return false;
+		try (DataInputStream in = checkpoint.open()) {
+			if (in == null) return false;
+			resumeLayer = in.readInt();
+			resumeUB = in.readInt();
+			Map<BitSet, Integer> layer = new HashMap<>();
+			readTable(in, layer);
+			TWi.put(resumeLayer, layer);
+			readTable(in, vertexToEliminate);
+		}
+		return true;
+	}
+	
+	/**
+	 * Write a completed layer of TWDP and the vertices to eliminate to the checkpoint.
+	 * @param i the index of the layer
+	 * @param ub the current upper bound
+	 */
+	private void writeCheckpoint(int i, int ub) {
+		checkpoint.write(out -> {
+			out.writeInt(i);
+			out.writeInt(ub);
+			writeTable(out, TWi.get(i));
+			writeTable(out, vertexToEliminate);
+		});
+	}
+	
+	/**
+	 * Write a map from subsets of V to integers as two arrays: the values and the sets as fixed number of words.
+	 */
+	private void writeTable(DataOutputStream out, Map<BitSet, Integer> table) throws IOException {
+		int width = (n + 63) >>> 6;
+		long[] keys = new long[table.size() * width];
+		int[] values = new int[table.size()];
+		int i = 0;
+		for (Map.Entry<BitSet, Integer> entry : table.entrySet()) {
+			long[] words = entry.getKey().toLongArray();
+			System.arraycopy(words, 0, keys, i * width, words.length);
+			values[i++] = entry.getValue();
+		}
+		Checkpoint.writeInts(out, values, values.length);
+		Checkpoint.writeLongs(out, keys, keys.length);
+	}
+	
+	/**
+	 * Read a map written by @see writeTable(DataOutputStream, Map) into the given map.
+	 */
+	private void readTable(DataInputStream in, Map<BitSet, Integer> table) throws IOException {
+		int width = (n + 63) >>> 6;
+		int[] values = Checkpoint.readInts(in);
+		long[] keys = Checkpoint.readLongs(in);
+		for (int i = 0; i < values.length; i++) {
+			table.put(BitSet.valueOf(Arrays.copyOfRange(keys, i * width, (i + 1) * width)), values[i]);
+		}
+	}
+	
 	/**
 	 * For S subseteq V und v in V\S, Q(S,v) is the set of vertices w in V\S\{v} such that there is a path
 	 * from v to w in G[S union {v,w}].
@@ -329,12 +439,19 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 	 */
 	private int TWDP(int ub, BitSet C) {
 		
-		// TW_0 contains only the pair (empty set, -infinity)
-		TWi.put(0, new HashMap<>());
-		TWi.get(0).put(new BitSet(), -1);
+		// TW_0 contains only the pair (empty set, -infinity), or continue after a restored layer
+		int first = 1;
+		if (resumeLayer >= 0) {
+			first = resumeLayer + 1;
+			ub = resumeUB;
+		} else {
+			TWi.put(0, new HashMap<>());
+			TWi.get(0).put(new BitSet(), -1);
+		}
+		if (checkpoint != null) checkpoint.start();
 		
 		// iteratively compute pairs for bigger subsets
-		for (int i = 1; i <= n-C.cardinality(); i++) {
+		for (int i = first; i <= n-C.cardinality(); i++) {
 			TWi.put(i, new HashMap<>()); // initialize TW_i to be an empty set
 			
 			// iterate over previously computed pairs (S, r)
@@ -369,7 +486,11 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 				}
 
 			}
+			
+			// store the completed layer
+			if (checkpoint != null && checkpoint.isDue()) writeCheckpoint(i, ub);
 		}
+		if (checkpoint != null) checkpoint.stop();
 		
 		// compute Bitset V\C
 		BitSet VC = new BitSet();
@@ -386,6 +507,218 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 		}
 	}
 	
+	/**
+	 * Parallel version of @see TWDP(int, java.util.BitSet) for graphs with at most 64 vertices. A subset S of V is encoded
+	 * by the bits of a long, and Q(S,x) is computed with bit masks and without memorization.
+	 * 
+	 * The layer TW_i is stored in primitive hash tables (@see jdrasil.datastructures.LongIntHashMap) that map S to r and
+	 * the vertex x that was added to obtain S, and that are partitioned by the hash of S. Layer TW_i is computed from
+	 * TW_{i-1} on the common ForkJoinPool with one task per partition of TW_{i-1}. A task collects the new pairs in small
+	 * buffers, one per partition of TW_i, and a full buffer is merged into its partition while holding the lock of the
+	 * partition. Hence, a set is stored at most once in TW_i and, besides TW_{i-1} and TW_i, only the buffers are kept.
+	 * 
+	 * The values r of TW_{i-1} are not needed afterwards, hence, the layer is compacted to a sorted array of the sets and
+	 * the vertices to eliminate, which is all that is needed to reconstruct the elimination order.
+	 * 
+	 * @param ub an upper bound on the tree-width
+	 * @param C a clique of the graph
+	 * @return an optimal elimination order
+	 */
+	private List<T> parallelTWDP(int ub, BitSet C) {
+		
+		// the graph as bit masks
+		long[] adjacency = new long[n];
+		for (int v = 0; v < n; v++) {
+			for (T w : graph.getNeighborhood(intToVertex.get(v))) adjacency[v] |= 1L << vertexToInt.get(w);
+		}
+		long all = n == 64 ? -1L : (1L << n) - 1;
+		long cliqueMask = C.isEmpty() ? 0L : C.toLongArray()[0];
+		int layers = n - C.cardinality();
+		
+		// number of partitions of a layer, a power of two with a few partitions per worker
+		int partitionBits = 32 - Integer.numberOfLeadingZeros(4 * ForkJoinPool.getCommonPoolParallelism() - 1);
+		AtomicInteger bound = new AtomicInteger(ub);
+		
+		// compacted layers: sorted sets and the vertex that was added last
+		long[][] sets = new long[layers+1][];
+		byte[][] eliminate = new byte[layers+1][];
+		
+		// TW_0 contains only the pair (empty set, -infinity), which can not be stored as key 0 -> handled by extend
+		LongIntHashMap[] layer = null;
+		for (int i = 1; i <= layers; i++) {
+			final LongIntHashMap[] previous = layer;
+			
+			// extend the partitions of TW_{i-1} directly into the partitions of TW_i
+			final LongIntHashMap[] next = new LongIntHashMap[1 << partitionBits];
+			for (int p = 0; p < next.length; p++) next[p] = new LongIntHashMap();
+			IntStream.range(0, previous == null ? 1 : previous.length).parallel().forEach(p -> {
+				LayerBuffer buffer = new LayerBuffer(next, partitionBits);
+				if (previous == null) {
+					extend(adjacency, all, 0L, -1, bound, buffer);
+				} else {
+					for (int slot = 0; slot < previous[p].capacity(); slot++) {
+						long S = previous[p].keyAt(slot);
+						if (S != 0) extend(adjacency, all, S, previous[p].valueAt(slot) >> 8, bound, buffer);
+					}
+				}
+				buffer.flush();
+			});
+			layer = next;
+			
+			// TW_{i-1} is no longer needed for the computation
+			if (previous != null) compact(previous, partitionBits, sets, eliminate, i-1);
+		}
+		
+		// there has to be a pair (V\C, r)
+		long VC = all & ~cliqueMask;
+		if (layers > 0) {
+			int r = get(layer, partitionBits, VC);
+			if (r < 0) throw new IllegalStateException("no elimination order of width at most " + ub);
+			compact(layer, partitionBits, sets, eliminate, layers);
+		}
+		
+		// reconstruct the elimination order from V\C, the clique is eliminated last
+		List<T> permutation = new LinkedList<>();
+		for (int v = C.nextSetBit(0); v >= 0; v = C.nextSetBit(v+1)) permutation.add(0, intToVertex.get(v));
+		long S = VC;
+		for (int i = layers; i >= 1; i--) {
+			int x = eliminate[i][Arrays.binarySearch(sets[i], S)];
+			S &= ~(1L << x);
+			permutation.add(0, intToVertex.get(x));
+		}
+		return permutation;
+	}
+	
+	/**
+	 * Extend a pair (S,r) of TW_{i-1} by all vertices x in V\S, as in the inner loop of @see TWDP(int, java.util.BitSet).
+	 * The new pairs are stored in the given buffer with value r << 8 | x, such that the minimum keeps the smallest r.
+	 * The upper bound is shared by all threads.
+	 */
+	private void extend(long[] adjacency, long all, long S, int r, AtomicInteger bound, LayerBuffer table) {
+		for (long X = all & ~S; X != 0; X &= X-1) {
+			int x = Long.numberOfTrailingZeros(X);
+			int r2 = Math.max(Long.bitCount(Q(adjacency, S, x)), r);
+			int ub = bound.get();
+			if (r2 > ub) continue;
+			
+			// update upper bound
+			if (r2 < ub) bound.accumulateAndGet(n - Long.bitCount(S) - 1, Math::min);
+			table.putMin(S | 1L << x, r2 << 8 | x);
+		}
+	}
+	
+	/**
+	 * Q(S,v) for sets encoded as bit masks, see @see Q(java.util.BitSet, int). The component of v in G[S union {v}] is
+	 * grown by a breadth-first search on bit masks, the neighbors of the component outside of S union {v} form Q.
+	 */
+	private static long Q(long[] adjacency, long S, int v) {
+		long component = 1L << v;
+		long frontier = component;
+		long neighbors = 0L;
+		while (frontier != 0) {
+			long next = 0L;
+			for (long F = frontier; F != 0; F &= F-1) next |= adjacency[Long.numberOfTrailingZeros(F)];
+			neighbors |= next;
+			frontier = next & S & ~component;
+			component |= frontier;
+		}
+		return neighbors & ~S & ~(1L << v);
+	}
+	
+	/**
+	 * Buffers the new pairs of a task of @see parallelTWDP(int, java.util.BitSet) for every partition of the next layer.
+	 * A full buffer is merged into its partition while holding the lock of the partition, such that the layer is built
+	 * without local copies of it. A buffer is used by a single thread.
+	 */
+	private static class LayerBuffer {
+		
+		/** Number of pairs that are buffered for a partition. */
+		private static final int SIZE = 512;
+		
+		/** The partitions of the layer. */
+		private final LongIntHashMap[] layer;
+		private final int partitionBits;
+		
+		/** The buffered pairs of every partition, allocated on demand. */
+		private final long[][] keys;
+		private final int[][] values;
+		private final int[] fill;
+		
+		LayerBuffer(LongIntHashMap[] layer, int partitionBits) {
+			this.layer = layer;
+			this.partitionBits = partitionBits;
+			this.keys = new long[layer.length][];
+			this.values = new int[layer.length][];
+			this.fill = new int[layer.length];
+		}
+		
+		/**
+		 * Store the pair (S, value) in the partition of S, keeping the smaller value if S is already stored.
+		 */
+		void putMin(long S, int value) {
+			int p = partition(S, partitionBits);
+			if (keys[p] == null) {
+				keys[p] = new long[SIZE];
+				values[p] = new int[SIZE];
+			}
+			keys[p][fill[p]] = S;
+			values[p][fill[p]] = value;
+			if (++fill[p] == SIZE) flush(p);
+		}
+		
+		/**
+		 * Merge the buffered pairs of a partition into it.
+		 */
+		private void flush(int p) {
+			synchronized (layer[p]) {
+				for (int j = 0; j < fill[p]; j++) layer[p].putMin(keys[p][j], values[p][j]);
+			}
+			fill[p] = 0;
+		}
+		
+		/**
+		 * Merge all buffered pairs into the layer.
+		 */
+		void flush() {
+			for (int p = 0; p < layer.length; p++) if (fill[p] > 0) flush(p);
+		}
+	}
+	
+	/**
+	 * The partition of a set in a layer of @see parallelTWDP(int, java.util.BitSet), given by the highest bits of its hash.
+	 */
+	private static int partition(long S, int partitionBits) {
+		return partitionBits == 0 ? 0 : (int) (LongIntHashMap.mix(S) >>> (64 - partitionBits));
+	}
+	
+	/**
+	 * The value r of a set in a partitioned layer, or -1 if the set is not in the layer.
+	 */
+	private static int get(LongIntHashMap[] layer, int partitionBits, long S) {
+		int value = layer[partition(S, partitionBits)].get(S, -1);
+		return value < 0 ? -1 : value >> 8;
+	}
+	
+	/**
+	 * Compact a partitioned layer to its sets in sorted order and the vertices that were added last to obtain them.
+	 */
+	private static void compact(LongIntHashMap[] layer, int partitionBits, long[][] sets, byte[][] eliminate, int i) {
+		int size = 0;
+		for (LongIntHashMap partition : layer) size += partition.size();
+		long[] keys = new long[size];
+		int j = 0;
+		for (LongIntHashMap partition : layer) {
+			for (int slot = 0; slot < partition.capacity(); slot++) {
+				if (partition.keyAt(slot) != 0) keys[j++] = partition.keyAt(slot);
+			}
+		}
+		Arrays.parallelSort(keys);
+		byte[] vertices = new byte[size];
+		for (j = 0; j < size; j++) vertices[j] = (byte) (layer[partition(keys[j], partitionBits)].get(keys[j], 0) & 0xFF);
+		sets[i] = keys;
+		eliminate[i] = vertices;
+	}
+	
 	/**
 	 * Compute an optimal elimination order of the graph.
 	 * This method has to be called _after_ one of the following methods:
@@ -426,6 +759,12 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 	@Override
 	public TreeDecomposition<T> call() throws Exception {
 
+		// use the checkpoint of the command line, if none was set
+		if (checkpoint == null && mode == Mode.TWDP && JdrasilProperties.containsKey("c")) {
+			setCheckpoint(new File(JdrasilProperties.getProperty("c")), Checkpoint.getInterval());
+			if (JdrasilProperties.containsKey("resume")) resume();
+		}
+
 		// run a corresponding algorithm, this will enable @see computeEliminationOrder()
 		switch (mode) {
 		case simpleDP:
@@ -439,6 +778,10 @@ public class DynamicProgrammingDecomposer<T extends Comparable<T>> implements Tr
 		case TWDP:
 			TWDP(ub, clique);
 			break;
+		case parallelTWDP:
+			if (n <= 64) return new EliminationOrderDecomposer<T>(graph, parallelTWDP(ub, clique), TreeDecompositionQuality.Exact).call();
+			TWDP(ub, clique); // sets do not fit into 64 bit keys
+			break;
 		default:
 			break;
 		}
@@ -18,6 +18,7 @@
  */
 package jdrasil.algorithms.exact;
 
+import jdrasil.datastructures.VertexSet;
 import jdrasil.graph.*;
 import jdrasil.utilities.logging.JdrasilLogger;
 
@@ -54,10 +55,13 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
     private int n;
 
     /** Hash map used for dynamic programming over subgraphs. */
-    private Map<BitSet, Integer> label;
+    private Map<VertexSet, Integer> label;
 
     /** Winning strategy of the searchers, used to extract the tree decomposition. */
-    private Map<BitSet, List<BitSet>> strategy;
+    private Map<VertexSet, List<VertexSet>> strategy;
+
+    /** Scratch set for the interior border of the current configuration. */
+    private VertexSet border;
 
     /** The number of reveals we wish to use (we will compute smallest k that can use no more reveals) */
     private int reveals;
@@ -83,6 +87,7 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
         this.label = new HashMap<>();
         this.strategy = new HashMap<>();
         this.reveals = q;
+        this.border = new VertexSet(n);
     }
 
     /**
@@ -92,7 +97,7 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
      * @param k
      * @return
      */
-    private int decompose(BitSet S, int k) {
+    private int decompose(VertexSet S, int k) {
         if (label.containsKey(S)) return label.get(S); // label of S was already computed
         strategy.put(S, new LinkedList<>());
         if (S.cardinality() == n) { // end configuration is labeled with 0
@@ -102,12 +107,11 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
         int value = INFINITY; // default label is (almost) infinity
 
         // the next move depends on the number of free searchers we have
-        BitSet delta = graph.interiorBorder(S);
-        if (delta.cardinality() < k) {
+        if (graph.interiorBorder(S, border).cardinality() < k) {
             // we have a free searcher, make an existential step
             for (int v = 0; v < n; v++) {
                 if (S.get(v)) continue; // already cleared
-                BitSet newS = (BitSet) S.clone();
+                VertexSet newS = new VertexSet(S);
                 newS.set(v);
                 int tmp = decompose(newS, k);
                 if (tmp < value) {
@@ -118,14 +122,12 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
             }
         } else {
             // we have no free searcher, we have to make an universal step and use S as separator
-            List<BitSet> components = graph.separate(S);
+            List<VertexSet> components = graph.separate(S);
             if (components.size() > 1) { // if we have not more then one component we lost
                 int tmp = 0; // it has to work for all, so we invert the logic
-                for (BitSet component : components) {
+                for (VertexSet component : components) {
                     // reveal the component the searcher is in by marking everything else safe
-                    BitSet mask = new BitSet();
-                    mask.set(0,n);
-                    mask.andNot(component);
+                    VertexSet mask = new VertexSet(component).complement();
                     tmp = Math.max(tmp, decompose(mask, k));
                     strategy.get(S).add(mask);
                     if (tmp == INFINITY) break;
@@ -142,14 +144,14 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
     }
 
     /**
-     * Initial call method for @see jdrasil.algorithms.exact.LimitedGraphSearch#decompose(java.util.BitSet, int)
+     * Initial call method for @see jdrasil.algorithms.exact.LimitedGraphSearch#decompose(jdrasil.datastructures.VertexSet, int)
      * @param k
      * @return
      */
     private boolean decompose(int k) {
         label.clear();
         strategy.clear();
-        return decompose(new BitSet(), k) <= reveals;
+        return decompose(new VertexSet(n), k) <= reveals;
     }
 
     /**
@@ -159,15 +161,13 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
      * @param td
      * @return
      */
-    private Bag<T> extractTreeDecomposition(BitSet S, TreeDecomposition<T> td) {
+    private Bag<T> extractTreeDecomposition(VertexSet S, TreeDecomposition<T> td) {
         Bag<T> bag = td.createBag(graph.getVertexSet(graph.interiorBorder(S)));
         int n_childs = strategy.get(S).size();
-        for (BitSet child : strategy.get(S)) {
+        for (VertexSet child : strategy.get(S)) {
             if (n_childs == 1) {
                 // create an intermediate bag bag(S) -> bag(S cut child) -> bag(child)
-                BitSet cut = (BitSet) child.clone();
-                cut.andNot(S);
-                cut.or(graph.interiorBorder(S));
+                VertexSet cut = new VertexSet(child).andNot(S).or(graph.interiorBorder(S));
                 Bag<T> cutBag = td.createBag(graph.getVertexSet(cut));
                 td.addTreeEdge(bag, cutBag);
                 // create the child bag
@@ -190,7 +190,7 @@ public class LimitedGraphSearch<T extends Comparable<T>> implements TreeDecompos
         }
         LOG.info("limited search number == " + k);
         TreeDecomposition<T> td = new TreeDecomposition<T>(graph.getGraph());
-        extractTreeDecomposition(new BitSet(), td);
+        extractTreeDecomposition(new VertexSet(n), td);
         return td;
     }
 
@@ -1,15 +1,43 @@
 package jdrasil.algorithms.exact;
 
+import jdrasil.datastructures.BitSetTrie;
+import jdrasil.datastructures.VertexSet;
+import jdrasil.datastructures.VertexSetStore;
 import jdrasil.graph.*;
+import jdrasil.utilities.Checkpoint;
+import jdrasil.utilities.MemoryBudget;
 import jdrasil.utilities.logging.JdrasilLogger;
 
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.IOException;
 import java.util.*;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.ForkJoinPool;
 import java.util.logging.Logger;
+import java.util.stream.Collectors;
 
 /**
  * An implementation of Tamakis positive-instance driven version of the algorithm from Bouchitt\'{e} and Todinca~\cite{Tamaki17}.
  * The algorithm uses the observation that many graphs seem to have just a few \emph{feasible} potential maximal cliques
  * (in contrast to the number of all such objects), which are then enumerated and used to find an optimal tree decomposition.
+ *
+ * In parallel mode (@see setParallel(boolean)), I-blocks are polled in batches and the O-blocks and buildable potential
+ * maximal cliques of every I-block of the batch are computed by worker threads, each on its own copy of the BitSetGraph.
+ * The results are merged sequentially in the order of the batch, so all changes of the block sets and the strategy are
+ * made by the calling thread. Since the I-blocks of a batch do not see the O-blocks found by each other, the batch is
+ * combined with these new O-blocks in further rounds until no new O-block is found.
+ *
+ * Blocks and potential maximal cliques are kept in VertexSetStores, which pack the sets into plain arrays. The queues,
+ * the map from I-blocks to their potential maximal cliques, and the strategy use the integer handles of these stores.
+ *
+ * With a checkpoint (@see setCheckpoint(File, long)), the search writes its state (the current width, the stores, the
+ * strategy, and both queues) between the expansions of two I-blocks, from which a later run can resume (@see resume()).
+ *
+ * The memorization of the BitSetGraph and of its copies for the workers takes shares of one memory budget, which may be
+ * shared with other instances that run at the same time (@see PidBT(Graph, int, int, TreeDecomposition, MemoryBudget)).
+ * The shares are returned by @see release(), which @see call() does when it finishes.
  */
 public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
 
@@ -24,18 +52,42 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
     private int ub;
     private TreeDecomposition<T> ubDecomposition;
 
-    /* Data structures used by the algorithm. */
-    private Queue<BitSet> queue;
-    private Queue<BitSet> pending;
-    private Set<BitSet> IBlocks;
-    private Set<BitSet> OBlocks;
-    private Set<BitSet> buildablePMC;
-    private Set<BitSet> feasiblePMC;
-
-    /* Data structures used to reconstructed decomposition form winning-strategy. */
-    private BitSet root;
-    private Map<BitSet, List<BitSet>> strategy = new HashMap<>();
-    private Map<BitSet, BitSet> cliqueOfComponent = new HashMap<>();
+    /* Data structures used by the algorithm, the queue holds handles of IBlocks and pending those of buildablePMC. */
+    private Queue<Integer> queue;
+    private Queue<Integer> pending;
+    private VertexSetStore IBlocks;
+    private VertexSetStore OBlocks;
+    private BitSetTrie OBlockIndex; // the OBlocks as set-trie for superset queries
+    private VertexSetStore buildablePMC;
+    private VertexSetStore feasiblePMC;
+
+    /* Data structures used to reconstructed decomposition form winning-strategy, indexed by handles. */
+    private int root;
+    private int[][] strategy;         // feasible PMC -> feasible PMCs of its support
+    private int[] cliqueOfComponent;  // IBlock -> feasible PMC of which it is the crib
+
+    /* Scratch set for candidate potential maximal cliques, which are only copied if they are stored. */
+    private VertexSet candidate;
+
+    /* Parallel mode: number of I-blocks per worker thread in a batch, and copies of the graph for the workers. */
+    private static final int BATCH_FACTOR = 4;
+    private boolean parallel;
+    private final MemoryBudget budget;
+    private final Queue<BitSetGraph<T>> workerGraphs = new ConcurrentLinkedQueue<>();
+
+    /* Set by cancel() to stop a running test, and whether a test was started (later tests reuse the I-blocks). */
+    private volatile boolean cancelled;
+    private boolean started;
+
+    /* Checkpoint of the search, and the width of the test that was restored from it (or -1). */
+    private Checkpoint checkpoint;
+    private int resumeWidth = -1;
+
+    /* The O-blocks and buildable potential maximal cliques found while expanding an I-block. */
+    private static class Expansion {
+        final Set<VertexSet> newOBlocks = new HashSet<>();
+        final Set<VertexSet> newBuildablePMC = new HashSet<>();
+    }
 
     /**
      * Initialize the algorithm for a graph without known lower- or upper-bounds.
@@ -66,38 +118,225 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
      */
     public PidBT(Graph<T> graph, int lb, int ub,
                  TreeDecomposition<T> ubDecomposition) {
-        this.graph = new BitSetGraph<>(graph);
+        this(graph, lb, ub, ubDecomposition, Runtime.getRuntime().maxMemory() / 4);
+    }
+
+    /**
+     * Initialize the graph with a given lower- and upper-bound, see @see PidBT(Graph, int, int, TreeDecomposition),
+     * and a memory budget for the memorization of the underlying BitSetGraph.
+     *
+     * @param graph The graph to be decomposed.
+     * @param lb A lower-bound on the tree width of the given graph.
+     * @param ub A upper-bound on the tree width of the given graph.
+     * @param ubDecomposition A decomposition witnessing the upper-bound.
+     * @param cacheBytes The memory budget in bytes for memorized results of the graph operations.
+     */
+    public PidBT(Graph<T> graph, int lb, int ub,
+                 TreeDecomposition<T> ubDecomposition, long cacheBytes) {
+        this(graph, lb, ub, ubDecomposition, new MemoryBudget(cacheBytes));
+    }
+
+    /**
+     * Initialize the graph with a given lower- and upper-bound, see @see PidBT(Graph, int, int, TreeDecomposition),
+     * and a memory budget for the memorization that is shared with all other users of the budget. The BitSetGraph and
+     * every copy for a worker thread take a share of the budget until @see release() is called.
+     *
+     * @param graph The graph to be decomposed.
+     * @param lb A lower-bound on the tree width of the given graph.
+     * @param ub A upper-bound on the tree width of the given graph.
+     * @param ubDecomposition A decomposition witnessing the upper-bound.
+     * @param budget The memory budget for memorized results of the graph operations.
+     */
+    public PidBT(Graph<T> graph, int lb, int ub,
+                 TreeDecomposition<T> ubDecomposition, MemoryBudget budget) {
+        this.graph = new BitSetGraph<>(graph, budget);
+        this.budget = budget;
         this.lb = lb;
         this.ub = ub;
         this.ubDecomposition = ubDecomposition;
 
         // initialize data structures for core algorithm
-        queue = new PriorityQueue<>( (a,b) -> Integer.compare(b.cardinality(), a.cardinality()) );
-        pending = new LinkedList<>();
-        IBlocks = new HashSet<>();
-        OBlocks = new HashSet();
-        buildablePMC = new HashSet<>();
-        feasiblePMC  = new HashSet<>();
+        int n = this.graph.getN();
+        queue = new PriorityQueue<>( (a,b) -> Integer.compare(IBlocks.cardinality(b), IBlocks.cardinality(a)) );
+        pending = new ArrayDeque<>();
+        IBlocks = new VertexSetStore(n);
+        OBlocks = new VertexSetStore(n);
+        OBlockIndex = new BitSetTrie(n);
+        buildablePMC = new VertexSetStore(n);
+        feasiblePMC  = new VertexSetStore(n);
 
         // initialize data structures to store decomposition
-        strategy = new HashMap<>();
-        cliqueOfComponent = new HashMap<>();
+        root = -1;
+        strategy = new int[16][];
+        cliqueOfComponent = new int[16];
+        candidate = new VertexSet(this.graph.getN());
     }
 
     /**
-     * Get OBlocks that are super sets of the given set.
-     * @param S A set $S$.
-     * @return A list of super sets of $S$ stored in the OBlocks.
+     * Enables or disables the parallel mode, in which I-blocks are expanded concurrently on the common pool.
+     * @param parallel True if I-blocks should be expanded in parallel.
+     */
+    public void setParallel(boolean parallel) {
+        this.parallel = parallel;
+    }
+
+    /**
+     * Periodically store the state of the search in a file, see @see jdrasil.utilities.Checkpoint.
+     * @param file The base name of the file that stores the snapshot, which is extended by the fingerprint.
+     * @param intervalMillis The interval between two snapshots in milliseconds.
+     */
+    public void setCheckpoint(File file, long intervalMillis) {
+        this.checkpoint = new Checkpoint(file, intervalMillis, "PidBT", fingerprint());
+    }
+
+    /**
+     * A fingerprint of the graph, which identifies the snapshots of this instance.
+     * @return A hash of the adjacency matrix of the graph.
+     */
+    public long fingerprint() {
+        long fingerprint = graph.getN();
+        for (VertexSet row : graph.getBitSetGraph()) fingerprint = fingerprint * 0x9E3779B97F4A7C15L + row.hashCode();
+        return fingerprint;
+    }
+
+    /**
+     * Restore the state of the search from the checkpoint, if there is a snapshot for this graph. The next call of
+     * @see decide(int) for the restored width continues the interrupted test, and @see call() starts with it.
+     *
+     * @return True if a snapshot was restored.
+     * @throws IOException If the snapshot could not be read.
+     */
+    public boolean resume() throws IOException {
+        if (checkpoint == null) return false;
+        try (DataInputStream in = checkpoint.open()) {
+            if (in == null) return false;
+            int k = in.readInt();
+            IBlocks = VertexSetStore.read(in);
+            OBlocks = VertexSetStore.read(in);
+            buildablePMC = VertexSetStore.read(in);
+            feasiblePMC = VertexSetStore.read(in);
+            cliqueOfComponent = Checkpoint.readInts(in);
+            int[] offsets = Checkpoint.readInts(in);
+            int[] edges = Checkpoint.readInts(in);
+            strategy = new int[Math.max(16, feasiblePMC.size())][];
+            for (int K = 0; K < feasiblePMC.size(); K++) strategy[K] = Arrays.copyOfRange(edges, offsets[K], offsets[K+1]);
+            queue.clear();
+            for (int C : Checkpoint.readInts(in)) queue.offer(C);
+            pending.clear();
+            for (int K : Checkpoint.readInts(in)) pending.offer(K);
+            OBlockIndex.clear();
+            for (int A = 0; A < OBlocks.size(); A++) OBlockIndex.insert(OBlocks.get(A));
+            resumeWidth = k;
+            started = true;
+        }
+        LOG.info("resumed PID-BT at k = " + resumeWidth + " with " + IBlocks.size() + " IBlocks");
+        return true;
+    }
+
+    /**
+     * Write the state of the search for the target width $k$ to the checkpoint.
+     * @param k The target tree width.
      */
-    private List<BitSet> getSuperSets(BitSet S) {
-        List<BitSet> supersets = new LinkedList<>();
-        for (BitSet D : OBlocks) {
-            BitSet mask = (BitSet) S.clone(); // D\S
-            mask.andNot(D);
-            if (mask.cardinality() != 0) continue;
-            supersets.add(D);
+    private void writeCheckpoint(int k) {
+        checkpoint.write(out -> {
+            out.writeInt(k);
+            IBlocks.write(out);
+            OBlocks.write(out);
+            buildablePMC.write(out);
+            feasiblePMC.write(out);
+            Checkpoint.writeInts(out, cliqueOfComponent, IBlocks.size());
+            int[] offsets = new int[feasiblePMC.size()+1];
+            for (int K = 0; K < feasiblePMC.size(); K++) offsets[K+1] = offsets[K] + strategy[K].length;
+            int[] edges = new int[offsets[feasiblePMC.size()]];
+            for (int K = 0; K < feasiblePMC.size(); K++) System.arraycopy(strategy[K], 0, edges, offsets[K], strategy[K].length);
+            Checkpoint.writeInts(out, offsets, offsets.length);
+            Checkpoint.writeInts(out, edges, edges.length);
+            int[] handles = queue.stream().mapToInt(Integer::intValue).toArray();
+            Checkpoint.writeInts(out, handles, handles.length);
+            handles = pending.stream().mapToInt(Integer::intValue).toArray();
+            Checkpoint.writeInts(out, handles, handles.length);
+        });
+    }
+
+    /**
+     * Stops a running (or future) call of @see decide(int), which will then return false. The instance can not be used
+     * afterwards. This method may be called from any thread.
+     */
+    public void cancel() {
+        this.cancelled = true;
+    }
+
+    /**
+     * Returns the shares of the memory budget taken by the BitSetGraph and its copies, such that other instances with
+     * the same budget can use them. Afterwards, @see decide(int) still works but does not memorize results anymore,
+     * while @see getTreeDecomposition(int) is not affected.
+     */
+    public void release() {
+        graph.release();
+        for (BitSetGraph<T> G : workerGraphs) G.release();
+        workerGraphs.clear();
+    }
+
+    /**
+     * Check if this instance was cancelled.
+     * @return True if @see cancel() was called.
+     */
+    public boolean isCancelled() {
+        return cancelled;
+    }
+
+    /**
+     * Test if the tree width of the graph is at most $k$. The I-blocks found by previous calls are reused, as they are
+     * I-blocks for larger $k$ as well. Hence, successive calls must use increasing values of $k$, but may skip values.
+     *
+     * @param k The target tree width.
+     * @return True if the tree width is at most $k$, false if it is larger or if the test was cancelled.
+     */
+    public boolean decide(int k) {
+        if (k == resumeWidth) {
+            resumeWidth = -1;
+            return search(k);
+        }
+        resumeWidth = -1;
+        if (started) refresh(k);
+        started = true;
+        if (k >= graph.getN()-1) return true; // trivial, a single bag
+        return solve(k);
+    }
+
+    /**
+     * Build the tree decomposition of width $k$ after @see decide(int) returned true for $k$.
+     *
+     * @param k The width for which a solution was found.
+     * @return A tree decomposition of width at most $k$.
+     */
+    public TreeDecomposition<T> getTreeDecomposition(int k) {
+        TreeDecomposition<T> treeDecomposition = new TreeDecomposition<>(graph.getGraph());
+        if (k >= graph.getN()-1) { // trivial case -> single bag
+            treeDecomposition.createBag(graph.getGraph().getCopyOfVertices());
+        } else { // extract optimal tree decomposition from the strategy
+            extractDecompositionFromStrategy(root, treeDecomposition);
         }
-        return supersets;
+        return treeDecomposition;
+    }
+
+    /**
+     * Get OBlocks that are super sets of the given set. The query is answered by the set-trie of the OBlocks and, thus,
+     * only visits branches of the trie that can contain super sets of $S$.
+     * @param S A set $S$.
+     * @return The super sets of $S$ stored in the OBlocks (as copies).
+     */
+    private Iterable<VertexSet> getSuperSets(VertexSet S) {
+        return OBlockIndex.getSuperSets(S);
+    }
+
+    /**
+     * Add a new OBlock and index it for superset queries.
+     * @param A An OBlock.
+     */
+    private void addOBlock(VertexSet A) {
+        int size = OBlocks.size();
+        if (OBlocks.add(A) == size) OBlockIndex.insert(A);
     }
 
     /**
@@ -110,36 +349,26 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
     private int refresh(int lb) {
         queue.clear();
         pending.clear();
-        queue.addAll(IBlocks);
+        for (int C = 0; C < IBlocks.size(); C++) queue.offer(C);
         //IBlocks.clear();
         OBlocks.clear();
+        OBlockIndex.clear();
         //buildablePMC.clear();
         //feasiblePMC.clear();
         return lb + 1;
     }
 
-    /**
-     * The algorithm has found a place move of the cops and announces it~--~this information is later used to extract
-     * the tree decomposition from a winning strategy of the cops.
-     *
-     * @param K A potential maximal clique.
-     */
-    private void announcePlaceMove(BitSet K) {
-        List<BitSet> next = new LinkedList<>();
-        next.add(K);
-        strategy.put(graph.outlet(K), next);
-    }
-
     /**
      * The algorithm has found a remove move of the cops and announces it~--~this information is later used to extract
-     * the tree decomposition from a winning strategy of the cops.
+     * the tree decomposition from a winning strategy of the cops. The place moves are implicit, as the strategy is
+     * only followed from potential maximal cliques to the potential maximal cliques of their support.
      *
-     * @param K A potential maximal clique.
+     * @param K The handle of a feasible potential maximal clique.
+     * @param next The handles of the feasible potential maximal cliques of the support of $K$ (may contain duplicates).
      */
-    private void announceRemoveMove(BitSet K) {
-        Set<BitSet> next = new HashSet<>();
-        for (BitSet A : graph.support(K)) next.add(cliqueOfComponent.get(A));
-        strategy.put(K, new LinkedList<>(next));
+    private void announceRemoveMove(int K, int[] next) {
+        if (K >= strategy.length) strategy = Arrays.copyOf(strategy, Math.max(2 * strategy.length, K + 1));
+        strategy[K] = Arrays.stream(next).distinct().toArray();
     }
 
     /**
@@ -147,16 +376,17 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
      * a move of the cops and announce it.
      *
      * @param K A potential maximal clique.
+     * @param handle The handle of $K$ in the feasible potential maximal cliques.
      */
-    private void insert(BitSet K) {
-        BitSet outlet = graph.outlet(K);
-        if (outlet.cardinality() == 0) return;
-        BitSet C = graph.crib(outlet, K);
+    private void insert(VertexSet K, int handle) {
+        VertexSet outlet = graph.outlet(K);
+        if (outlet.isEmpty()) return;
+        VertexSet C = graph.crib(outlet, K);
         if (IBlocks.contains(C)) return;
-        announcePlaceMove(K);
-        cliqueOfComponent.put(C, K);
-        IBlocks.add(C);
-        queue.offer(C);
+        int c = IBlocks.add(C);
+        if (c >= cliqueOfComponent.length) cliqueOfComponent = Arrays.copyOf(cliqueOfComponent, Math.max(2 * cliqueOfComponent.length, c + 1));
+        cliqueOfComponent[c] = handle;
+        queue.offer(c);
         LOG.finer("offered: " + C);
     }
 
@@ -164,8 +394,8 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
      * Poll an IBlock from the main queue.
      * @return A IBLock to be processed next.
      */
-    private BitSet poll() {
-        BitSet C = queue.poll();
+    private VertexSet poll() {
+        VertexSet C = IBlocks.get(queue.poll());
         LOG.finer("polled: " + C);
         return C;
     }
@@ -176,10 +406,11 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
      * if necessary.
      *
      * @param K A potential maximal clique.
+     * @param handle The handle of $K$ in the buildable potential maximal cliques.
      */
-    private void eventuallyPostponePotentialMaximalClique(BitSet K) {
+    private void eventuallyPostponePotentialMaximalClique(VertexSet K, int handle) {
         boolean isReady = true;
-        for (BitSet block : graph.separate(K)) {
+        for (VertexSet block : graph.separate(K)) {
             if (graph.outbound(block)) continue;
             if (IBlocks.contains(block)) continue;
             isReady = false;
@@ -187,7 +418,7 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
         }
         if (!isReady) {
             LOG.finer("pending: " + K);
-            pending.offer(K);
+            pending.offer(handle);
         }
     }
 
@@ -200,26 +431,124 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
      * @param K A potential maximal clique.
      * @return True if a solution was found.
      */
-    private boolean processPotentialMaximalClique(BitSet K) {
+    private boolean processPotentialMaximalClique(VertexSet K) {
         if (feasiblePMC.contains(K)) return false;
         // check if the PMC is feasible
-        boolean feasible = true;
-        for (BitSet D : graph.support(K)) feasible &= IBlocks.contains(D);
-        if (!feasible) return false;
-        feasiblePMC.add(K);
-        announceRemoveMove(K);
+        List<VertexSet> support = graph.support(K);
+        int[] next = new int[support.size()];
+        for (int i = 0; i < next.length; i++) {
+            int D = IBlocks.find(support.get(i));
+            if (D < 0) return false;
+            next[i] = cliqueOfComponent[D];
+        }
+        int handle = feasiblePMC.add(K);
+        announceRemoveMove(handle, next);
 
         // if the outlet is empty, we found the root and a proof for tw = k
-        if (graph.outlet(K).cardinality() == 0) {
-            root = K;
+        if (graph.outlet(K).isEmpty()) {
+            root = handle;
             return true;
         }
 
         // insert crib of K
-        insert(K);
+        insert(K, handle);
         return false;
     }
 
+    /**
+     * Steps (iii) to (v) of the core algorithm for an I-block $C$: combine $C$ with O-blocks that are super sets of it,
+     * and compute the O-blocks and buildable potential maximal cliques that arise from it.
+     *
+     * @param G The BitSetGraph used for the computation, which is owned by the calling thread.
+     * @param C An I-block.
+     * @param supersets The O-blocks $B$ with $C\subseteq B$ that should be combined with $C$.
+     * @param withBorder If true, the full components of $N(C)$ are O-blocks as well (iv).
+     * @param k The target tree width.
+     * @param candidate A scratch set owned by the calling thread.
+     * @param expansion The container that stores the results.
+     */
+    private void expand(BitSetGraph<T> G, VertexSet C, Iterable<VertexSet> supersets, boolean withBorder, int k,
+                        VertexSet candidate, Expansion expansion) {
+        VertexSet NC = G.exteriorBorder(C);
+
+        // (iii)
+        for (VertexSet B : supersets) {
+            VertexSet K = candidate.assign(G.exteriorBorder(B)).or(NC);
+            int size = K.cardinality();
+            if (size > k + 1) continue;
+            if (G.isPotentialMaximalClique(K)) expansion.newBuildablePMC.add(new VertexSet(K));
+            if (size > k) continue;
+            expansion.newOBlocks.addAll(G.fullComponents(K));
+        }
+
+        // (iv)
+        if (withBorder) expansion.newOBlocks.addAll(G.fullComponents(NC));
+
+        // (v)
+        for (VertexSet A : expansion.newOBlocks) {
+            VertexSet NA = G.exteriorBorder(A);
+            for (int v = NA.nextSetBit(0); v >= 0; v = NA.nextSetBit(v+1)) {
+                VertexSet K = candidate.assign(A).and(G.getBitSetGraph()[v]).or(NA);
+                if (K.cardinality() > k + 1) continue;
+                if (G.isPotentialMaximalClique(K)) expansion.newBuildablePMC.add(new VertexSet(K));
+            }
+        }
+    }
+
+    /**
+     * Expand a batch of I-blocks in parallel, see the description of the parallel mode in the class documentation.
+     * Worker threads only read the set-tries of O-blocks, all other data structures are modified by the calling thread
+     * while the results are merged.
+     *
+     * @param k The target tree width.
+     * @return True if a solution was found.
+     */
+    private boolean expandBatch(int k) {
+        List<VertexSet> batch = new ArrayList<>();
+        int batchSize = BATCH_FACTOR * ForkJoinPool.getCommonPoolParallelism();
+        while (batch.size() < batchSize && !queue.isEmpty()) batch.add(poll());
+
+        BitSetTrie index = OBlockIndex;
+        boolean withBorder = true;
+        while (true) {
+            final BitSetTrie supersets = index;
+            final boolean border = withBorder;
+            List<Expansion> expansions = batch.parallelStream().map(C -> {
+                BitSetGraph<T> G = workerGraphs.poll();
+                if (G == null) G = new BitSetGraph<>(graph, budget);
+                try {
+                    Expansion expansion = new Expansion();
+                    expand(G, C, supersets.getSuperSets(C), border, k, new VertexSet(G.getN()), expansion);
+                    return expansion;
+                } finally {
+                    workerGraphs.offer(G);
+                }
+            }).collect(Collectors.toList());
+
+            // merge in the order of the batch and collect the O-blocks that were not known before
+            BitSetTrie newOBlocks = new BitSetTrie(graph.getN());
+            boolean found = false;
+            for (Expansion expansion : expansions) {
+                for (VertexSet K : expansion.newBuildablePMC) {
+                    eventuallyPostponePotentialMaximalClique(K, buildablePMC.add(K));
+                    if (processPotentialMaximalClique(K)) return true;
+                }
+                for (VertexSet A : expansion.newOBlocks) {
+                    if (!OBlocks.contains(A)) {
+                        newOBlocks.insert(A);
+                        found = true;
+                    }
+                    addOBlock(A);
+                }
+            }
+            if (!found) return false;
+
+            // combine the batch with the new O-blocks
+            index = newOBlocks;
+            withBorder = false;
+        }
+    }
+
     /**
      * Tamakis core algorithm that tests if the tree width of the input graph is at most $k$.
      * If this method is invoked an returns true, a tree decomposition can be extracted from the stored strategy.
@@ -231,96 +560,106 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
 
         // initialize
         for (int v = 0; v < graph.getN(); v++) {
-            BitSet K = (BitSet) graph.getBitSetGraph()[v].clone();
+            VertexSet K = new VertexSet(graph.getBitSetGraph()[v]);
             K.set(v);
             if (K.cardinality() > k + 1) continue;
             if (!graph.isPotentialMaximalClique(K)) continue;
             buildablePMC.add(K);
             if (!graph.support(K).isEmpty()) continue;
-            feasiblePMC.add(K);
-            insert(K);
+            int handle = feasiblePMC.add(K);
+            announceRemoveMove(handle, new int[0]);
+            insert(K, handle);
         }
+        return search(k);
+    }
 
-        // main loop
-        while (true) {
-            while (!queue.isEmpty()) {
-                BitSet C = poll();
-
-                // temporary data
-                Set<BitSet> newOBlocks = new HashSet<>();
-                Set<BitSet> newBuildablePMC = new HashSet<>();
-
-                // (iii)
-                for (BitSet B : getSuperSets(C)) {
-                    BitSet K = (BitSet) graph.exteriorBorder(B).clone();
-                    K.or(graph.computeExteriorBorder(C));
-                    if (K.cardinality() > k + 1) continue;
-                    if (graph.isPotentialMaximalClique(K)) newBuildablePMC.add(K);
-                    if (K.cardinality() > k) continue;
-                    for (BitSet A : graph.fullComponents(K)) newOBlocks.add(A);
-                }
-
-                // (iv)
-                for (BitSet A : graph.fullComponents(graph.exteriorBorder(C))) newOBlocks.add(A);
-
-                // (v)
-                for (BitSet A : newOBlocks) {
-                    BitSet NA = graph.exteriorBorder(A);
-                    for (int v = NA.nextSetBit(0); v >= 0; v = NA.nextSetBit(v+1)) {
-                        BitSet K = (BitSet) A.clone();
-                        K.and(graph.getBitSetGraph()[v]);
-                        K.or(NA);
-                        if (K.cardinality() > k + 1) continue;
-                        if (graph.isPotentialMaximalClique(K)) newBuildablePMC.add(K);
+    /**
+     * The main loop of the core algorithm, which processes the queue of I-blocks and the pending potential maximal
+     * cliques. Between two steps, a snapshot is written if the checkpoint is due.
+     *
+     * @param k The target tree width.
+     * @return True if the input graph has tree width at most $k$.
+     */
+    private boolean search(int k) {
+        if (checkpoint != null) checkpoint.start();
+        try {
+            while (true) {
+                while (!queue.isEmpty()) {
+                    if (cancelled) return false;
+                    if (checkpoint != null && checkpoint.isDue()) writeCheckpoint(k);
+                    if (parallel) {
+                        if (expandBatch(k)) return true;
+                        continue;
+                    }
+                    VertexSet C = poll();
+                    Expansion expansion = new Expansion();
+                    expand(graph, C, getSuperSets(C), true, k, candidate, expansion);
+
+                    // (vi)
+                    for (VertexSet K : expansion.newBuildablePMC) {
+                        eventuallyPostponePotentialMaximalClique(K, buildablePMC.add(K));
+                        if (processPotentialMaximalClique(K)) return true;
                     }
-                }
 
-                // (vi)
-                for (BitSet K : newBuildablePMC) {
-                    eventuallyPostponePotentialMaximalClique(K);
+                    // copy temporary data
+                    for (VertexSet A : expansion.newOBlocks) addOBlock(A);
+                }
+                if (pending.isEmpty()) break;
+                while (!pending.isEmpty()) {
+                    if (cancelled) return false;
+                    if (checkpoint != null && checkpoint.isDue()) writeCheckpoint(k);
+                    VertexSet K = buildablePMC.get(pending.poll());
                     if (processPotentialMaximalClique(K)) return true;
                 }
-
-                // copy temporary data
-                OBlocks.addAll(newOBlocks);
-                buildablePMC.addAll(newBuildablePMC);
             }
-            if (pending.isEmpty()) break;
-            while (!pending.isEmpty()) {
-                BitSet K = pending.poll();
-                if (processPotentialMaximalClique(K)) return true;
-            }
-        }
 
-        // not solution found
-        return false;
+            // not solution found
+            return false;
+        } finally {
+            if (checkpoint != null) checkpoint.stop();
+        }
     }
 
     /**
      * Turns a winning-strategy of the cops into a tree decomposition.
      *
-     * @param root The root of the tree decomposition (or the current bag).
+     * @param root The handle of the root of the tree decomposition (or the current bag) in the feasible PMCs.
      * @param treeDecomposition The tree decomposition that is constructed.
      * @return The bag that was created for the given root set.
      */
-    private Bag<T> extractDecompositionFromStrategy(BitSet root,
+    private Bag<T> extractDecompositionFromStrategy(int root,
                                        TreeDecomposition<T> treeDecomposition) {
-        Bag<T> bag = treeDecomposition.createBag(graph.getVertexSet(root));
-        if (!strategy.containsKey(root)) return bag;
-        for (BitSet child : strategy.get(root)) treeDecomposition.addTreeEdge(bag, extractDecompositionFromStrategy(child, treeDecomposition));
+        Bag<T> bag = treeDecomposition.createBag(graph.getVertexSet(feasiblePMC.get(root)));
+        for (int child : strategy[root]) treeDecomposition.addTreeEdge(bag, extractDecompositionFromStrategy(child, treeDecomposition));
         return bag;
     }
 
     @Override
     public TreeDecomposition<T> call() throws Exception {
+        try {
+            return solveOptimally();
+        } finally {
+            release();
+        }
+    }
+
+    /**
+     * Increase the lower bound till the optimum is found and build the decomposition, see @see call().
+     *
+     * @return An optimal tree decomposition.
+     */
+    private TreeDecomposition<T> solveOptimally() {
         LOG.info("running PID-BT core on graph with |V| = " + graph.getN() + " and |E| = " + graph.getGraph().getNumberOfEdges());
         LOG.info("current lb = " + lb);
         LOG.info("current ub = " + ub);
 
+        // continue with a restored test
+        if (resumeWidth >= 0) lb = Math.max(lb, resumeWidth);
+
         // increase lower bound till optimum is found
-        while ( (lb < ub) && !solve(lb) ) {
+        while ( (lb < ub) && !decide(lb) ) {
             LOG.info("tw > " + lb);
-            lb = refresh(lb);
+            lb = lb + 1;
         }
         LOG.info("tw = " + lb);
 
@@ -329,20 +668,17 @@ public class PidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
         LOG.info("#OBlocks: " + OBlocks.size());
         LOG.info("#BuildablePMC: " + buildablePMC.size());
         LOG.info("#FeasiblePMC: " + feasiblePMC.size());
+        LOG.info("block and PMC stores: " + (IBlocks.sizeInBytes() + OBlocks.sizeInBytes()
+                + buildablePMC.sizeInBytes() + feasiblePMC.sizeInBytes()) / 1024 + " KB");
+        LOG.info("separate cache: " + graph.getSeparateCache());
+        LOG.info("exterior border cache: " + graph.getExteriorBorderCache());
+        LOG.info("PMC cache: " + graph.getPMCCache());
 
         // we did nothing
         if (lb == ub && ubDecomposition != null) return ubDecomposition;
 
         // build the decomposition
-        TreeDecomposition<T> treeDecomposition = new TreeDecomposition<>(graph.getGraph());
-        if (lb == graph.getN()-1) { // trivial case -> single bag
-            treeDecomposition.createBag(graph.getGraph().getCopyOfVertices());
-        } else { // extract optimal tree decomposition from the strategy
-            extractDecompositionFromStrategy(root, treeDecomposition);
-        }
-
-        // done
-        return treeDecomposition;
+        return getTreeDecomposition(lb);
     }
 
     @Override
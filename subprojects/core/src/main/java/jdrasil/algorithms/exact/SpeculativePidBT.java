@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.algorithms.exact;
+
+import jdrasil.graph.Graph;
+import jdrasil.graph.TreeDecomposer;
+import jdrasil.graph.TreeDecomposition;
+import jdrasil.utilities.MemoryBudget;
+import jdrasil.utilities.logging.JdrasilLogger;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.Future;
+import java.util.logging.Logger;
+
+/**
+ * Runs PID-BT speculatively for several consecutive target widths at once. PidBT tests $k=lb,lb+1,\dots$ one after
+ * another; this decomposer uses a number of workers, each with its own instance of PidBT (and, thus, its own block
+ * store), that take the smallest untested width whenever they are idle. A worker whose test fails continues with the
+ * next width and reuses its I-blocks, as PidBT does between two widths.
+ *
+ * If a width $k$ is solved, all workers that test a larger width are cancelled and no width larger or equal to $k$ is
+ * started anymore. Workers on smaller widths continue, so the final width is the smallest $k$ that was solved after all
+ * smaller widths have failed, i.e., the tree width. This uses idle cores if the gap between the lower and the upper
+ * bound is large; the price is that workers do not share blocks with each other. The workers share one memory budget
+ * for their memorization, and a worker returns its share as soon as it stops.
+ *
+ * @author Max Bannach
+ */
+public class SpeculativePidBT<T extends Comparable<T>> implements TreeDecomposer<T> {
+
+    /* Jdrasil Logger */
+    private final static Logger LOG = Logger.getLogger(JdrasilLogger.getName());
+
+    /* The graph that we decompose. */
+    private final Graph<T> graph;
+
+    /* Lower- and upper-bounds. */
+    private final int lb;
+    private final int ub;
+    private final TreeDecomposition<T> ubDecomposition;
+
+    /* The memory budget shared by all workers and the number of workers. */
+    private final MemoryBudget budget;
+    private final int runs;
+
+    /* State of the search, guarded by this. */
+    private int nextWidth;
+    private int best;
+    private TreeDecomposition<T> bestDecomposition;
+    private final List<PidBT<T>> instances;
+    private final int[] widths; // the width tested by every worker, Integer.MAX_VALUE if it is idle
+
+    /**
+     * Initialize the decomposer with lower- and upper-bounds.
+     *
+     * @param graph The graph to be decomposed.
+     * @param lb A lower-bound on the tree width of the given graph.
+     * @param ub A upper-bound on the tree width of the given graph.
+     * @param ubDecomposition A decomposition witnessing the upper-bound, if null the upper-bound is ignored.
+     * @param cacheBytes The memory budget in bytes for memorized results, shared by all workers.
+     * @param runs The number of widths that are tested at the same time.
+     */
+    public SpeculativePidBT(Graph<T> graph, int lb, int ub, TreeDecomposition<T> ubDecomposition,
+                            long cacheBytes, int runs) {
+        this(graph, lb, ub, ubDecomposition, new MemoryBudget(cacheBytes), runs);
+    }
+
+    /**
+     * Initialize the decomposer with lower- and upper-bounds and a memory budget that may be shared with other solvers
+     * running at the same time.
+     *
+     * @param graph The graph to be decomposed.
+     * @param lb A lower-bound on the tree width of the given graph.
+     * @param ub A upper-bound on the tree width of the given graph.
+     * @param ubDecomposition A decomposition witnessing the upper-bound, if null the upper-bound is ignored.
+     * @param budget The memory budget for memorized results, shared by all workers.
+     * @param runs The number of widths that are tested at the same time.
+     */
+    public SpeculativePidBT(Graph<T> graph, int lb, int ub, TreeDecomposition<T> ubDecomposition,
+                            MemoryBudget budget, int runs) {
+        this.graph = graph;
+        this.lb = lb;
+        this.ub = ubDecomposition != null ? ub : graph.getNumVertices()-1;
+        this.ubDecomposition = ubDecomposition;
+        this.budget = budget;
+        this.runs = Math.max(1, runs);
+        this.instances = new ArrayList<>(this.runs);
+        this.widths = new int[this.runs];
+    }
+
+    /**
+     * A worker takes the next untested width, runs its PidBT instance on it, and records the result.
+     *
+     * @param i The index of the worker.
+     */
+    private void work(int i) {
+        PidBT<T> pidBT = instances.get(i);
+        while (true) {
+            int k;
+            synchronized (this) {
+                if (nextWidth >= best || pidBT.isCancelled()) return;
+                k = nextWidth++;
+                widths[i] = k;
+            }
+            boolean solved = pidBT.decide(k);
+            synchronized (this) {
+                widths[i] = Integer.MAX_VALUE;
+                if (pidBT.isCancelled()) return; // a smaller width was solved
+                if (!solved) {
+                    LOG.info("tw > " + k);
+                    continue;
+                }
+                LOG.info("tw <= " + k);
+                if (k < best) {
+                    best = k;
+                    bestDecomposition = pidBT.getTreeDecomposition(k);
+                }
+                for (int j = 0; j < runs; j++) if (widths[j] > k && widths[j] != Integer.MAX_VALUE) instances.get(j).cancel();
+                return; // the blocks of this instance can not be used for larger widths, which are not needed anyway
+            }
+        }
+    }
+
+    @Override
+    public TreeDecomposition<T> call() throws Exception {
+        LOG.info("running speculative PID-BT with " + runs + " workers on graph with |V| = " + graph.getNumVertices());
+        LOG.info("current lb = " + lb);
+        LOG.info("current ub = " + ub);
+        nextWidth = lb;
+        best = ub;
+        bestDecomposition = ubDecomposition;
+        Arrays.fill(widths, Integer.MAX_VALUE);
+        instances.clear();
+
+        // start the workers on their own pool, as they block for a long time
+        int workers = Math.max(1, Math.min(runs, ub - lb));
+        List<Callable<Void>> tasks = new ArrayList<>(workers);
+        for (int i = 0; i < workers; i++) {
+            instances.add(new PidBT<>(graph, lb, ub, null, budget));
+            final int worker = i;
+            tasks.add(() -> {
+                try {
+                    work(worker);
+                } finally {
+                    instances.get(worker).release(); // the remaining workers can use the memory
+                }
+                return null;
+            });
+        }
+        ForkJoinPool pool = new ForkJoinPool(workers);
+        try {
+            for (Future<Void> future : pool.invokeAll(tasks)) future.get();
+        } finally {
+            for (PidBT<T> instance : instances) {
+                instance.cancel();
+                instance.release();
+            }
+            pool.shutdown();
+        }
+        LOG.info("tw = " + best);
+
+        // the upper bound was optimal or no decomposition was given
+        if (bestDecomposition == null) {
+            bestDecomposition = new TreeDecomposition<>(graph);
+            bestDecomposition.createBag(graph.getCopyOfVertices());
+        }
+        return bestDecomposition;
+    }
+
+    @Override
+    public TreeDecomposition<T> getCurrentSolution() {
+        return null;
+    }
+
+    @Override
+    public TreeDecomposition.TreeDecompositionQuality decompositionQuality() {
+        return TreeDecomposition.TreeDecompositionQuality.Exact;
+    }
+
+}
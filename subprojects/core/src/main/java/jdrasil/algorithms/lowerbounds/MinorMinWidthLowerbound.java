@@ -22,8 +22,9 @@ import java.io.Serializable;
 import java.util.*;
 
 
+import jdrasil.graph.EliminationGraph;
 import jdrasil.graph.Graph;
-import jdrasil.graph.GraphFactory;
+import jdrasil.graph.IntGraph;
 import jdrasil.utilities.RandomNumberGenerator;
 
 /**
@@ -32,6 +33,9 @@ import jdrasil.utilities.RandomNumberGenerator;
  * The minor-min-width heuristic devoloped by Gogate and Dechter for the QuickBB algorithm 
  * (see "A complete Anytime Algorithm for Treewidth") does exactly this. It computes a lowerbound for 
  * a minor of G and tries heuristically to find a good minor for this task.
+ *
+ * The minor is maintained on int adjacency arrays obtained from an IntGraph (or an EliminationGraph), so no vertex
+ * objects are touched during the contractions.
  * 
  * @param <T>
  * @author Max Bannach
@@ -40,8 +44,8 @@ public class MinorMinWidthLowerbound<T extends Comparable<T>> implements Lowerbo
 
 	private static final long serialVersionUID = -7729782858493633708L;
 
-	/** The graph for which we wish to find a lowerbound. */
-	private final Graph<T> graph;
+	/** The graph for which we wish to find a lowerbound, as int adjacency arrays (indexed by vertex ids). */
+	private final int[][] graph;
 
 	/** Current best lower bound */
 	private int low;
@@ -59,110 +63,192 @@ public class MinorMinWidthLowerbound<T extends Comparable<T>> implements Lowerbo
 	/** Strategy selected. */
 	private Algorithm toRun;
 
+	/*
+	 * The minor is stored as (unsorted) int adjacency arrays that are initialized from the graph,
+	 * adj[v][0..deg[v]-1] is the neighborhood of v. Contracted vertices have degree 0.
+	 */
+	private int[][] adj;
+	private int[] deg;
+
+	/** mark[w] == stamp iff w is a neighbor of the vertex that is currently processed. */
+	private int[] mark;
+	private int stamp;
+
+	/** Buffer for candidates with equal value, from which one is picked at random. */
+	private int[] candidates;
+
 	/**
 	 * The algorithm is initialized with a graph that should be decomposed and a seed for randomness.
 	 * @param graph
 	 */
 	public MinorMinWidthLowerbound(Graph<T> graph) {
-		this.graph = GraphFactory.copy(graph);
+		IntGraph<T> G = new IntGraph<>(graph);
+		this.graph = new int[G.getNumVertices()][];
+		for (int v = 0; v < G.getNumVertices(); v++) this.graph[v] = G.getNeighborhood(v);
 		this.low = 0;
 		setToRun(Algorithm.leastC);
 	}
 
 	/**
-	 * Get a neighbor of the given vertex \(v\) in the given graph \(G\) which is suitable for being contracted.
-	 * @param G
+	 * Initialize the algorithm with the current state of an elimination graph, eliminated vertices are ignored.
+	 * @param graph
+	 */
+	public MinorMinWidthLowerbound(EliminationGraph<T> graph) {
+		this.graph = new int[graph.getNumIds()][];
+		for (int v = 0; v < graph.getNumIds(); v++) {
+			int degree = graph.isEliminated(v) ? 0 : graph.getDegree(v);
+			this.graph[v] = new int[degree];
+			for (int i = 0; i < degree; i++) this.graph[v][i] = graph.getNeighbor(v, i);
+		}
+		this.low = 0;
+		setToRun(Algorithm.leastC);
+	}
+
+	/**
+	 * Get a neighbor of the given vertex \(v\) in the current minor which is suitable for being contracted.
+	 * The neighborhood of v has to be marked.
 	 * @param v
 	 * @return a neighbor of v that should be contracted into v
 	 */
-	private T getNeighbor(Graph<T> G, T v) {
+	private int getNeighbor(int v) {
 		// store all optimal vertices and pick one at random
-		List<T> nextU = new LinkedList<T>();
+		int size = 0;
 
 		// select the neighbor depending on the selected strategy
 		switch (toRun) {
 			case minD: // select neighbor of minimum degree
 				int min = Integer.MAX_VALUE;
-				for (T u : G.getNeighborhood(v)) {
-					int deg = G.getNeighborhood(u).size();
-					if (deg < min) {
-						min = deg;
-						nextU.clear();
-						nextU.add(u);
-					} else if (deg == min) {
-						nextU.add(u);
+				for (int i = 0; i < deg[v]; i++) {
+					int u = adj[v][i];
+					if (deg[u] < min) {
+						min = deg[u];
+						size = 0;
+						candidates[size++] = u;
+					} else if (deg[u] == min) {
+						candidates[size++] = u;
 					}
 				}
 				break;
 			case maxD: // select neighbor of maximum degree
 				int max = Integer.MIN_VALUE;
-				for (T u : G.getNeighborhood(v)) {
-					int deg = G.getNeighborhood(u).size();
-					if (deg > max) {
-						max = deg;
-						nextU.clear();
-						nextU.add(u);
-					} else if (deg == max) {
-						nextU.add(u);
+				for (int i = 0; i < deg[v]; i++) {
+					int u = adj[v][i];
+					if (deg[u] > max) {
+						max = deg[u];
+						size = 0;
+						candidates[size++] = u;
+					} else if (deg[u] == max) {
+						candidates[size++] = u;
 					}
 				}
 				break;
 			case leastC: // select neighbor with minimum amount of common neighbors
 				int minN = Integer.MAX_VALUE;
-				for (T u : G.getNeighborhood(v)) {
-					Set<T> common = new HashSet<>();
-					common.addAll(G.getNeighborhood(v));
-					common.retainAll(G.getNeighborhood(u));
-					int k = common.size();
+				for (int i = 0; i < deg[v]; i++) {
+					int u = adj[v][i];
+					int k = 0;
+					for (int j = 0; j < deg[u]; j++) if (mark[adj[u][j]] == stamp) k++;
 					if (k < minN) {
 						minN = k;
-						nextU.clear();
-						nextU.add(u);
+						size = 0;
+						candidates[size++] = u;
 					} else if (k == minN) {
-						nextU.add(u);
+						candidates[size++] = u;
 					}
 				}
 				break;
 		}
 
 		// done
-		return nextU.size() > 0 ? nextU.get(RandomNumberGenerator.nextInt(nextU.size())) : null;
+		return size > 0 ? candidates[RandomNumberGenerator.nextInt(size)] : -1;
+	}
+
+	/**
+	 * Remove u from the neighborhood of x.
+	 */
+	private void removeNeighbor(int x, int u) {
+		for (int i = 0; i < deg[x]; i++) {
+			if (adj[x][i] == u) {
+				adj[x][i] = adj[x][--deg[x]];
+				return;
+			}
+		}
+	}
+
+	/**
+	 * Contract the edge {v,u} into v. The neighborhood of v has to be marked and stays marked.
+	 */
+	private void contract(int v, int u) {
+		removeNeighbor(v, u);
+		mark[u] = 0;
+		for (int i = 0; i < deg[u]; i++) {
+			int w = adj[u][i];
+			if (w == v) continue;
+			if (mark[w] == stamp) { // w is already adjacent to v
+				removeNeighbor(w, u);
+			} else { // move the edge {w,u} to {w,v}
+				for (int j = 0; j < deg[w]; j++) {
+					if (adj[w][j] == u) { adj[w][j] = v; break; }
+				}
+				if (deg[v] == adj[v].length) adj[v] = Arrays.copyOf(adj[v], 2*deg[v]+1);
+				adj[v][deg[v]++] = w;
+				mark[w] = stamp;
+			}
+		}
+		deg[u] = 0;
 	}
 
 	@Override
-	public Integer call() throws Exception {	 
+	public Integer call() throws Exception {
+		int n = graph.length;
+		adj = new int[n][];
+		deg = new int[n];
+		for (int v = 0; v < n; v++) {
+			adj[v] = graph[v].clone();
+			deg[v] = adj[v].length;
+		}
+		mark = new int[n];
+		stamp = 0;
+		candidates = new int[n];
+
+		// as long as the minor has edges we can still contract some
+		while (true) {
 
-		// as long as the graph has vertices we can still contract some
-		while (graph.getCopyOfVertices().size() > 0) {
-			
 			// search vertex of min degree
 			int min = Integer.MAX_VALUE;
-			List<T> nextV = new LinkedList<>();
-			for (T v : graph) {
-				int deg = graph.getNeighborhood(v).size();
-				if (deg == 0) continue; // ignore isolated vertices
-				if (deg < min) {
-					min = deg;
-					nextV.clear();
-					nextV.add(v);
-				} else if (deg == min) { // break ties randomly
-					nextV.add(v);
+			int size = 0;
+			for (int v = 0; v < n; v++) {
+				if (deg[v] == 0) continue; // ignore isolated (and contracted) vertices
+				if (deg[v] < min) {
+					min = deg[v];
+					size = 0;
+					candidates[size++] = v;
+				} else if (deg[v] == min) { // break ties randomly
+					candidates[size++] = v;
 				}
 			}
-			T v = nextV.size() > 0 ? nextV.get(RandomNumberGenerator.nextInt(nextV.size())) : null;
-			if (v == null) break;
+			if (size == 0) break;
+			int v = candidates[RandomNumberGenerator.nextInt(size)];
 
 			// update lowerbound
-			low = Math.max(low, graph.getNeighborhood(v).size());
+			low = Math.max(low, deg[v]);
 
 			// search suitable neighbor for contraction
-			T u = getNeighbor(graph, v);
-			if (u == null) break;
+			stamp++;
+			for (int i = 0; i < deg[v]; i++) mark[adj[v][i]] = stamp;
+			int u = getNeighbor(v);
+			if (u < 0) break;
 
 			// contract edge
-			graph.contract(v, u);
+			contract(v, u);
 		}
 
+		// free the minor
+		adj = null;
+		deg = null;
+		mark = null;
+		candidates = null;
+
 		// done
 		return low;
 	}
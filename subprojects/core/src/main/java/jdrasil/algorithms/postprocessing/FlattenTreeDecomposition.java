@@ -1,6 +1,7 @@
 package jdrasil.algorithms.postprocessing;
 
 import jdrasil.graph.Bag;
+import jdrasil.graph.CompactTreeDecomposition;
 import jdrasil.graph.Graph;
 import jdrasil.graph.TreeDecomposition;
 
@@ -23,6 +24,15 @@ public class FlattenTreeDecomposition<T extends Comparable<T>> extends Postproce
         super(treeDecomposition);
     }
 
+    /**
+     * Stores a compact tree-decomposition that should be postprocessed, @see Postprocessor(CompactTreeDecomposition).
+     *
+     * @param treeDecomposition The tree-decomposition to be postprocessed.
+     */
+    public FlattenTreeDecomposition(CompactTreeDecomposition<T> treeDecomposition) {
+        super(treeDecomposition);
+    }
+
     @Override
     protected TreeDecomposition<T> postprocessTreeDecomposition() {
         contractDuplicateBags();
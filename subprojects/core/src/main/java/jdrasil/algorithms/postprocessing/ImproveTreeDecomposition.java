@@ -1,6 +1,7 @@
 package jdrasil.algorithms.postprocessing;
 
 import jdrasil.graph.Bag;
+import jdrasil.graph.CompactTreeDecomposition;
 import jdrasil.graph.Graph;
 import jdrasil.graph.GraphFactory;
 import jdrasil.graph.TreeDecomposition;
@@ -28,6 +29,15 @@ public class ImproveTreeDecomposition<T extends Comparable<T>> extends Postproce
         super(treeDecomposition);
     }
 
+    /**
+     * Stores a compact tree-decomposition that should be postprocessed, @see Postprocessor(CompactTreeDecomposition).
+     *
+     * @param treeDecomposition The tree-decomposition to be postprocessed.
+     */
+    public ImproveTreeDecomposition(CompactTreeDecomposition<T> treeDecomposition) {
+        super(treeDecomposition);
+    }
+
     @Override
     protected TreeDecomposition<T> postprocessTreeDecomposition() {
         improveDecomposition();
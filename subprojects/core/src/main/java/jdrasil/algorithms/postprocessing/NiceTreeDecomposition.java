@@ -1,6 +1,7 @@
 package jdrasil.algorithms.postprocessing;
 
 import jdrasil.graph.Bag;
+import jdrasil.graph.CompactTreeDecomposition;
 import jdrasil.graph.Graph;
 import jdrasil.graph.TreeDecomposition;
 
@@ -90,6 +91,26 @@ public class NiceTreeDecomposition<T extends Comparable<T>> extends Postprocesso
         this.isVeryNice = veryNice;
     }
 
+    /**
+     * Stores a compact tree decomposition that should be postprocessed, @see Postprocessor(CompactTreeDecomposition).
+     *
+     * @param treeDecomposition The tree decomposition to be postprocessed.
+     */
+    public NiceTreeDecomposition(CompactTreeDecomposition<T> treeDecomposition) {
+        this(treeDecomposition, false);
+    }
+
+    /**
+     * Stores a compact tree decomposition that should be postprocessed, @see Postprocessor(CompactTreeDecomposition).
+     *
+     * @param treeDecomposition The tree decomposition to be postprocessed.
+     * @param veryNice Decide whether edge bags should be computed or not.
+     */
+    public NiceTreeDecomposition(CompactTreeDecomposition<T> treeDecomposition,
+                                 boolean veryNice) {
+        this(treeDecomposition.toTreeDecomposition(), veryNice);
+    }
+
     @Override
     protected TreeDecomposition<T> postprocessTreeDecomposition() {
         // first simplify the decomposition
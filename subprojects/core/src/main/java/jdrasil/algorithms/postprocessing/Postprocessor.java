@@ -1,5 +1,6 @@
 package jdrasil.algorithms.postprocessing;
 
+import jdrasil.graph.CompactTreeDecomposition;
 import jdrasil.graph.TreeDecomposition;
 
 /**
@@ -34,6 +35,16 @@ public abstract class Postprocessor<T extends Comparable<T>> {
         this.processedTreeDecomposition = null;
     }
 
+    /**
+     * Stores a compact tree decomposition that should be postprocessed. Postprocessors modify bags and the tree, so the
+     * decomposition is converted to a TreeDecomposition first.
+     *
+     * @param treeDecomposition The tree decomposition to be postprocessed.
+     */
+    public Postprocessor(CompactTreeDecomposition<T> treeDecomposition) {
+        this(treeDecomposition.toTreeDecomposition());
+    }
+
     /**
      * This method computes the actual postprocessing. It shall use @see treeDecomposition and shall return a postprocessed
      * version of it. This may the same reference if the postprocessing is performed inplace.
@@ -52,4 +63,13 @@ public abstract class Postprocessor<T extends Comparable<T>> {
         if (this.processedTreeDecomposition == null) this.processedTreeDecomposition = postprocessTreeDecomposition();
         return processedTreeDecomposition;
     }
+
+    /**
+     * Obtain the postprocessed tree decomposition in its compact representation, see @see getProcessedTreeDecomposition.
+     *
+     * @return A postprocessed version of the given tree decomposition as CompactTreeDecomposition.
+     */
+    public CompactTreeDecomposition<T> getProcessedCompactTreeDecomposition() {
+        return new CompactTreeDecomposition<>(getProcessedTreeDecomposition());
+    }
 }
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.algorithms.preprocessing;
+
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Map;
+import java.util.Set;
+
+import jdrasil.graph.Bag;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.IntGraph;
+import jdrasil.graph.TreeDecomposition;
+
+/**
+ * The GraphRelabeler renames the vertices of a graph to \(\{1,\dots,n\}\) in an order that keeps adjacent vertices
+ * close together.
+ *
+ * Solvers map the vertices to integers in the ascending order of the vertices (@see Graph#getSortedVertices()), which is
+ * essentially random for arbitrary labels. On the relabeled graph this order is the computed one, so rows of bitset
+ * adjacency matrices and the variables of SAT encodings of a neighborhood lie close together.
+ *
+ * Tree decompositions of the relabeled graph are mapped back to the original graph with
+ * @see restoreTreeDecomposition(TreeDecomposition).
+ *
+ * @author Max Bannach
+ */
+public class GraphRelabeler<T extends Comparable<T>> {
+
+	/**
+	 * The available orders.
+	 */
+	public enum Order {
+		/** breadth-first search, see @see IntGraph#getBreadthFirstOrder() */
+		BFS,
+		/** reverse Cuthill-McKee, see @see IntGraph#getReverseCuthillMcKeeOrder() */
+		RCM,
+		/** degeneracy order, see @see IntGraph#getDegeneracyOrder() */
+		DEGENERACY
+	}
+
+	/** The original graph. */
+	private final Graph<T> graph;
+
+	/** The relabeled graph. */
+	private final Graph<Integer> relabeledGraph;
+
+	/** The vertex of the original graph for every vertex \(v\) of the relabeled graph, stored at position \(v-1\). */
+	private final Object[] vertices;
+
+	/**
+	 * Computes the order and relabels the graph.
+	 * @param graph the graph to be relabeled
+	 * @param order the order in which the vertices will be numbered
+	 */
+	public GraphRelabeler(Graph<T> graph, Order order) {
+		this.graph = graph;
+		IntGraph<T> intGraph = new IntGraph<>(graph);
+		int[] permutation;
+		switch (order) {
+			case BFS:
+				permutation = intGraph.getBreadthFirstOrder();
+				break;
+			case DEGENERACY:
+				permutation = intGraph.getDegeneracyOrder();
+				break;
+			default:
+				permutation = intGraph.getReverseCuthillMcKeeOrder();
+		}
+		this.relabeledGraph = GraphFactory.graphFromIntGraph(intGraph.relabel(permutation));
+		this.vertices = new Object[permutation.length];
+		for (int i = 0; i < permutation.length; i++) vertices[i] = intGraph.getVertex(permutation[i]);
+	}
+
+	/**
+	 * Getter for the original graph.
+	 * @return the graph that was relabeled
+	 */
+	public Graph<T> getGraph() {
+		return graph;
+	}
+
+	/**
+	 * Getter for the relabeled graph.
+	 * @return a graph over \(\{1,\dots,n\}\) that is isomorphic to the original graph
+	 */
+	public Graph<Integer> getRelabeledGraph() {
+		return relabeledGraph;
+	}
+
+	/**
+	 * Get the vertex of the original graph that corresponds to the given vertex of the relabeled graph.
+	 * @param v a vertex of the relabeled graph
+	 * @return the corresponding vertex of the original graph
+	 */
+	@SuppressWarnings("unchecked")
+	public T getOriginalVertex(int v) {
+		return (T) vertices[v-1];
+	}
+
+	/**
+	 * Maps a tree decomposition of the relabeled graph to a tree decomposition of the original graph with the same
+	 * tree and width.
+	 * @param decomposition a tree decomposition of the relabeled graph (may be null)
+	 * @return the corresponding tree decomposition of the original graph, or null if decomposition was null
+	 */
+	public TreeDecomposition<T> restoreTreeDecomposition(TreeDecomposition<Integer> decomposition) {
+		if (decomposition == null) return null;
+		TreeDecomposition<T> treeDecomposition = new TreeDecomposition<>(graph);
+		Map<Bag<Integer>, Bag<T>> bags = new HashMap<>();
+		for (Bag<Integer> bag : decomposition.getBags()) {
+			Set<T> bagVertices = new HashSet<>();
+			for (int v : bag.vertices) bagVertices.add(getOriginalVertex(v));
+			bags.put(bag, treeDecomposition.createBag(bagVertices));
+		}
+		for (Bag<Integer> bag : decomposition.getBags()) {
+			for (Bag<Integer> neighbor : decomposition.getNeighborhood(bag)) {
+				treeDecomposition.addTreeEdge(bags.get(bag), bags.get(neighbor));
+			}
+		}
+		treeDecomposition.setCreatedFromPermutation(decomposition.isCreatedFromPermutation());
+		return treeDecomposition;
+	}
+
+}
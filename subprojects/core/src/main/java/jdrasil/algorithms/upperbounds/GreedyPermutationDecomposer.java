@@ -20,7 +20,6 @@ package jdrasil.algorithms.upperbounds;
 
 import java.io.Serializable;
 import java.util.ArrayList;
-import java.util.Collections;
 import java.util.HashMap;
 import java.util.HashSet;
 import java.util.LinkedList;
@@ -33,8 +32,8 @@ import java.util.logging.Logger;
 import jdrasil.Heuristic;
 import jdrasil.datastructures.UpdatablePriorityQueue;
 import jdrasil.graph.Bag;
+import jdrasil.graph.EliminationGraph;
 import jdrasil.graph.Graph;
-import jdrasil.graph.GraphFactory;
 import jdrasil.graph.TreeDecomposer;
 import jdrasil.graph.TreeDecomposition;
 import jdrasil.graph.TreeDecomposition.TreeDecompositionQuality;
@@ -104,18 +103,38 @@ public class GreedyPermutationDecomposer<T extends Comparable<T>> implements Tre
 	 * Given a graph and a vertex of it, this method computes the value (with respect to the choosen heuristic)
 	 * of the given vertex in this graph.
 	 * @param G the graph which contains the vertex
-	 * @param v the vertex for which the value should be computed
+	 * @param v the id of the vertex for which the value should be computed
 	 * @return the heuristic value of the given vertex as VertexTuple
 	 */
-	private VertexValue getValue(Graph<T> G, T v) {
+	private VertexValue getValue(EliminationGraph<T> G, int v) {
 		VertexValue tuple = new VertexValue();
-		tuple.vertex = v;
+		tuple.vertex = G.getVertex(v);
+		tuple.value = getValue(G, v, G.getNumVertices());
 
-		// fill-in value and degree of the vertex
-		int phi = G.getFillInValue(v);
-		int delta = G.getNeighborhood(v).size();
-		int n = G.getNumVertices();
+		// done
+		return tuple;
+	}
 
+	/**
+	 * Computes the value of a vertex of the elimination graph, the degree heuristic does not need fill-in values.
+	 * @param G the graph which contains the vertex
+	 * @param v the id of the vertex
+	 * @param n the number of vertices of the graph
+	 * @return the heuristic value
+	 */
+	private int getValue(EliminationGraph<T> G, int v, int n) {
+		int phi = toRun == Algorithm.Degree ? 0 : G.getFillInValue(v);
+		return getValue(phi, G.getDegree(v), n);
+	}
+
+	/**
+	 * Computes the value of a vertex (with respect to the choosen heuristic) from its fill-in value and degree.
+	 * @param phi the fill-in value of the vertex
+	 * @param delta the degree of the vertex
+	 * @param n the number of vertices of the graph
+	 * @return the heuristic value
+	 */
+	private int getValue(int phi, int delta, int n) {
 		// compute the value of the vertex with respect to the current algorithm
 		int value = 0;
 		switch (toRun) {
@@ -142,10 +161,7 @@ public class GreedyPermutationDecomposer<T extends Comparable<T>> implements Tre
 				value = phi + (1/n)*delta;
 				break;
 		}
-		tuple.value = value;
-
-		// done
-		return tuple;
+		return value;
 	}
 
 	/**
@@ -160,23 +176,23 @@ public class GreedyPermutationDecomposer<T extends Comparable<T>> implements Tre
 	 * @param k the number of vertices that should be considered in the future
 	 * @return A VertexValue tuple storing the best vertex and its value
 	 */
-	private VertexValue nextVertex(Graph<T> G, int k) {
+	private VertexValue nextVertex(EliminationGraph<T> G, int k) {
 		// min value that any vertex has, and a list of vertices with this value
 		int min = Integer.MAX_VALUE;
 		List<VertexValue> best = new LinkedList<>();
 
 		// search for the best vertex
-		for (T v : G.getCopyOfVertices()) {
+		for (int v = 0; v < G.getNumIds(); v++) {
+			if (G.isEliminated(v)) continue;
 
 			// the vertex-value-tuple of the current vertex
 			VertexValue tuple = getValue(G, v);
 
 			// eliminate vertex and look for further value
-			if (k > 1 && G.getCopyOfVertices().size() > 1) {
-//				System.out.println("test");
-				Graph.EliminationInformation info = G.eliminateVertex(v);
+			if (k > 1 && G.getNumVertices() > 1) {
+				G.eliminateVertex(v);
 				VertexValue next = nextVertex(G, k - 1);
-				G.deEliminateVertex(info);
+				G.undo();
 				tuple.value += next.value;
 			}
 
@@ -224,22 +240,31 @@ public class GreedyPermutationDecomposer<T extends Comparable<T>> implements Tre
 		long tStart = System.currentTimeMillis();
 		// the permutation that we wish to compute and a copy of the graph, which will be modified
 		List<T> permutation = new LinkedList<T>();
-		Graph<T> workingCopy = GraphFactory.copy(graph);
-		if(toRun == Algorithm.Degree){
-			workingCopy.setLogEdgesInNeighbourhood(false);
+		EliminationGraph<T> workingCopy = new EliminationGraph<>(graph, toRun != Algorithm.Degree);
+		int n = workingCopy.getNumIds();
+		UpdatablePriorityQueue<Integer, Integer> q = new UpdatablePriorityQueue<Integer, Integer>();
+		int[] helper = new int[n];
+		for (int v = 0; v < n; v++) helper[v] = v;
+		Random random = new Random(RandomNumberGenerator.nextLong());
+		for (int i = n-1; i > 0; i--) {
+			int j = random.nextInt(i+1);
+			int swap = helper[i]; helper[i] = helper[j]; helper[j] = swap;
 		}
-		UpdatablePriorityQueue<T, Integer> q = new UpdatablePriorityQueue<T, Integer>();
-		ArrayList<T> helper = new ArrayList<>(graph.getCopyOfVertices());
-		Collections.shuffle(helper, new Random(RandomNumberGenerator.nextLong()));
-		for(T v : helper){
-			VertexValue vv = getValue(graph, v);
-			q.insert(vv.vertex, vv.value);
+		for(int v : helper){
+			q.insert(v, getValue(workingCopy, v, n));
 		}
 		Map<T, Bag<T>> eliminatedAt = new HashMap<>();
 		TreeDecomposition<T> td = new TreeDecomposition<>(graph);
+
+		// vertices in distance at most two of the eliminated vertex (their values may change) and the vertices of its bag
+		int[] touched = new int[n];
+		int[] touchedMark = new int[n];
+		int[] bagMark = new int[n];
+		int[] bagIds = new int[n];
+		List<Integer> deleteImmediately = new ArrayList<>();
 			
 		// compute the permutation
-		for (int i = 0; i < graph.getNumVertices() && q.size() > 0; i++) {
+		for (int i = 0; i < n && q.size() > 0; i++) {
 			if(workingCopy.getNumVertices() != q.size())
 				throw new RuntimeException("Queue is wrong???");
 			/*-**********************************************************************************
@@ -251,7 +276,8 @@ public class GreedyPermutationDecomposer<T extends Comparable<T>> implements Tre
 			if((i % 10) == 0 && (JdrasilProperties.timeout() || Heuristic.shutdownFlag)){
 				// Panic, we're running out of time! 
 				if(q.size() <= upper_bound){
-					Set<T> allRemainingVertices = workingCopy.getCopyOfVertices();
+					Set<T> allRemainingVertices = new HashSet<>();
+					for (int v = 0; v < n; v++) if (!workingCopy.isEliminated(v)) allRemainingVertices.add(workingCopy.getVertex(v));
 					Bag<T> finalBag = td.createBag(allRemainingVertices);
 					for(T v : allRemainingVertices){
 						permutation.add(v);
@@ -267,45 +293,55 @@ public class GreedyPermutationDecomposer<T extends Comparable<T>> implements Tre
 				}
 			}
 			// obtain next vertex with respect to the current algorithm and check if this is a reasonable choice
-			int lowestPrio = q.getMinPrio();
-			T vv = q.removeMinRandom();
-			Set<T> tmp = new HashSet<>();
-			T v = vv; // nextVertex(working, this.k);
-			for(T v1 : workingCopy.getNeighborhood(v)){
-				tmp.add(v1);
-				for(T v2 : workingCopy.getNeighborhood(v1)){
-					tmp.add(v2);
+			int v = q.removeMinRandom(); // nextVertex(working, this.k);
+			int degree = workingCopy.getDegree(v);
+			int stamp = i+1;
+			int numTouched = 0;
+			for(int j = 0; j < degree; j++){
+				int v1 = workingCopy.getNeighbor(v, j);
+				if(touchedMark[v1] != stamp){ touchedMark[v1] = stamp; touched[numTouched++] = v1; }
+				for(int l = 0; l < workingCopy.getDegree(v1); l++){
+					int v2 = workingCopy.getNeighbor(v1, l);
+					if(v2 != v && touchedMark[v2] != stamp){ touchedMark[v2] = stamp; touched[numTouched++] = v2; }
 				}
 			}
-			int predictionNewNumberEdges = workingCopy.getNumberOfEdges() + workingCopy.getFillInValue(v) - workingCopy.getNeighborhood(v).size();
+			int predictionNewNumberEdges = toRun == Algorithm.Degree ? 0 : workingCopy.getNumberOfEdges() + workingCopy.getFillInValue(v) - degree;
 			
-			if(workingCopy.getNeighborhood(v).size() >= upper_bound){
+			if(degree >= upper_bound){
 				// Okay, this creates a clique of size >= upper_bound + 1, I can abort!
 				return null;
 			}
 
 			// add it to the permutation and eliminate it in the current subgraph
-			permutation.add(v);
+			T vertex = workingCopy.getVertex(v);
+			permutation.add(vertex);
 			Set<T> bagNodes = new HashSet<>();
-			bagNodes.addAll(workingCopy.getNeighborhood(v));
-			bagNodes.add(v);
-			eliminatedAt.put(v, td.createBag(bagNodes));
+			bagNodes.add(vertex);
+			bagMark[v] = stamp;
+			for(int j = 0; j < degree; j++){
+				int u = workingCopy.getNeighbor(v, j);
+				bagIds[j] = u;
+				bagMark[u] = stamp;
+				bagNodes.add(workingCopy.getVertex(u));
+			}
+			Bag<T> bag = td.createBag(bagNodes);
+			eliminatedAt.put(vertex, bag);
 			// Look into this bag: Is there a node such that its neighbourhood is a subset of this bag? 
 			// If so, it can be removed here as well! 
-			workingCopy.eliminateVertex(v, toRun != Algorithm.Degree);
+			workingCopy.eliminateVertex(v);
+			workingCopy.clearHistory(); // we never undo an elimination
 			if(toRun != Algorithm.Degree &&  workingCopy.getNumberOfEdges() != predictionNewNumberEdges){
 				throw new RuntimeException("Miss-predicted fill values!");
 			}
 			// Check if further nodes can be eliminated here! 
-			List<T> deleteImmediately = new ArrayList<>();
-			for(T u : bagNodes){
-				if(u.compareTo(v) != 0){
-					if(workingCopy.getNeighborhood(u).size() < bagNodes.size()-1){
-						for(T w : workingCopy.getNeighborhood(u))
-							if(!bagNodes.contains(w))
-								throw new RuntimeException("Hmm. This node DOES have neighbours outside the clique I just created??? ");
-						deleteImmediately.add(u);
-					}
+			deleteImmediately.clear();
+			for(int j = 0; j < degree; j++){
+				int u = bagIds[j];
+				if(workingCopy.getDegree(u) < bagNodes.size()-1){
+					for(int l = 0; l < workingCopy.getDegree(u); l++)
+						if(bagMark[workingCopy.getNeighbor(u, l)] != stamp)
+							throw new RuntimeException("Hmm. This node DOES have neighbours outside the clique I just created??? ");
+					deleteImmediately.add(u);
 				}
 			}
 			if(deleteImmediately.size() == workingCopy.getNumVertices()){
@@ -313,24 +349,20 @@ public class GreedyPermutationDecomposer<T extends Comparable<T>> implements Tre
 			}
 			// Delete nodes which have only neighbours in the clique of the node that was just eliminated. 
 			// For compatibility reasons, add them to the permutation, and give them bags... 
-			for(T u : deleteImmediately){
-				permutation.add(u);
-				eliminatedAt.put(u, eliminatedAt.get(v));
-				workingCopy.eliminateSimplicialVertex(u, toRun != Algorithm.Degree);
+			for(int u : deleteImmediately){
+				permutation.add(workingCopy.getVertex(u));
+				eliminatedAt.put(workingCopy.getVertex(u), bag);
+				workingCopy.eliminateVertex(u);
+				workingCopy.clearHistory();
 				q.updateValue(u, q.getMinPrio()-1);
-				if(q.removeMin().compareTo(u) != 0)
+				if(q.removeMin() != u)
 					throw new RuntimeException("Removing the node from the queue did not work???");
-				tmp.remove(u);
 			}
-			for(T v_n : tmp){
-				if(v_n != v && v.compareTo(v_n) != 0){
-					//LOG.info("updating value of node " + v_n + ", v=" + v + ", compare yields" + v.compareTo(v_n));
-					VertexValue v_update = getValue(workingCopy, v_n);
-					if(v_update == null){
-						LOG.info("v_update was null");
-					}
-					
-					q.updateValue(v_n, getValue(workingCopy, v_n).value);
+			int remaining = workingCopy.getNumVertices();
+			for(int j = 0; j < numTouched; j++){
+				int v_n = touched[j];
+				if(!workingCopy.isEliminated(v_n)){
+					q.updateValue(v_n, getValue(workingCopy, v_n, remaining));
 				}
 			}
 		}
@@ -20,18 +20,17 @@ package jdrasil.algorithms.upperbounds;
 
 import java.io.Serializable;
 import java.util.HashMap;
-import java.util.HashSet;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Map;
 import java.util.Queue;
 import java.util.Random;
-import java.util.Set;
 import java.util.logging.Logger;
 
 import jdrasil.Heuristic;
 import jdrasil.algorithms.EliminationOrderDecomposer;
 import jdrasil.graph.Bag;
+import jdrasil.graph.EliminationGraph;
 import jdrasil.graph.Graph;
 import jdrasil.graph.GraphFactory;
 import jdrasil.graph.TreeDecomposer;
@@ -75,6 +74,9 @@ public class LocalSearchDecomposer<T extends Comparable<T>> implements TreeDecom
 
 	TreeDecomposition<T> tdOpt;
 
+	/** The graph on which permutations are evaluated, it is restored after every evaluation. */
+	private final EliminationGraph<T> eliminationGraph;
+
 	/**
 	 * Initialize the algorithm to decompose the given graph.
 	 * @param graph to be decomposed
@@ -86,6 +88,7 @@ public class LocalSearchDecomposer<T extends Comparable<T>> implements TreeDecom
 		this.r = r;
 		this.s = s;
 		this.permOpt = perm;		
+		this.eliminationGraph = new EliminationGraph<>(graph, false);
 	}
 
 
@@ -289,30 +292,20 @@ public class LocalSearchDecomposer<T extends Comparable<T>> implements TreeDecom
 	
 	/**
 	 * Calculates the cost of a permutation by computing its treewidth and preferring tree decompositions with more smaller bags.
+	 * The elimination game is played on the shared elimination graph and undone afterwards.
 	 * @param perm The permutation
 	 * @return the cost of perm
 	 */
 	public long evalPerm(List<T> perm) throws Exception{
-		Map<T, Integer> pos = toMap(perm);
-		Graph<T> g = GraphFactory.copy(graph);
-		g.setLogEdgesInNeighbourhood(false);
+		int checkpoint = eliminationGraph.getCheckpoint();
 		int maxBag = 0;
 		long res = 0;
-		int posOfV = 0;
-		int maxDegreeSeenHere = 0;
 		for(T v: perm){
-			// only consider the neighbours with higher index. The others are already removed
-			Set<T> bag = new HashSet<T>();
-			if(g.getNeighborhood(v).size() > maxDegreeSeenHere)
-				maxDegreeSeenHere = g.getNeighborhood(v).size();
-			for(T u: g.getNeighborhood(v)){
-				if(pos.get(u) > posOfV){
-					bag.add(u);
-				}
-			}
+			// the remaining neighbours of v are exactly its neighbours with higher index
+			int id = eliminationGraph.getId(v);
+			int tmp = eliminationGraph.getDegree(id);
 
 			// update the treewidth if necessary
-			int tmp = bag.size();
 			if (tmp > maxBag){
 				maxBag = tmp;
 			}
@@ -321,15 +314,9 @@ public class LocalSearchDecomposer<T extends Comparable<T>> implements TreeDecom
 			res = res + tmp*tmp;
 
 			// connect every node in the bag
-			for(T u: bag){
-				for(T w: bag){
-					if(!g.isAdjacent(u,w)){
-						g.addEdge(u,w);
-					}
-				}
-			}
-			posOfV++;
+			eliminationGraph.eliminateVertex(id);
 		}
+		eliminationGraph.rollback(checkpoint);
 
 		// ensure that the tw dominates
 		long l1 = maxBag * maxBag;
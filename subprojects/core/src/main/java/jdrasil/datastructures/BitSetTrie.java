@@ -19,10 +19,12 @@
 package jdrasil.datastructures;
 
 import java.util.*;
+import java.util.function.Function;
 
 /**
  * A set-trie is a trie that stores ordered sets - essentially by interpreting the set as string and the elements as symbols.
- * This class implements a set-trie over BitSets, which are a natural representation of ordered sets.
+ * This class implements a set-trie over BitSets, which are a natural representation of ordered sets. The trie can
+ * be used with BitSets as well as with VertexSets, the queries return sets of the type they are called with.
  *
  * With a set-trie we can efficiently check if a set is in the collection, and we can quickly iterate over stored sub- and
  * super sets of a given set.
@@ -86,8 +88,21 @@ public class BitSetTrie {
      * @param s The bitset we add.
      */
     public void insert(BitSet s) {
-        if (s.cardinality() == 0) { containsEmptySet = true; return; } // empty set is special
         if (s.size() > universeSize) universeSize = s.size(); // update universe size
+        insert(query(s));
+    }
+
+    /**
+     * Insert the given set to the trie, @see insert(BitSet).
+     * @param s The set we add.
+     */
+    public void insert(VertexSet s) {
+        if (s.capacity() > universeSize) universeSize = s.capacity(); // update universe size
+        insert(query(s));
+    }
+
+    private void insert(Query s) {
+        if (s.isEmpty()) { containsEmptySet = true; return; } // empty set is special
 
         // crawl to the node containing s
         Node crawler = root;
@@ -119,7 +134,20 @@ public class BitSetTrie {
      * @return True if the bitset is contained in the tree.
      */
     public boolean contains(BitSet s) {
-        if (s.cardinality() == 0) return containsEmptySet; // handle empty set
+        return contains(query(s));
+    }
+
+    /**
+     * Checks whether or not the given trie stores the given set, @see contains(BitSet).
+     * @param s The set we test.
+     * @return True if the set is contained in the tree.
+     */
+    public boolean contains(VertexSet s) {
+        return contains(query(s));
+    }
+
+    private boolean contains(Query s) {
+        if (s.isEmpty()) return containsEmptySet; // handle empty set
 
         // crawl to a node that would contain s
         Node crawler = root;
@@ -146,7 +174,19 @@ public class BitSetTrie {
      * @param s The bitset we want to remove.
      */
     public void remove(BitSet s) {
-        if (s.cardinality() == 0) { containsEmptySet = false; return; } // handle empty set
+        remove(query(s));
+    }
+
+    /**
+     * Removes the given set from the trie, @see remove(BitSet).
+     * @param s The set we want to remove.
+     */
+    public void remove(VertexSet s) {
+        remove(query(s));
+    }
+
+    private void remove(Query s) {
+        if (s.isEmpty()) { containsEmptySet = false; return; } // handle empty set
 
         // crawl to a node that would contain s
         Node crawler = root;
@@ -182,12 +222,16 @@ public class BitSetTrie {
      * @return An iterator over contained subsets.
      */
     public Iterable<BitSet> getSubSets(BitSet s) {
-        return new Iterable<BitSet>() {
-            @Override
-            public Iterator<BitSet> iterator() {
-                return new SubSetIterator(s);
-            }
-        };
+        return () -> new SubSetIterator<>(query(s), BitSetTrie::toBitSet);
+    }
+
+    /**
+     * Same as @see getSubSets(BitSet) for VertexSets, the returned sets have the universe of s.
+     * @param s The set we query.
+     * @return An iterator over the stored sets as VertexSets.
+     */
+    public Iterable<VertexSet> getSubSets(VertexSet s) {
+        return () -> new SubSetIterator<>(query(s), v -> toVertexSet(v, s.capacity()));
     }
 
     /**
@@ -198,26 +242,28 @@ public class BitSetTrie {
      * in the trie. However, if \(s\) becomes smaller this method becomes more efficient. Note that the size of the trie
      * can be exponential in the size of the universe.
      */
-    class SubSetIterator implements Iterator<BitSet> {
+    class SubSetIterator<S> implements Iterator<S> {
 
         private Stack<Node> stack;
-        private BitSet s;
-        private BitSet next;
+        private Query s;
+        private Function<Node, S> build;
+        private S next;
         private boolean returnedEmptySet;
 
-        public SubSetIterator(BitSet s) {
+        public SubSetIterator(Query s, Function<Node, S> build) {
             this.s = s;
+            this.build = build;
             this.stack = new Stack<>();
             this.stack.push(root);
             this.returnedEmptySet = false;
             this.next = successor();
         }
 
-        private BitSet successor() {
+        private S successor() {
             // handle empty set
             if (containsEmptySet && !returnedEmptySet) {
                 returnedEmptySet = true;
-                return new BitSet();
+                return build.apply(root);
             }
             // traverse the trie
             while (!stack.isEmpty()) {
@@ -225,14 +271,7 @@ public class BitSetTrie {
                 for (int i = s.length(); (i = s.previousSetBit(i - 1)) > v.label; ) {
                     if (v.children.containsKey(i)) stack.push(v.children.get(i));
                 }
-                if (v.marked) { // construct found bitset
-                    BitSet nextSet = new BitSet();
-                    while (v.label >= 0) {
-                        nextSet.set(v.label);
-                        v = v.parent;
-                    }
-                    return nextSet;
-                }
+                if (v.marked) return build.apply(v); // construct found set
             }
             // trie search done
             return null;
@@ -244,8 +283,8 @@ public class BitSetTrie {
         }
 
         @Override
-        public BitSet next() {
-            BitSet tmp = next;
+        public S next() {
+            S tmp = next;
             next = successor();
             return tmp;
         }
@@ -260,12 +299,16 @@ public class BitSetTrie {
      * @return An iterator over bitsets that contain the given one.
      */
     public Iterable<BitSet> getMaxSubSets(BitSet s) {
-        return new Iterable<BitSet>() {
-            @Override
-            public Iterator<BitSet> iterator() {
-                return new MaxSubSetIterator(s);
-            }
-        };
+        return () -> new MaxSubSetIterator<>(query(s), BitSetTrie::toBitSet);
+    }
+
+    /**
+     * Same as @see getMaxSubSets(BitSet) for VertexSets, the returned sets have the universe of s.
+     * @param s The set we query.
+     * @return An iterator over the stored sets as VertexSets.
+     */
+    public Iterable<VertexSet> getMaxSubSets(VertexSet s) {
+        return () -> new MaxSubSetIterator<>(query(s), v -> toVertexSet(v, s.capacity()));
     }
 
     /**
@@ -274,26 +317,28 @@ public class BitSetTrie {
      * the iterator uses only edges set in the given set. The running time is \(O(|T|*|U|\) where \(T\) is the the trie
      * and \(U\) is the universe.
      */
-    class MaxSubSetIterator implements Iterator<BitSet> {
+    class MaxSubSetIterator<S> implements Iterator<S> {
 
         private Stack<Node> stack;
-        private BitSet s;
-        private BitSet next;
+        private Query s;
+        private Function<Node, S> build;
+        private S next;
         private boolean returnedEmptySet;
 
-        public MaxSubSetIterator(BitSet s) {
+        public MaxSubSetIterator(Query s, Function<Node, S> build) {
             this.s = s;
+            this.build = build;
             this.stack = new Stack<>();
             this.stack.push(root);
             this.returnedEmptySet = false;
             this.next = successor();
         }
 
-        private BitSet successor() {
+        private S successor() {
             // handle empty set
             if (containsEmptySet && !returnedEmptySet) {
                 returnedEmptySet = true;
-                return new BitSet();
+                return build.apply(root);
             }
             // traverse the trie
             while (!stack.isEmpty()) {
@@ -305,14 +350,7 @@ public class BitSetTrie {
                         noChildren = false;
                     }
                 }
-                if (v.marked && noChildren) { // construct found bitset
-                    BitSet nextSet = new BitSet();
-                    while (v.label >= 0) {
-                        nextSet.set(v.label);
-                        v = v.parent;
-                    }
-                    return nextSet;
-                }
+                if (v.marked && noChildren) return build.apply(v); // construct found set
             }
             // trie search done
             return null;
@@ -324,8 +362,8 @@ public class BitSetTrie {
         }
 
         @Override
-        public BitSet next() {
-            BitSet tmp = next;
+        public S next() {
+            S tmp = next;
             next = successor();
             return tmp;
         }
@@ -340,12 +378,16 @@ public class BitSetTrie {
      * @return An iterator over supersets.
      */
     public Iterable<BitSet> getSuperSets(BitSet s) {
-        return new Iterable<BitSet>() {
-            @Override
-            public Iterator<BitSet> iterator() {
-                return new SuperSetIterator(s);
-            }
-        };
+        return () -> new SuperSetIterator<>(query(s), BitSetTrie::toBitSet);
+    }
+
+    /**
+     * Same as @see getSuperSets(BitSet) for VertexSets, the returned sets have the universe of s.
+     * @param s The set we query.
+     * @return An iterator over the stored sets as VertexSets.
+     */
+    public Iterable<VertexSet> getSuperSets(VertexSet s) {
+        return () -> new SuperSetIterator<>(query(s), v -> toVertexSet(v, s.capacity()));
     }
 
     /**
@@ -358,26 +400,28 @@ public class BitSetTrie {
      * in the trie. However, if \(s\) becomes larger this method becomes more efficient. Note that |T| can be exponential
      * in the universe size.
      */
-    class SuperSetIterator implements Iterator<BitSet> {
+    class SuperSetIterator<S> implements Iterator<S> {
 
         private Stack<Node> stack;
-        private BitSet s;
-        private BitSet next;
+        private Query s;
+        private Function<Node, S> build;
+        private S next;
         private boolean returnedEmptySet;
 
-        public SuperSetIterator(BitSet s) {
+        public SuperSetIterator(Query s, Function<Node, S> build) {
             this.s = s;
+            this.build = build;
             this.stack = new Stack<>();
             this.stack.push(root);
             this.returnedEmptySet = false;
             this.next = successor();
         }
 
-        private BitSet successor() {
+        private S successor() {
             // handle empty set
-            if (containsEmptySet && !returnedEmptySet && s.cardinality() == 0) {
+            if (containsEmptySet && !returnedEmptySet && s.isEmpty()) {
                 returnedEmptySet = true;
-                return new BitSet();
+                return build.apply(root);
             }
             // find next marked node
             while (!stack.isEmpty()) {
@@ -389,14 +433,7 @@ public class BitSetTrie {
                     i--;
                 } while (i > v.label);
                 // if v is marked and we have reached every bit in s
-                if (v.marked && s.nextSetBit(v.label+1) == -1) {
-                    BitSet nextSet = new BitSet();
-                    while (v.label >= 0) { // constructed the stored set
-                        nextSet.set(v.label);
-                        v = v.parent;
-                    }
-                    return nextSet;
-                }
+                if (v.marked && s.nextSetBit(v.label+1) == -1) return build.apply(v);
             }
             // trie search done
             return null;
@@ -408,13 +445,61 @@ public class BitSetTrie {
         }
 
         @Override
-        public BitSet next() {
-            BitSet tmp = next;
+        public S next() {
+            S tmp = next;
             next = successor();
             return tmp;
         }
     }
 
+    //MARK: queries
+
+    /**
+     * Read access to the elements of a queried set, such that the trie can be used with BitSets and VertexSets.
+     */
+    private interface Query {
+        int nextSetBit(int from);
+        int previousSetBit(int from);
+        int length();
+        boolean isEmpty();
+    }
+
+    private static Query query(BitSet s) {
+        return new Query() {
+            public int nextSetBit(int from) { return s.nextSetBit(from); }
+            public int previousSetBit(int from) { return s.previousSetBit(from); }
+            public int length() { return s.length(); }
+            public boolean isEmpty() { return s.isEmpty(); }
+        };
+    }
+
+    private static Query query(VertexSet s) {
+        return new Query() {
+            public int nextSetBit(int from) { return s.nextSetBit(from); }
+            public int previousSetBit(int from) { return s.previousSetBit(from); }
+            public int length() { return s.length(); }
+            public boolean isEmpty() { return s.isEmpty(); }
+        };
+    }
+
+    /**
+     * The set stored at the given node as BitSet, i.e., the labels on the path to the root.
+     */
+    private static BitSet toBitSet(Node v) {
+        BitSet set = new BitSet();
+        for (; v.label >= 0; v = v.parent) set.set(v.label);
+        return set;
+    }
+
+    /**
+     * The set stored at the given node as VertexSet over a universe of size n.
+     */
+    private static VertexSet toVertexSet(Node v, int n) {
+        VertexSet set = new VertexSet(n);
+        for (; v.label >= 0; v = v.parent) set.set(v.label);
+        return set;
+    }
+
     //MARK: internal node class
 
     /**
@@ -422,7 +507,7 @@ public class BitSetTrie {
      * consisting of all labels on the unique path from the node to the root is stored in the trie.
      * The node also stores adjacency information to its children and to its unique parent.
      */
-    private class Node {
+    private static class Node {
         Node parent;
         Map<Integer, Node> children;
         int label; // label with wish the node is labeled
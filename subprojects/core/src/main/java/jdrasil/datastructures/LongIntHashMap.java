@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.datastructures;
+
+/**
+ * An open addressing hash map from long keys to int values with linear probing, which stores keys and values in two
+ * plain arrays (12 bytes per slot, the table is at most half full). The key 0 marks empty slots and can not be stored.
+ *
+ * Besides the usual put, the map supports @see putMin(long, int), which keeps the minimum of the stored and the given
+ * value, as needed by dynamic programs. The slots can be iterated with @see capacity(), @see keyAt(int), and
+ * @see valueAt(int). The map is not thread-safe.
+ *
+ * @author Max Bannach
+ */
+public class LongIntHashMap {
+
+    /** The keys of the slots, 0 for empty slots. */
+    private long[] keys;
+
+    /** The values of the slots. */
+    private int[] values;
+
+    /** The number of stored keys. */
+    private int size;
+
+    /**
+     * Creates an empty map.
+     */
+    public LongIntHashMap() {
+        keys = new long[16];
+        values = new int[16];
+    }
+
+    /**
+     * The number of stored keys.
+     * @return the size of the map
+     */
+    public int size() {
+        return size;
+    }
+
+    /**
+     * Get the value stored for a key.
+     * @param key the key
+     * @param defaultValue the value returned if the key is not stored
+     * @return the value of the key, or defaultValue
+     */
+    public int get(long key, int defaultValue) {
+        int i = slot(key);
+        return keys[i] == key && key != 0 ? values[i] : defaultValue;
+    }
+
+    /**
+     * Check if a key is stored.
+     * @param key the key
+     * @return true if there is a value for key
+     */
+    public boolean containsKey(long key) {
+        return key != 0 && keys[slot(key)] == key;
+    }
+
+    /**
+     * Store a value for a key, an old value is overwritten.
+     * @param key the key, not 0
+     * @param value the value
+     */
+    public void put(long key, int value) {
+        int i = insert(key);
+        values[i] = value;
+    }
+
+    /**
+     * Store a value for a key if there is no value for the key yet, or if the stored value is larger.
+     * @param key the key, not 0
+     * @param value the value
+     */
+    public void putMin(long key, int value) {
+        int i = slot(key);
+        if (keys[i] == key && key != 0) {
+            if (value < values[i]) values[i] = value;
+            return;
+        }
+        i = insert(key);
+        values[i] = value;
+    }
+
+    /**
+     * The number of slots of the map, which are indexed by \(0,\dots,capacity()-1\).
+     * @return the number of slots
+     */
+    public int capacity() {
+        return keys.length;
+    }
+
+    /**
+     * The key stored in a slot.
+     * @param slot a slot
+     * @return the key, or 0 if the slot is empty
+     */
+    public long keyAt(int slot) {
+        return keys[slot];
+    }
+
+    /**
+     * The value stored in a slot.
+     * @param slot a non empty slot
+     * @return the value
+     */
+    public int valueAt(int slot) {
+        return values[slot];
+    }
+
+    /**
+     * An estimation of the heap space used by the map.
+     * @return the size in bytes
+     */
+    public long sizeInBytes() {
+        return 12L * keys.length;
+    }
+
+    /**
+     * A bit mixer for long keys (the finalizer of MurmurHash3). The lower bits are used as index into the table, the
+     * higher bits may be used by the caller to partition keys.
+     * @param key the key
+     * @return the mixed key
+     */
+    public static long mix(long key) {
+        key ^= key >>> 33;
+        key *= 0xff51afd7ed558ccdL;
+        key ^= key >>> 33;
+        key *= 0xc4ceb9fe1a85ec53L;
+        key ^= key >>> 33;
+        return key;
+    }
+
+    /**
+     * Find the slot of the key, or the empty slot that ends its probe sequence.
+     */
+    private int slot(long key) {
+        int mask = keys.length - 1;
+        int i = (int) mix(key) & mask;
+        while (keys[i] != 0 && keys[i] != key) i = (i + 1) & mask;
+        return i;
+    }
+
+    /**
+     * Find or create the slot of the key, the table is grown if necessary.
+     */
+    private int insert(long key) {
+        if (key == 0) throw new IllegalArgumentException("the key 0 can not be stored");
+        int i = slot(key);
+        if (keys[i] == key) return i;
+        if (2 * (size + 1) > keys.length) {
+            grow();
+            i = slot(key);
+        }
+        keys[i] = key;
+        size++;
+        return i;
+    }
+
+    /**
+     * Double the number of slots.
+     */
+    private void grow() {
+        long[] oldKeys = keys;
+        int[] oldValues = values;
+        keys = new long[2 * oldKeys.length];
+        values = new int[2 * oldKeys.length];
+        int mask = keys.length - 1;
+        for (int j = 0; j < oldKeys.length; j++) {
+            if (oldKeys[j] == 0) continue;
+            int i = (int) mix(oldKeys[j]) & mask;
+            while (keys[i] != 0) i = (i + 1) & mask;
+            keys[i] = oldKeys[j];
+            values[i] = oldValues[j];
+        }
+    }
+}
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.datastructures;
+
+import java.util.Arrays;
+import java.util.BitSet;
+
+/**
+ * A VertexSet is a subset of the universe \(\{0,\dots,n-1\}\) stored as fixed-width array of 64 bit words.
+ *
+ * In contrast to java.util.BitSet, the width of a VertexSet is fixed when it is created. Hence, all set operations are
+ * plain loops over the words without any resizing or size checks. Furthermore, operations like or, and, or andNot
+ * work in place and return the set itself, so that a scratch set can be reused for intermediate results instead of
+ * cloning sets, e.g., \(N(C)\) can be computed with border.assign(C).or(...) into a buffer border.
+ *
+ * VertexSets are mutable and implement equals() and hashCode() based on their elements, so they can be used as keys
+ * in hash maps as long as they are not modified afterwards. Sets that are compared or combined have to be over the
+ * same universe.
+ *
+ * @author Max Bannach
+ */
+public final class VertexSet {
+
+    /** The size of the universe. */
+    private final int n;
+
+    /** The words storing the elements, element v is stored in bit v%64 of words[v/64]. */
+    private final long[] words;
+
+    /**
+     * Creates an empty set over the universe \(\{0,\dots,n-1\}\).
+     * @param n the size of the universe
+     */
+    public VertexSet(int n) {
+        this.n = n;
+        this.words = new long[(n + 63) >>> 6];
+    }
+
+    /**
+     * Creates a copy of the given set.
+     * @param other the set to be copied
+     */
+    public VertexSet(VertexSet other) {
+        this.n = other.n;
+        this.words = other.words.clone();
+    }
+
+    /**
+     * Creates a VertexSet with the elements of the given BitSet.
+     * @param set the elements, which have to be smaller than n
+     * @param n the size of the universe
+     * @return the set
+     */
+    public static VertexSet valueOf(BitSet set, int n) {
+        VertexSet result = new VertexSet(n);
+        for (int v = set.nextSetBit(0); v >= 0; v = set.nextSetBit(v+1)) result.set(v);
+        return result;
+    }
+
+    /**
+     * Creates a BitSet with the elements of this set.
+     * @return the set as BitSet
+     */
+    public BitSet toBitSet() {
+        return BitSet.valueOf(words);
+    }
+
+    /**
+     * The size of the universe of this set.
+     * @return n
+     */
+    public int capacity() {
+        return n;
+    }
+
+    /**
+     * An estimation of the heap space used by this set, i.e., the object, the word array, and their headers.
+     * @return the size in bytes
+     */
+    public long sizeInBytes() {
+        return 24 + 16 + 8L * words.length;
+    }
+
+    /**
+     * Copy the words of this set to array[offset..], used to pack sets into a VertexSetStore.
+     */
+    void writeWords(long[] array, int offset) {
+        System.arraycopy(words, 0, array, offset, words.length);
+    }
+
+    /**
+     * Overwrite this set with the words stored in array[offset..].
+     */
+    void readWords(long[] array, int offset) {
+        System.arraycopy(array, offset, words, 0, words.length);
+    }
+
+    /**
+     * Check if this set equals the set whose words are stored in array[offset..].
+     */
+    boolean equalsWords(long[] array, int offset) {
+        for (int i = 0; i < words.length; i++) {
+            if (words[i] != array[offset + i]) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Check if v is in the set.
+     * @param v an element of the universe
+     * @return true if v is in the set
+     */
+    public boolean get(int v) {
+        return (words[v >>> 6] & (1L << v)) != 0;
+    }
+
+    /**
+     * Add v to the set.
+     * @param v an element of the universe
+     */
+    public void set(int v) {
+        words[v >>> 6] |= 1L << v;
+    }
+
+    /**
+     * Remove v from the set.
+     * @param v an element of the universe
+     */
+    public void clear(int v) {
+        words[v >>> 6] &= ~(1L << v);
+    }
+
+    /**
+     * Remove all elements from the set.
+     * @return this set
+     */
+    public VertexSet clear() {
+        Arrays.fill(words, 0L);
+        return this;
+    }
+
+    /**
+     * Add all elements of the universe to the set.
+     * @return this set
+     */
+    public VertexSet setAll() {
+        Arrays.fill(words, -1L);
+        trim();
+        return this;
+    }
+
+    /**
+     * Overwrite this set with the elements of the given set.
+     * @param other a set over the same universe
+     * @return this set
+     */
+    public VertexSet assign(VertexSet other) {
+        System.arraycopy(other.words, 0, words, 0, words.length);
+        return this;
+    }
+
+    /**
+     * Add the elements of the given set to this set.
+     * @param other a set over the same universe
+     * @return this set
+     */
+    public VertexSet or(VertexSet other) {
+        long[] o = other.words;
+        for (int i = 0; i < words.length; i++) words[i] |= o[i];
+        return this;
+    }
+
+    /**
+     * Remove all elements that are not in the given set.
+     * @param other a set over the same universe
+     * @return this set
+     */
+    public VertexSet and(VertexSet other) {
+        long[] o = other.words;
+        for (int i = 0; i < words.length; i++) words[i] &= o[i];
+        return this;
+    }
+
+    /**
+     * Remove the elements of the given set.
+     * @param other a set over the same universe
+     * @return this set
+     */
+    public VertexSet andNot(VertexSet other) {
+        long[] o = other.words;
+        for (int i = 0; i < words.length; i++) words[i] &= ~o[i];
+        return this;
+    }
+
+    /**
+     * Replace this set by its complement with respect to the universe.
+     * @return this set
+     */
+    public VertexSet complement() {
+        for (int i = 0; i < words.length; i++) words[i] = ~words[i];
+        trim();
+        return this;
+    }
+
+    /**
+     * Check if this set and the given set share an element.
+     * @param other a set over the same universe
+     * @return true if the intersection is not empty
+     */
+    public boolean intersects(VertexSet other) {
+        long[] o = other.words;
+        for (int i = 0; i < words.length; i++) {
+            if ((words[i] & o[i]) != 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Check if every element of this set is in the given set.
+     * @param other a set over the same universe
+     * @return true if this set is a subset of other
+     */
+    public boolean isSubsetOf(VertexSet other) {
+        long[] o = other.words;
+        for (int i = 0; i < words.length; i++) {
+            if ((words[i] & ~o[i]) != 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Check if the set is empty.
+     * @return true if the set has no elements
+     */
+    public boolean isEmpty() {
+        for (long word : words) {
+            if (word != 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * The number of elements in the set.
+     * @return \(|S|\)
+     */
+    public int cardinality() {
+        int size = 0;
+        for (long word : words) size += Long.bitCount(word);
+        return size;
+    }
+
+    /**
+     * The smallest element that is at least from.
+     * @param from the first element to consider
+     * @return the next element or -1 if there is none
+     */
+    public int nextSetBit(int from) {
+        if (from >= n) return -1;
+        int i = from >>> 6;
+        long word = words[i] & (-1L << from);
+        while (true) {
+            if (word != 0) return (i << 6) + Long.numberOfTrailingZeros(word);
+            if (++i == words.length) return -1;
+            word = words[i];
+        }
+    }
+
+    /**
+     * The smallest element that is at least from and that is not in the given set, i.e., the next element of
+     * \(S\setminus X\), computed without materializing the difference.
+     * @param other the set X over the same universe
+     * @param from the first element to consider
+     * @return the next element or -1 if there is none
+     */
+    public int nextSetBitNotIn(VertexSet other, int from) {
+        if (from >= n) return -1;
+        long[] o = other.words;
+        int i = from >>> 6;
+        long word = words[i] & ~o[i] & (-1L << from);
+        while (true) {
+            if (word != 0) return (i << 6) + Long.numberOfTrailingZeros(word);
+            if (++i == words.length) return -1;
+            word = words[i] & ~o[i];
+        }
+    }
+
+    /**
+     * The smallest element of the universe that is at least from and that is not in the set.
+     * @param from the first element to consider
+     * @return the next non-element or n if there is none
+     */
+    public int nextClearBit(int from) {
+        if (from >= n) return n;
+        int i = from >>> 6;
+        long word = ~words[i] & (-1L << from);
+        while (true) {
+            if (word != 0) return Math.min(n, (i << 6) + Long.numberOfTrailingZeros(word));
+            if (++i == words.length) return n;
+            word = ~words[i];
+        }
+    }
+
+    /**
+     * The largest element that is at most from.
+     * @param from the first element to consider
+     * @return the previous element or -1 if there is none
+     */
+    public int previousSetBit(int from) {
+        if (from < 0) return -1;
+        if (from >= n) from = n - 1;
+        if (from < 0) return -1;
+        int i = from >>> 6;
+        long word = words[i] & (-1L >>> -(from + 1));
+        while (true) {
+            if (word != 0) return ((i + 1) << 6) - 1 - Long.numberOfLeadingZeros(word);
+            if (i-- == 0) return -1;
+            word = words[i];
+        }
+    }
+
+    /**
+     * The largest element of the set plus one.
+     * @return the length of the set, or 0 if it is empty
+     */
+    public int length() {
+        return previousSetBit(n - 1) + 1;
+    }
+
+    /**
+     * Clear the unused bits of the last word.
+     */
+    private void trim() {
+        if ((n & 63) != 0) words[words.length - 1] &= -1L >>> (64 - (n & 63));
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) return true;
+        if (!(o instanceof VertexSet)) return false;
+        return Arrays.equals(words, ((VertexSet) o).words);
+    }
+
+    @Override
+    public int hashCode() {
+        return Arrays.hashCode(words);
+    }
+
+    @Override
+    public String toString() {
+        StringBuilder sb = new StringBuilder("{");
+        for (int v = nextSetBit(0); v >= 0; v = nextSetBit(v+1)) {
+            if (sb.length() > 1) sb.append(", ");
+            sb.append(v);
+        }
+        return sb.append("}").toString();
+    }
+}
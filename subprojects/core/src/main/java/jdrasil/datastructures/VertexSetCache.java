@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.datastructures;
+
+import java.util.Arrays;
+import java.util.function.LongSupplier;
+import java.util.function.ToLongBiFunction;
+
+/**
+ * A memory bounded cache that maps VertexSets to values, used to memorize results of set computations on graphs.
+ *
+ * Every entry has a weight (an estimation of its size in bytes) given by a weigher function, and the total weight of
+ * the cache never exceeds a budget. If a new entry does not fit, entries are evicted with the CLOCK policy:
+ * every entry has a reference bit that is set on a hit, and a clock hand sweeps over the table, clears set bits, and
+ * evicts the first entry whose bit is not set. So recently used entries survive a sweep, while the bookkeeping on a
+ * hit is a single store.
+ *
+ * The cache is an open addressing hash table with linear probing. The hash of every key is stored next to it, so
+ * probing compares ints and the words of a key are only compared on a hash match. Deleted entries are removed with
+ * backward shifting, so there are no tombstones.
+ *
+ * The budget may change over time, for instance if it is a share of a @see jdrasil.utilities.MemoryBudget. It is read
+ * on every insertion, so a cache whose budget shrinks evicts entries on its next insertion.
+ *
+ * Hits, misses, and evictions are counted to tune the budget. The cache is not thread-safe.
+ *
+ * @param <V> the type of the cached values
+ * @author Max Bannach
+ */
+public class VertexSetCache<V> {
+
+    /** Fixed cost of an entry in bytes, i.e., the slots in the arrays of the table. */
+    private static final long ENTRY_OVERHEAD = 32;
+
+    /** The budget in bytes. */
+    private final LongSupplier budget;
+
+    /** Estimates the size of an entry in bytes (without ENTRY_OVERHEAD). */
+    private final ToLongBiFunction<VertexSet, V> weigher;
+
+    /* The table, a slot i is empty if keys[i] is null. */
+    private VertexSet[] keys;
+    private Object[] values;
+    private int[] hashes;
+    private long[] weights;
+    private boolean[] referenced;
+
+    /** Number of stored entries. */
+    private int size;
+
+    /** Total weight of the stored entries. */
+    private long weight;
+
+    /** Position of the clock hand. */
+    private int hand;
+
+    /* Statistics */
+    private long hits, misses, evictions;
+
+    /**
+     * Creates an empty cache.
+     * @param budget the maximal total weight of the cache in bytes
+     * @param weigher a function that estimates the size of an entry in bytes
+     */
+    public VertexSetCache(long budget, ToLongBiFunction<VertexSet, V> weigher) {
+        this(() -> budget, weigher);
+    }
+
+    /**
+     * Creates an empty cache with a budget that may change over time.
+     * @param budget supplies the maximal total weight of the cache in bytes
+     * @param weigher a function that estimates the size of an entry in bytes
+     */
+    public VertexSetCache(LongSupplier budget, ToLongBiFunction<VertexSet, V> weigher) {
+        this.budget = budget;
+        this.weigher = weigher;
+        allocate(16);
+    }
+
+    /**
+     * Get the value stored for the given key and mark the entry as recently used.
+     * @param key the key, which may be a scratch set
+     * @return the cached value or null if the key is not cached
+     */
+    @SuppressWarnings("unchecked")
+    public V get(VertexSet key) {
+        int hash = hash(key);
+        for (int i = hash & (keys.length - 1); keys[i] != null; i = (i + 1) & (keys.length - 1)) {
+            if (hashes[i] == hash && keys[i].equals(key)) {
+                hits++;
+                referenced[i] = true;
+                return (V) values[i];
+            }
+        }
+        misses++;
+        return null;
+    }
+
+    /**
+     * Store a value for the given key, evicting other entries if the budget is exceeded. Entries that are larger than
+     * the whole budget are not stored.
+     * @param key the key, which is stored and must not be modified afterwards
+     * @param value the value
+     */
+    public void put(VertexSet key, V value) {
+        long budget = this.budget.getAsLong();
+        long w = weigher.applyAsLong(key, value) + ENTRY_OVERHEAD;
+        if (w > budget) return;
+        int hash = hash(key);
+        int i = find(key, hash);
+        if (keys[i] != null) removeSlot(i); // replace an existing entry
+        while (weight + w > budget) evict();
+        if (2 * (size + 1) > keys.length) resize(2 * keys.length);
+
+        // insert into the first free slot of the probe sequence
+        for (i = hash & (keys.length - 1); keys[i] != null; i = (i + 1) & (keys.length - 1));
+        keys[i] = key;
+        values[i] = value;
+        hashes[i] = hash;
+        weights[i] = w;
+        referenced[i] = false;
+        size++;
+        weight += w;
+    }
+
+    /**
+     * Removes all entries from the cache, the statistics are kept.
+     */
+    public void clear() {
+        allocate(16);
+    }
+
+    /**
+     * The number of stored entries.
+     * @return the size of the cache
+     */
+    public int size() {
+        return size;
+    }
+
+    /**
+     * The total weight of the stored entries.
+     * @return the estimated size in bytes
+     */
+    public long getWeight() {
+        return weight;
+    }
+
+    /**
+     * The budget of the cache.
+     * @return the maximal weight in bytes
+     */
+    public long getBudget() {
+        return budget.getAsLong();
+    }
+
+    /**
+     * The number of calls of get() that found a value.
+     * @return the number of hits
+     */
+    public long getHits() {
+        return hits;
+    }
+
+    /**
+     * The number of calls of get() that did not find a value.
+     * @return the number of misses
+     */
+    public long getMisses() {
+        return misses;
+    }
+
+    /**
+     * The number of entries that were evicted to respect the budget.
+     * @return the number of evictions
+     */
+    public long getEvictions() {
+        return evictions;
+    }
+
+    @Override
+    public String toString() {
+        long requests = hits + misses;
+        return String.format("%d entries, %.1f of %.1f MB, %d hits, %d misses (%.1f%% hit rate), %d evictions",
+                size, weight / 1048576.0, budget.getAsLong() / 1048576.0, hits, misses,
+                requests == 0 ? 0.0 : 100.0 * hits / requests, evictions);
+    }
+
+    /**
+     * Spread the hash of a key over the bits of an int, such that the lower bits can be used as index.
+     */
+    private static int hash(VertexSet key) {
+        int h = key.hashCode() * 0x9E3779B9;
+        return h ^ (h >>> 16);
+    }
+
+    /**
+     * Find the slot of the given key, or the empty slot that ends its probe sequence.
+     */
+    private int find(VertexSet key, int hash) {
+        int i = hash & (keys.length - 1);
+        while (keys[i] != null && !(hashes[i] == hash && keys[i].equals(key))) i = (i + 1) & (keys.length - 1);
+        return i;
+    }
+
+    /**
+     * Advance the clock hand to the first entry that was not referenced since the last sweep and evict it.
+     */
+    private void evict() {
+        while (true) {
+            if (keys[hand] != null) {
+                if (!referenced[hand]) {
+                    removeSlot(hand);
+                    evictions++;
+                    return;
+                }
+                referenced[hand] = false;
+            }
+            hand = (hand + 1) & (keys.length - 1);
+        }
+    }
+
+    /**
+     * Remove the entry in slot i and shift later entries of its cluster back, such that all keys stay reachable
+     * from their home slot.
+     */
+    private void removeSlot(int i) {
+        int mask = keys.length - 1;
+        size--;
+        weight -= weights[i];
+        int j = i;
+        while (true) {
+            keys[i] = null;
+            values[i] = null;
+            j = (j + 1) & mask;
+            while (true) {
+                if (keys[j] == null) return;
+                int home = hashes[j] & mask;
+                if (((j - home) & mask) >= ((j - i) & mask)) break; // slot i lies on the probe sequence of key j
+                j = (j + 1) & mask;
+            }
+            keys[i] = keys[j];
+            values[i] = values[j];
+            hashes[i] = hashes[j];
+            weights[i] = weights[j];
+            referenced[i] = referenced[j];
+            i = j;
+        }
+    }
+
+    /**
+     * Create an empty table with the given number of slots (a power of two).
+     */
+    private void allocate(int capacity) {
+        keys = new VertexSet[capacity];
+        values = new Object[capacity];
+        hashes = new int[capacity];
+        weights = new long[capacity];
+        referenced = new boolean[capacity];
+        size = 0;
+        weight = 0;
+        hand = 0;
+    }
+
+    /**
+     * Move all entries into a table with the given number of slots.
+     */
+    private void resize(int capacity) {
+        VertexSet[] oldKeys = keys;
+        Object[] oldValues = values;
+        int[] oldHashes = hashes;
+        long[] oldWeights = weights;
+        boolean[] oldReferenced = referenced;
+        long oldWeight = weight;
+        int oldSize = size;
+        allocate(capacity);
+        for (int j = 0; j < oldKeys.length; j++) {
+            if (oldKeys[j] == null) continue;
+            int i = oldHashes[j] & (capacity - 1);
+            while (keys[i] != null) i = (i + 1) & (capacity - 1);
+            keys[i] = oldKeys[j];
+            values[i] = oldValues[j];
+            hashes[i] = oldHashes[j];
+            weights[i] = oldWeights[j];
+            referenced[i] = oldReferenced[j];
+        }
+        size = oldSize;
+        weight = oldWeight;
+    }
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.datastructures;
+
+import jdrasil.utilities.Checkpoint;
+
+import java.io.DataInput;
+import java.io.DataOutput;
+import java.io.IOException;
+import java.util.Arrays;
+
+/**
+ * A VertexSetStore is a set of VertexSets over the universe \(\{0,\dots,n-1\}\) that stores the words of all sets in a
+ * single long array. Every stored set has a stable integer handle, which is its position in this array: the handles are
+ * \(0,\dots,size()-1\) in the order in which the sets were added, and they stay valid until the store is cleared.
+ *
+ * Lookups use an open addressing hash table of handles with linear probing, the hash of every set is stored next to
+ * it. Hence, a stored set costs its words plus about 12 bytes, instead of the VertexSet, its word array, and a hash
+ * map entry. Sets can not be removed individually.
+ *
+ * Handles can be used as index into plain arrays, which allows compact maps from stored sets to other data.
+ *
+ * @author Max Bannach
+ */
+public class VertexSetStore {
+
+    /** The size of the universe. */
+    private final int n;
+
+    /** The number of words per set. */
+    private final int width;
+
+    /** The words of set h are stored in data[h*width..(h+1)*width-1]. */
+    private long[] data;
+
+    /** The hash of every stored set. */
+    private int[] hashes;
+
+    /** The hash table, a slot stores handle+1, or 0 if it is empty. */
+    private int[] table;
+
+    /** The number of stored sets. */
+    private int size;
+
+    /**
+     * Creates an empty store for sets over the universe \(\{0,\dots,n-1\}\).
+     * @param n the size of the universe
+     */
+    public VertexSetStore(int n) {
+        this.n = n;
+        this.width = (n + 63) >>> 6;
+        clear();
+    }
+
+    /**
+     * Removes all sets from the store and releases the memory, all handles become invalid.
+     */
+    public void clear() {
+        data = new long[16 * width];
+        hashes = new int[16];
+        table = new int[32];
+        size = 0;
+    }
+
+    /**
+     * The number of stored sets.
+     * @return the size of the store
+     */
+    public int size() {
+        return size;
+    }
+
+    /**
+     * The size of the universe of the stored sets.
+     * @return n
+     */
+    public int capacity() {
+        return n;
+    }
+
+    /**
+     * Adds a set to the store if it is not already stored. The set is copied.
+     * @param s the set
+     * @return the handle of s
+     */
+    public int add(VertexSet s) {
+        int hash = hash(s);
+        int i = slot(s, hash);
+        if (table[i] != 0) return table[i] - 1;
+
+        // grow the data and the table if necessary
+        if (size == hashes.length) {
+            hashes = Arrays.copyOf(hashes, 2 * size);
+            data = Arrays.copyOf(data, 2 * size * width);
+        }
+        if (2 * (size + 1) > table.length) {
+            rehash(2 * table.length);
+            i = slot(s, hash);
+        }
+
+        s.writeWords(data, size * width);
+        hashes[size] = hash;
+        table[i] = size + 1;
+        return size++;
+    }
+
+    /**
+     * Get the handle of a stored set.
+     * @param s the set
+     * @return the handle of s, or -1 if s is not stored
+     */
+    public int find(VertexSet s) {
+        return table[slot(s, hash(s))] - 1;
+    }
+
+    /**
+     * Check if a set is stored.
+     * @param s the set
+     * @return true if s is in the store
+     */
+    public boolean contains(VertexSet s) {
+        return find(s) >= 0;
+    }
+
+    /**
+     * Get the set with the given handle.
+     * @param handle a handle of this store
+     * @return a new VertexSet with the elements of the stored set
+     */
+    public VertexSet get(int handle) {
+        return get(handle, new VertexSet(n));
+    }
+
+    /**
+     * Copy the set with the given handle into the given set.
+     * @param handle a handle of this store
+     * @param result a set over the same universe, which is overwritten
+     * @return the set result
+     */
+    public VertexSet get(int handle, VertexSet result) {
+        result.readWords(data, handle * width);
+        return result;
+    }
+
+    /**
+     * The cardinality of a stored set.
+     * @param handle a handle of this store
+     * @return the number of elements of the set with the given handle
+     */
+    public int cardinality(int handle) {
+        int cardinality = 0;
+        for (int i = handle * width; i < (handle + 1) * width; i++) cardinality += Long.bitCount(data[i]);
+        return cardinality;
+    }
+
+    /**
+     * An estimation of the heap space used by the store.
+     * @return the size in bytes
+     */
+    public long sizeInBytes() {
+        return 8L * data.length + 4L * hashes.length + 4L * table.length;
+    }
+
+    /**
+     * Write the store as part of a checkpoint: the universe, the packed words, and the hashes of the sets.
+     * @param out The stream.
+     * @throws IOException
+     */
+    public void write(DataOutput out) throws IOException {
+        out.writeInt(n);
+        Checkpoint.writeInts(out, hashes, size);
+        Checkpoint.writeLongs(out, data, size * width);
+    }
+
+    /**
+     * Read a store written by @see write(DataOutput), the handles of the sets are preserved.
+     * @param in The stream.
+     * @return The store.
+     * @throws IOException
+     */
+    public static VertexSetStore read(DataInput in) throws IOException {
+        VertexSetStore store = new VertexSetStore(in.readInt());
+        int[] hashes = Checkpoint.readInts(in);
+        long[] data = Checkpoint.readLongs(in);
+        store.size = hashes.length;
+        store.hashes = Arrays.copyOf(hashes, Math.max(16, store.size));
+        store.data = Arrays.copyOf(data, Math.max(16, store.size) * store.width);
+        int slots = 32;
+        while (slots < 2 * store.size) slots *= 2;
+        store.rehash(slots);
+        return store;
+    }
+
+    /**
+     * Spread the hash of a set over the bits of an int, such that the lower bits can be used as index.
+     */
+    private static int hash(VertexSet s) {
+        int h = s.hashCode() * 0x9E3779B9;
+        return h ^ (h >>> 16);
+    }
+
+    /**
+     * Find the slot of the given set, or the empty slot that ends its probe sequence.
+     */
+    private int slot(VertexSet s, int hash) {
+        int mask = table.length - 1;
+        int i = hash & mask;
+        while (table[i] != 0) {
+            int handle = table[i] - 1;
+            if (hashes[handle] == hash && s.equalsWords(data, handle * width)) return i;
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    /**
+     * Rebuild the hash table with the given number of slots (a power of two).
+     */
+    private void rehash(int slots) {
+        table = new int[slots];
+        int mask = slots - 1;
+        for (int handle = 0; handle < size; handle++) {
+            int i = hashes[handle] & mask;
+            while (table[i] != 0) i = (i + 1) & mask;
+            table[i] = handle + 1;
+        }
+    }
+}
@@ -18,16 +18,29 @@
  */
 package jdrasil.graph;
 
+import jdrasil.datastructures.VertexSet;
+import jdrasil.datastructures.VertexSetCache;
+import jdrasil.utilities.MemoryBudget;
+
 import java.util.*;
 
 /**
- * A BitSetGraph stores a graph (with arbitrary vertices) as bitwise adjacency matrix, i.\,e., as array of BitSets where
- * the i'th BitSet corresponds to the i'th row of the adjacency matrix. This comes with all the advantages and disadvantages
+ * A BitSetGraph stores a graph (with arbitrary vertices) as bitwise adjacency matrix, i.\,e., as array of VertexSets where
+ * the i'th VertexSet corresponds to the i'th row of the adjacency matrix. This comes with all the advantages and disadvantages
  * of an adjacency matrix.
  *
  * The crucial advantage is that the graph is compact and that many operations can be performed quickly on the bit level.
- * In particular, dynamic programming over subgraphs can be implemented efficiently, as subgraphs are also just BitSets
+ * In particular, dynamic programming over subgraphs can be implemented efficiently, as subgraphs are also just VertexSets
  * that can efficiently be hashed.
+ *
+ * Intermediate results of the set operations are computed in scratch sets that are reused between calls, so the
+ * methods only allocate sets that are returned or memorized. Hence, a BitSetGraph must not be used by multiple threads
+ * at the same time, every thread should use its own copy created with @see BitSetGraph(BitSetGraph, long). Sets passed to the methods are never stored, memorized results use a copy as key.
+ *
+ * The memorization uses VertexSetCaches that share a memory budget, which is, by default, a quarter of the maximal
+ * heap size. If the budget is exhausted, old results are evicted and recomputed on demand. Several BitSetGraphs (for
+ * instance the copies of the threads) can take their budget as share of one @see jdrasil.utilities.MemoryBudget, and
+ * should then @see release() their share if they are not used anymore.
  */
 public class BitSetGraph<T extends Comparable<T>> {
 
@@ -41,37 +54,70 @@ public class BitSetGraph<T extends Comparable<T>> {
     private final Map<T, Integer> vToInt;
     private final Map<Integer, T> intToV;
 
-    /** The graph as array of BitSets (aka.\, bit adjacency matrix). */
-    private final BitSet[] bitSetGraph;
+    /** The graph as array of VertexSets (aka.\, bit adjacency matrix). */
+    private final VertexSet[] bitSetGraph;
 
     /* Data Structures for memorization */
-    private Map<BitSet, List<BitSet>> separateMemory;
-    private Map<BitSet, BitSet> exteriorBorderMemory;
-    private Map<BitSet, Boolean> pmcMemory;
+    private VertexSetCache<List<VertexSet>> separateMemory;
+    private VertexSetCache<VertexSet> exteriorBorderMemory;
+    private VertexSetCache<Boolean> pmcMemory;
+    private MemoryBudget budget;
+
+    /* Scratch sets, each is owned by the methods noted behind it and must not be used across calls of other methods. */
+    private VertexSet border;         // cardinality and subset tests of N(C), no nested calls while in use
+    private VertexSet closure;        // saturate() and absorbable()
+    private VertexSet visited;        // separate()
+    private VertexSet outboundBorder; // outbound()
+    private VertexSet outletBorder;   // outlet()
+
+    /** Stack of the DFS in separate(). */
+    private int[] stack;
 
     /**
      * Creates the BitSetGraph from the given graph by computing a bijection from the vertices to $\{0,...,n-1\}$
-     * and storing edges in an adjacency matrix represented by an array of BitSets.
+     * and storing edges in an adjacency matrix represented by an array of VertexSets.
+     * The memorization uses the default budget of a quarter of the maximal heap size.
      * @param graph The graph to be represented as BitSetGraph.
      */
     public BitSetGraph(Graph<T> graph) {
+        this(graph, Runtime.getRuntime().maxMemory() / 4);
+    }
+
+    /**
+     * Creates the BitSetGraph from the given graph, see @see BitSetGraph(Graph). The memorized results of
+     * separate(), exteriorBorder(), and isPotentialMaximalClique() will use at most (approximately) the given number of
+     * bytes. Half of the budget is used for separate(), and a quarter for each of the other methods.
+     * @param graph The graph to be represented as BitSetGraph.
+     * @param cacheBytes The memory budget for memorization in bytes.
+     */
+    public BitSetGraph(Graph<T> graph, long cacheBytes) {
+        this(graph, new MemoryBudget(cacheBytes));
+    }
+
+    /**
+     * Creates the BitSetGraph from the given graph, see @see BitSetGraph(Graph), with memorization that uses a share
+     * of the given budget. The share is held until @see release() is called.
+     * @param graph The graph to be represented as BitSetGraph.
+     * @param budget The memory budget for memorization, which may be shared with other BitSetGraphs.
+     */
+    public BitSetGraph(Graph<T> graph, MemoryBudget budget) {
         // parse given graph
         this.graph = graph;
         this.n = graph.getCopyOfVertices().size();
 
-        // compute the bijection
+        // compute the bijection along the ascending order of the vertices
         this.vToInt = new HashMap<>();
         this.intToV = new HashMap<>();
         int i = 0;
-        for (T v : graph) {
+        for (T v : graph.getSortedVertices()) {
             vToInt.put(v, i);
             intToV.put(i, v);
             i++;
         }
 
         // create the bitgraph
-        bitSetGraph = new BitSet[n];
-        for (int v = 0; v < n; v++) bitSetGraph[v] = new BitSet();
+        bitSetGraph = new VertexSet[n];
+        for (int v = 0; v < n; v++) bitSetGraph[v] = new VertexSet(n);
         for (T v : graph) {
             int x = vToInt.get(v);
             for (T w : graph.getNeighborhood(v)) {
@@ -80,10 +126,71 @@ public class BitSetGraph<T extends Comparable<T>> {
             }
         }
 
-        // initialize memorization
-        separateMemory = new HashMap<>();
-        exteriorBorderMemory = new HashMap<>();
-        pmcMemory = new HashMap<>();
+        initializeWorkspace(budget);
+    }
+
+    /**
+     * Creates a BitSetGraph that shares the graph, the bijection, and the (immutable) adjacency matrix with the given
+     * BitSetGraph, but has its own scratch sets and memorization. This is cheap and allows multiple threads to work on
+     * the same graph, each with its own copy.
+     * @param other The BitSetGraph to be copied.
+     * @param cacheBytes The memory budget for memorization in bytes.
+     */
+    public BitSetGraph(BitSetGraph<T> other, long cacheBytes) {
+        this(other, new MemoryBudget(cacheBytes));
+    }
+
+    /**
+     * Creates a copy of the given BitSetGraph, see @see BitSetGraph(BitSetGraph, long), with memorization that uses a
+     * share of the given budget. The share is held until @see release() is called.
+     * @param other The BitSetGraph to be copied.
+     * @param budget The memory budget for memorization, which may be shared with other BitSetGraphs.
+     */
+    public BitSetGraph(BitSetGraph<T> other, MemoryBudget budget) {
+        this.graph = other.graph;
+        this.n = other.n;
+        this.vToInt = other.vToInt;
+        this.intToV = other.intToV;
+        this.bitSetGraph = other.bitSetGraph;
+        initializeWorkspace(budget);
+    }
+
+    /**
+     * Creates the data structures for memorization and the scratch sets.
+     * @param budget The memory budget for memorization, of which this graph takes a share.
+     */
+    private void initializeWorkspace(MemoryBudget budget) {
+        // initialize memorization, the caches read the current share of the budget on every insertion
+        this.budget = budget;
+        budget.acquire();
+        separateMemory = new VertexSetCache<>(() -> budget.getShare() / 2, (S, components) -> {
+            long size = S.sizeInBytes() + 40 + 8L * components.size();
+            for (VertexSet C : components) size += C.sizeInBytes();
+            return size;
+        });
+        exteriorBorderMemory = new VertexSetCache<>(() -> budget.getShare() / 4, (C, NC) -> C.sizeInBytes() + NC.sizeInBytes());
+        pmcMemory = new VertexSetCache<>(() -> budget.getShare() / 4, (K, isPMC) -> K.sizeInBytes());
+
+        // initialize scratch space
+        border = new VertexSet(n);
+        closure = new VertexSet(n);
+        visited = new VertexSet(n);
+        outboundBorder = new VertexSet(n);
+        outletBorder = new VertexSet(n);
+        stack = new int[n];
+    }
+
+    /**
+     * Clears the memorization and returns the share of the memory budget, such that other BitSetGraphs with the same
+     * budget can use it. The graph can still be used, but does not memorize results anymore. Further calls do nothing.
+     */
+    public void release() {
+        if (budget == null) return;
+        budget.release();
+        budget = null;
+        separateMemory = new VertexSetCache<>(0, (S, components) -> 0);
+        exteriorBorderMemory = new VertexSetCache<>(0, (C, NC) -> 0);
+        pmcMemory = new VertexSetCache<>(0, (K, isPMC) -> 0);
     }
 
     /**
@@ -103,14 +210,38 @@ public class BitSetGraph<T extends Comparable<T>> {
     }
 
     /**
-     * Getter for the BitSet graph: an array of n BitSets where the i'th BitSet corresponds to the i'th row
-     * of the adjacency matrix of the graph.
-     * @return The adjacency matrix of $G$ as Array of BitSets.
+     * Getter for the BitSet graph: an array of n VertexSets where the i'th VertexSet corresponds to the i'th row
+     * of the adjacency matrix of the graph. The rows must not be modified.
+     * @return The adjacency matrix of $G$ as Array of VertexSets.
      */
-    public BitSet[] getBitSetGraph() {
+    public VertexSet[] getBitSetGraph() {
         return this.bitSetGraph;
     }
 
+    /**
+     * The cache used to memorize results of separate(), e.g., to inspect its hit rate.
+     * @return The cache of separate().
+     */
+    public VertexSetCache<List<VertexSet>> getSeparateCache() {
+        return this.separateMemory;
+    }
+
+    /**
+     * The cache used to memorize results of exteriorBorder().
+     * @return The cache of exteriorBorder().
+     */
+    public VertexSetCache<VertexSet> getExteriorBorderCache() {
+        return this.exteriorBorderMemory;
+    }
+
+    /**
+     * The cache used to memorize results of isPotentialMaximalClique().
+     * @return The cache of isPotentialMaximalClique().
+     */
+    public VertexSetCache<Boolean> getPMCCache() {
+        return this.pmcMemory;
+    }
+
     /**
      * Get the used mapping that maps the vertices to $\{0,...,n-1\}$.
      * @return A map from vertices to ids.
@@ -128,11 +259,11 @@ public class BitSetGraph<T extends Comparable<T>> {
     }
 
     /**
-     * Computes a set of ``real'' vertices to the corresponding BitSet.
-     * @param S A vertex set as BitSet.
+     * Computes a set of ``real'' vertices to the corresponding VertexSet.
+     * @param S A vertex set as VertexSet.
      * @return The corresponding set of vertex objects.
      */
-    public Set<T> getVertexSet(BitSet S) {
+    public Set<T> getVertexSet(VertexSet S) {
         Set<T> vertexSet = new HashSet<T>();
         for (int v = S.nextSetBit(0); v >= 0; v = S.nextSetBit(v+1)) {
             vertexSet.add(intToV.get(v));
@@ -141,12 +272,12 @@ public class BitSetGraph<T extends Comparable<T>> {
     }
 
     /**
-     * Computes a corresponding BitSet to a ``real'' vertex set.
+     * Computes a corresponding VertexSet to a ``real'' vertex set.
      * @param vertexSet A vertex set as set of vertex objects.
-     * @return The corresponding BitSet.
+     * @return The corresponding VertexSet.
      */
-    public BitSet getBitSet(Set<T> vertexSet) {
-        BitSet S = new BitSet();
+    public VertexSet getBitSet(Set<T> vertexSet) {
+        VertexSet S = new VertexSet(n);
         for (T v : vertexSet) S.set(vToInt.get(v));
         return S;
     }
@@ -156,14 +287,22 @@ public class BitSetGraph<T extends Comparable<T>> {
      * @param C A vertex set $C\subseteq V$.
      * @return $N(N(C))\cap C$, i.\,e., the vertices inside $C$ that have an outgoing edge.
      */
-    public BitSet interiorBorder(BitSet C) {
-        BitSet border = new BitSet();
-        BitSet outside = (BitSet) C.clone();
-        outside.flip(0,n);
+    public VertexSet interiorBorder(VertexSet C) {
+        return interiorBorder(C, new VertexSet(n));
+    }
+
+    /**
+     * Computes the interior border of $C$ into the given set.
+     * @param C A vertex set $C\subseteq V$.
+     * @param result The set in which the border is stored, its content is overwritten.
+     * @return The set result, storing $N(N(C))\cap C$.
+     */
+    public VertexSet interiorBorder(VertexSet C, VertexSet result) {
+        result.clear();
         for (int v = C.nextSetBit(0); v >= 0; v = C.nextSetBit(v+1)) {
-            if (bitSetGraph[v].intersects(outside)) border.set(v);
+            if (!bitSetGraph[v].isSubsetOf(C)) result.set(v);
         }
-        return border;
+        return result;
     }
 
     /**
@@ -171,40 +310,46 @@ public class BitSetGraph<T extends Comparable<T>> {
      * @param C A vertex set $C\subseteq V$.
      * @return $N(C)$, i.\,e., the vertices that are reachable from $C$ with a single edge.
      */
-    public BitSet computeExteriorBorder(BitSet C) {
-        BitSet border = new BitSet();
+    public VertexSet computeExteriorBorder(VertexSet C) {
+        return computeExteriorBorder(C, new VertexSet(n));
+    }
+
+    /**
+     * Computes the exterior border of $C$ into the given set.
+     * @param C A vertex set $C\subseteq V$.
+     * @param result The set in which the border is stored, its content is overwritten. It must not be $C$ itself.
+     * @return The set result, storing $N(C)$.
+     */
+    public VertexSet computeExteriorBorder(VertexSet C, VertexSet result) {
+        result.clear();
         for (int v = C.nextSetBit(0); v >= 0; v = C.nextSetBit(v+1)) {
-            border.or(bitSetGraph[v]);
+            result.or(bitSetGraph[v]);
         }
-        border.andNot(C);
-        return border;
+        return result.andNot(C);
     }
 
     /**
      * Gets the exterior border of $C$, i.e., all vertices $v$ in $G[V\setminus C]$ that have at least one neighbor in $C$.
      * @param C A vertex set $C\subseteq V$. Cashes the result for further use.
-     * @return $N(C)$, i.\,e., the vertices that are reachable from $C$ with a single edge.
+     * @return $N(C)$, i.\,e., the vertices that are reachable from $C$ with a single edge. The set must not be modified.
      */
-    public BitSet exteriorBorder(BitSet C) {
-        if (exteriorBorderMemory.containsKey(C)) return exteriorBorderMemory.get(C);
-        BitSet border = computeExteriorBorder(C);
-        exteriorBorderMemory.put(C, border);
-        return border;
-
+    public VertexSet exteriorBorder(VertexSet C) {
+        VertexSet NC = exteriorBorderMemory.get(C);
+        if (NC != null) return NC;
+        NC = computeExteriorBorder(C);
+        exteriorBorderMemory.put(new VertexSet(C), NC);
+        return NC;
     }
 
     /**
      * Saturates the subgraph $C$ by adding all vertices $v\in N(C)$ of $V\setminus C$ that have all neighbors in $C$ or $N(C)$.
      * @param C A vertex set $C\subseteq V$ that should be saturated.
      */
-    public void saturate(BitSet C) {
-        BitSet neighbors = computeExteriorBorder(C);
-        BitSet Sprime = (BitSet) C.clone();
-        Sprime.or(neighbors);
+    public void saturate(VertexSet C) {
+        VertexSet neighbors = computeExteriorBorder(C, border);
+        VertexSet Sprime = closure.assign(C).or(neighbors);
         for (int v = neighbors.nextSetBit(0); v >= 0; v = neighbors.nextSetBit(v+1)) {
-            BitSet tmp = (BitSet) bitSetGraph[v].clone();
-            tmp.andNot(Sprime);
-            if (tmp.cardinality() == 0) C.set(v);
+            if (bitSetGraph[v].isSubsetOf(Sprime)) C.set(v);
         }
     }
 
@@ -214,13 +359,11 @@ public class BitSetGraph<T extends Comparable<T>> {
      * @param C A vertex set $C\subseteq V$.
      * @return An absorbable vertex $v\in C$, or $-1$ if non exists.
      */
-    public int absorbable(BitSet C) {
-        BitSet neighbors = computeExteriorBorder(C);
-        BitSet outside = (BitSet) C.clone();
-        outside.or(neighbors);
-        outside.flip(0,n);
+    public int absorbable(VertexSet C) {
+        VertexSet neighbors = computeExteriorBorder(C, border);
+        VertexSet inside = closure.assign(C).or(neighbors);
         for (int v = neighbors.nextSetBit(0); v >= 0; v = neighbors.nextSetBit(v+1)) {
-            if (!bitSetGraph[v].intersects(outside)) return v;
+            if (bitSetGraph[v].isSubsetOf(inside)) return v;
         }
         return -1;
     }
@@ -228,37 +371,35 @@ public class BitSetGraph<T extends Comparable<T>> {
     /**
      * Compute the connected components of $G[V\setminus S]$, $S$ will not be included in any of these components.
      * @param S A separator $S\subseteq V$.
-     * @return A list of the connected components of $G[V\setminus S]$, each represented as BitSet.
+     * @return A list of the connected components of $G[V\setminus S]$, each represented as VertexSet. The list is
+     *         memorized and must not be modified.
      */
-    public List<BitSet> separate(BitSet S) {
-        if (separateMemory.containsKey(S)) return separateMemory.get(S);
-        List<BitSet> components = new ArrayList<>(5);
-        BitSet visited = new BitSet();
-        visited.or(S);
+    public List<VertexSet> separate(VertexSet S) {
+        List<VertexSet> components = separateMemory.get(S);
+        if (components != null) return components;
+        components = new ArrayList<>(5);
+        visited.assign(S);
 
         // start dfs on each vertex
-        Stack<Integer> stack = new Stack<>();
-        for (int s = 0; s < n; s++) {
-            if (visited.get(s)) continue; // old component
-            BitSet component = new BitSet();
+        for (int s = visited.nextClearBit(0); s < n; s = visited.nextClearBit(s+1)) {
+            VertexSet component = new VertexSet(n);
             component.set(s);
             visited.set(s);
-            stack.add(s);
-            while (!stack.isEmpty()) {
-                int v = stack.pop();
-                for (int w = 0; w < n; w++) {
-                    if (!bitSetGraph[v].get(w)) continue;
-                    if (visited.get(w)) continue;
+            int size = 0;
+            stack[size++] = s;
+            while (size > 0) {
+                int v = stack[--size];
+                for (int w = bitSetGraph[v].nextSetBitNotIn(visited, 0); w >= 0; w = bitSetGraph[v].nextSetBitNotIn(visited, w+1)) {
                     component.set(w);
                     visited.set(w);
-                    stack.push(w);
+                    stack[size++] = w;
                 }
             }
             components.add(component);
         }
 
         // done
-        separateMemory.put(S, components);
+        separateMemory.put(new VertexSet(S), components);
         return components;
     }
 
@@ -270,13 +411,26 @@ public class BitSetGraph<T extends Comparable<T>> {
      * @param K A subgraph $K\subseteq V$.
      * @return True if $K$ is a potential maximal clique.
      */
-    public boolean isPotentialMaximalClique(BitSet K) {
-        if (pmcMemory.containsKey(K)) return pmcMemory.get(K);
-        List<BitSet> components = separate(K);
+    public boolean isPotentialMaximalClique(VertexSet K) {
+        Boolean isPMC = pmcMemory.get(K);
+        if (isPMC != null) return isPMC;
+        isPMC = computeIsPotentialMaximalClique(K);
+        pmcMemory.put(new VertexSet(K), isPMC);
+        return isPMC;
+    }
+
+    /**
+     * The actual test of @see isPotentialMaximalClique without memorization.
+     * @param K A subgraph $K\subseteq V$.
+     * @return True if $K$ is a potential maximal clique.
+     */
+    private boolean computeIsPotentialMaximalClique(VertexSet K) {
+        List<VertexSet> components = separate(K);
 
         // first test, K may not have a full component
-        for (BitSet component : components) {
-            if (computeExteriorBorder(component).cardinality() == K.cardinality()) return false;
+        int size = K.cardinality();
+        for (VertexSet component : components) {
+            if (computeExteriorBorder(component, border).cardinality() == size) return false;
         }
 
         // second test, K must be cliquish
@@ -284,21 +438,17 @@ public class BitSetGraph<T extends Comparable<T>> {
             for (int w = K.nextSetBit(v+1); w >= 0; w = K.nextSetBit(w+1)) {
                 if (bitSetGraph[v].get(w)) continue; // already an edge
                 boolean completable = false;
-                for (BitSet C : components) {
+                for (VertexSet C : components) {
                     if (bitSetGraph[v].intersects(C) && bitSetGraph[w].intersects(C)) {
                         completable = true;
                         break;
                     }
                 }
-                if (!completable) {
-                    pmcMemory.put(K, false);
-                    return false;
-                }
+                if (!completable) return false;
             }
         }
 
         // done
-        pmcMemory.put(K, true);
         return true;
     }
 
@@ -306,40 +456,34 @@ public class BitSetGraph<T extends Comparable<T>> {
      * Compute the unconfined components of $G[V\setminus K]$ with respect to $S$, i.\,e., the components $C$ with $N(C)\not\subseteq S$.
      * @param S A vertex set $S\subseteq K$.
      * @param K A vertex set $K\subset V$.
-     * @return The set $\mathrm{unconf}(S,K)$ as list of BitSets.
+     * @return The set $\mathrm{unconf}(S,K)$ as list of VertexSets.
      */
-    public List<BitSet> unconf(BitSet S, BitSet K) {
-        List<BitSet> result = new LinkedList<>();
-        List<BitSet> components = separate(K);
-
-        // not S
-        BitSet mask = new BitSet();
-        mask.set(0,n);
-        mask.andNot(S);
-
-        // unconf N(C) subseteq S -> N(C) cap not S = empty
-        for (BitSet C : components) {
-            if (!computeExteriorBorder(C).intersects(mask)) continue;
-            result.add(C);
+    public List<VertexSet> unconf(VertexSet S, VertexSet K) {
+        List<VertexSet> result = new ArrayList<>();
+        for (VertexSet C : separate(K)) {
+            if (isUnconfined(C, S)) result.add(C);
         }
-
         return result;
     }
 
+    /**
+     * Checks if the component $C$ is unconfined with respect to $S$, i.\,e., if $N(C)\not\subseteq S$.
+     */
+    private boolean isUnconfined(VertexSet C, VertexSet S) {
+        return !computeExteriorBorder(C, border).isSubsetOf(S);
+    }
+
     /**
      * Compute the crib of $K$ with respect to $S$.
      * @param S A vertex set $S\subseteq K$.
      * @param K A vertex set $K\subset V$.
-     * @return $(K\setminus S)\cup\bigcup_{D\in\mathrm{unconf(S,K)}}D$ as BitSet.
+     * @return $(K\setminus S)\cup\bigcup_{D\in\mathrm{unconf(S,K)}}D$ as VertexSet.
      */
-    public BitSet crib(BitSet S, BitSet K) {
-        BitSet crib = (BitSet) K.clone();
-        crib.andNot(S);
-
-        for (BitSet D : unconf(S, K)) {
-            crib.or(D);
+    public VertexSet crib(VertexSet S, VertexSet K) {
+        VertexSet crib = new VertexSet(K).andNot(S);
+        for (VertexSet D : separate(K)) {
+            if (isUnconfined(D, S)) crib.or(D);
         }
-
         return crib;
     }
 
@@ -350,12 +494,13 @@ public class BitSetGraph<T extends Comparable<T>> {
      * @param C A vertex set $C\subseteq V$.
      * @return True if $C$ is outbound.
      */
-    public boolean outbound(BitSet C) {
-        BitSet NC = computeExteriorBorder(C);
-        List<BitSet> components = separate(NC);
-        for (BitSet component : components) {
-            if (computeExteriorBorder(component).cardinality() != NC.cardinality()) continue;
-            if (component.nextSetBit(0) < C.nextSetBit(0)) return false;
+    public boolean outbound(VertexSet C) {
+        VertexSet NC = computeExteriorBorder(C, outboundBorder);
+        int size = NC.cardinality();
+        int first = C.nextSetBit(0);
+        for (VertexSet component : separate(NC)) {
+            if (computeExteriorBorder(component, border).cardinality() != size) continue;
+            if (component.nextSetBit(0) < first) return false;
         }
         return true;
     }
@@ -365,14 +510,19 @@ public class BitSetGraph<T extends Comparable<T>> {
      * @param K A vertex set $K\subseteq V$.
      * @return The maximum set $N(A)\subseteq K$ over all non-full and outbound components $A$ associated with $K$.
      */
-    public BitSet outlet(BitSet K) {
-        BitSet S = new BitSet();
-        List<BitSet> components = separate(K);
-        for (BitSet component : components) {
+    public VertexSet outlet(VertexSet K) {
+        VertexSet S = new VertexSet(n);
+        int size = K.cardinality();
+        int best = 0;
+        for (VertexSet component : separate(K)) {
             if (!outbound(component)) continue;
-            BitSet NC = computeExteriorBorder(component);
-            if (NC.cardinality() == K.cardinality()) continue;
-            if (NC.cardinality() > S.cardinality()) S = NC;
+            VertexSet NC = computeExteriorBorder(component, outletBorder);
+            int c = NC.cardinality();
+            if (c == size) continue;
+            if (c > best) {
+                best = c;
+                S.assign(NC);
+            }
         }
         return S;
     }
@@ -380,9 +530,9 @@ public class BitSetGraph<T extends Comparable<T>> {
     /**
      * Compute the support of $K$.
      * @param K A vertex set $K\subseteq V$.
-     * @return $\mathrm{unconf}(\mathrm{outlet}(K),K)$ as BitSet.
+     * @return $\mathrm{unconf}(\mathrm{outlet}(K),K)$ as VertexSet.
      */
-    public List<BitSet> support(BitSet K) {
+    public List<VertexSet> support(VertexSet K) {
         return unconf(outlet(K), K);
     }
 
@@ -391,11 +541,11 @@ public class BitSetGraph<T extends Comparable<T>> {
      * @param K A vertex set $K\subseteq V$.
      * @return A list of all components $A\in G[V\setminus K]$ with $N(A)=K$.
      */
-    public List<BitSet> fullComponents(BitSet K) {
-        List<BitSet> components = separate(K);
-        List<BitSet> fullComponents = new LinkedList<>();
-        for (BitSet D : components) {
-            if (computeExteriorBorder(D).cardinality() == K.cardinality()) fullComponents.add(D);
+    public List<VertexSet> fullComponents(VertexSet K) {
+        List<VertexSet> fullComponents = new ArrayList<>();
+        int size = K.cardinality();
+        for (VertexSet D : separate(K)) {
+            if (computeExteriorBorder(D, border).cardinality() == size) fullComponents.add(D);
         }
         return fullComponents;
     }
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.graph;
+
+import java.io.Serializable;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.atomic.AtomicIntegerArray;
+import java.util.logging.Logger;
+import java.util.stream.IntStream;
+
+import jdrasil.utilities.JdrasilProperties;
+import jdrasil.utilities.logging.JdrasilLogger;
+
+/**
+ * A compact, immutable representation of a tree decomposition that stores the tree and the bags in flat int arrays
+ * instead of Bag objects with hash sets and a Graph of bags.
+ *
+ * The vertices of the graph get the ids \(\{0,\dots,n-1\}\) in their natural order, i.e., the same ids as in an
+ * @see IntGraph of the graph. The bags are numbered \(0,\dots,b-1\) in BFS order of the rooted tree (a forest if the
+ * decomposition is not connected): the roots come first, the parent of a bag has a smaller index than the bag, and the
+ * children of a bag are consecutive. Hence, a loop over the bags from the last to the first one is a bottom-up traversal.
+ *
+ * The arrays are:
+ *   - parent[i] is the parent of bag i, or -1 if i is a root
+ *   - the children of bag i are the bags childOffsets[i] to childOffsets[i+1]-1
+ *   - the content of bag i is stored sorted in bagContents[bagOffsets[i]..bagOffsets[i+1]-1]
+ *   - bagIds[i] is the id of the bag of the TreeDecomposition from which bag i was created
+ *
+ * A CompactTreeDecomposition is created from a TreeDecomposition and can be converted back with toTreeDecomposition().
+ *
+ * @param <T> vertex type of the graph
+ * @author Max Bannach
+ */
+public class CompactTreeDecomposition<T extends Comparable<T>> implements Serializable {
+
+	/** Jdrasils Logger */
+	private final static Logger LOG = Logger.getLogger(JdrasilLogger.getName());
+
+	private static final long serialVersionUID = 6090420707364418517L;
+
+	/** The decomposed graph. */
+	private final Graph<T> graph;
+
+	/** The vertices of the graph in their natural order, vertex v has id v. */
+	private final List<T> vertices;
+
+	/** The number of bags. */
+	private final int numberOfBags;
+
+	/** The number of roots, these are the bags 0 to numberOfRoots-1. */
+	private final int numberOfRoots;
+
+	/** The width of the decomposition, i.e., the size of the largest bag minus 1. */
+	private final int width;
+
+	/** The parent of every bag, or -1 for roots. */
+	private final int[] parent;
+
+	/** The children of bag i are the bags childOffsets[i]..childOffsets[i+1]-1. */
+	private final int[] childOffsets;
+
+	/** The content of bag i is stored in bagContents[bagOffsets[i]..bagOffsets[i+1]-1]. */
+	private final int[] bagOffsets;
+
+	/** The concatenated, sorted contents of all bags. */
+	private final int[] bagContents;
+
+	/** The ids of the bags in the tree decomposition this one was created from. */
+	private final int[] bagIds;
+
+	/**
+	 * Creates the compact representation of the given tree decomposition. Every connected component of the tree is
+	 * rooted at its bag with the smallest id.
+	 * @param td the tree decomposition
+	 */
+	public CompactTreeDecomposition(TreeDecomposition<T> td) {
+		this(td, null);
+	}
+
+	/**
+	 * Creates the compact representation of the given tree decomposition, see @see
+	 * CompactTreeDecomposition(TreeDecomposition), in which the given bag is the root of its component (and bag 0).
+	 * @param td the tree decomposition
+	 * @param root a bag of td, or null to root every component at its bag with the smallest id
+	 */
+	public CompactTreeDecomposition(TreeDecomposition<T> td, Bag<T> root) {
+		this.graph = td.getGraph();
+		this.vertices = new ArrayList<>(graph.getCopyOfVertices());
+		Collections.sort(vertices);
+		List<Bag<T>> bags = new ArrayList<>(td.getBags());
+		Collections.sort(bags);
+		if (root != null && bags.remove(root)) bags.add(0, root);
+		this.numberOfBags = bags.size();
+
+		// find a root in every component
+		List<Bag<T>> roots = new ArrayList<>();
+		Set<Bag<T>> visited = new HashSet<>();
+		List<Bag<T>> stack = new ArrayList<>();
+		for (Bag<T> r : bags) {
+			if (!visited.add(r)) continue;
+			roots.add(r);
+			stack.add(r);
+			while (!stack.isEmpty()) {
+				Bag<T> bag = stack.remove(stack.size()-1);
+				for (Bag<T> w : td.getNeighborhood(bag)) if (visited.add(w)) stack.add(w);
+			}
+		}
+		this.numberOfRoots = roots.size();
+
+		// number the bags in BFS order starting with all roots
+		List<Bag<T>> order = new ArrayList<>(roots);
+		Map<Bag<T>, Integer> index = new HashMap<>(2*numberOfBags);
+		for (int i = 0; i < numberOfRoots; i++) index.put(roots.get(i), i);
+		this.parent = new int[numberOfBags];
+		this.childOffsets = new int[numberOfBags+1];
+		Arrays.fill(parent, 0, numberOfRoots, -1);
+		for (int i = 0; i < numberOfBags; i++) {
+			childOffsets[i] = order.size();
+			for (Bag<T> w : td.getNeighborhood(order.get(i))) {
+				if (index.containsKey(w)) continue;
+				parent[order.size()] = i;
+				index.put(w, order.size());
+				order.add(w);
+			}
+		}
+		childOffsets[numberOfBags] = numberOfBags;
+
+		// store the bags
+		this.bagOffsets = new int[numberOfBags+1];
+		for (int i = 0; i < numberOfBags; i++) bagOffsets[i+1] = bagOffsets[i] + order.get(i).vertices.size();
+		this.bagContents = new int[bagOffsets[numberOfBags]];
+		this.bagIds = new int[numberOfBags];
+		int maxSize = 0;
+		for (int i = 0; i < numberOfBags; i++) {
+			bagIds[i] = order.get(i).id;
+			int k = bagOffsets[i];
+			for (T v : order.get(i).vertices) {
+				int id = getId(v);
+				if (id < 0) throw new IllegalArgumentException("Vertex " + v + " of bag " + order.get(i).id + " is not in the graph.");
+				bagContents[k++] = id;
+			}
+			Arrays.sort(bagContents, bagOffsets[i], k);
+			maxSize = Math.max(maxSize, k - bagOffsets[i]);
+		}
+		this.width = maxSize - 1;
+	}
+
+	/**
+	 * Converts the decomposition back to a TreeDecomposition. Bag i gets the id i+1.
+	 * @return a new tree decomposition with the same tree and bags
+	 */
+	public TreeDecomposition<T> toTreeDecomposition() {
+		TreeDecomposition<T> td = new TreeDecomposition<>(graph);
+		List<Bag<T>> bags = new ArrayList<>(numberOfBags);
+		for (int i = 0; i < numberOfBags; i++) {
+			Set<T> bagVertices = new HashSet<>((int) (getBagSize(i) / 0.75f) + 1);
+			for (int k = bagOffsets[i]; k < bagOffsets[i+1]; k++) bagVertices.add(vertices.get(bagContents[k]));
+			bags.add(td.createBag(bagVertices));
+			if (parent[i] >= 0) td.addTreeEdge(bags.get(parent[i]), bags.get(i));
+		}
+		return td;
+	}
+
+	/**
+	 * Getter for the decomposed graph.
+	 * @return the graph
+	 */
+	public Graph<T> getGraph() {
+		return graph;
+	}
+
+	/**
+	 * The number of vertices of the decomposed graph.
+	 * @return n
+	 */
+	public int getNumVertices() {
+		return vertices.size();
+	}
+
+	/**
+	 * Returns the vertex of the graph with the given id.
+	 * @param v the id of a vertex
+	 * @return the vertex
+	 */
+	public T getVertex(int v) {
+		return vertices.get(v);
+	}
+
+	/**
+	 * Returns the id of a vertex of the graph.
+	 * @param v a vertex of the graph
+	 * @return the id of v or -1 if v is not in the graph
+	 */
+	public int getId(T v) {
+		int id = Collections.binarySearch(vertices, v);
+		return id < 0 ? -1 : id;
+	}
+
+	/**
+	 * The number of bags.
+	 * @return b
+	 */
+	public int getNumberOfBags() {
+		return numberOfBags;
+	}
+
+	/**
+	 * The number of roots, i.e., of connected components of the tree. The roots are the bags 0 to this number minus 1.
+	 * @return the number of roots
+	 */
+	public int getNumberOfRoots() {
+		return numberOfRoots;
+	}
+
+	/**
+	 * The width of the decomposition.
+	 * @return the size of the largest bag minus 1
+	 */
+	public int getWidth() {
+		return width;
+	}
+
+	/**
+	 * The parent of a bag.
+	 * @param i a bag
+	 * @return the parent of i, or -1 if i is a root
+	 */
+	public int getParent(int i) {
+		return parent[i];
+	}
+
+	/**
+	 * The id of the bag of the TreeDecomposition from which a bag was created, for instance to look up data that is
+	 * attached to the original bags.
+	 * @param i a bag
+	 * @return the id of the original bag
+	 */
+	public int getBagId(int i) {
+		return bagIds[i];
+	}
+
+	/**
+	 * The first child of a bag.
+	 * @param i a bag
+	 * @return the index of the first child of i
+	 */
+	public int childrenStart(int i) {
+		return childOffsets[i];
+	}
+
+	/**
+	 * The end of the children of a bag.
+	 * @param i a bag
+	 * @return one plus the index of the last child of i
+	 */
+	public int childrenEnd(int i) {
+		return childOffsets[i+1];
+	}
+
+	/**
+	 * The number of vertices in a bag.
+	 * @param i a bag
+	 * @return \(|B_i|\)
+	 */
+	public int getBagSize(int i) {
+		return bagOffsets[i+1] - bagOffsets[i];
+	}
+
+	/**
+	 * The start of a bag in @see getBagContents().
+	 * @param i a bag
+	 * @return the index of the first vertex of bag i
+	 */
+	public int bagStart(int i) {
+		return bagOffsets[i];
+	}
+
+	/**
+	 * The end of a bag in @see getBagContents().
+	 * @param i a bag
+	 * @return one plus the index of the last vertex of bag i
+	 */
+	public int bagEnd(int i) {
+		return bagOffsets[i+1];
+	}
+
+	/**
+	 * The concatenated, sorted contents of all bags as vertex ids. The array must not be modified.
+	 * @return the contents of the bags
+	 */
+	public int[] getBagContents() {
+		return bagContents;
+	}
+
+	/**
+	 * The ids of the vertices of a bag.
+	 * @param i a bag
+	 * @return a sorted copy of the ids in bag i
+	 */
+	public int[] getBag(int i) {
+		return Arrays.copyOfRange(bagContents, bagOffsets[i], bagOffsets[i+1]);
+	}
+
+	/**
+	 * Test if a bag contains a vertex with a binary search.
+	 * @param i a bag
+	 * @param v the id of a vertex
+	 * @return true if v is in bag i
+	 */
+	public boolean contains(int i, int v) {
+		return Arrays.binarySearch(bagContents, bagOffsets[i], bagOffsets[i+1], v) >= 0;
+	}
+
+	/**
+	 * Checks whether the decomposition is valid, i.e., that every vertex and every edge of the graph is in some bag and
+	 * that the bags containing a vertex induce a connected subtree. If it is invalid, the reasons will be logged.
+	 *
+	 * The bags containing a vertex v are connected if, and only if, exactly one of them is a top bag of v, i.e., a bag
+	 * whose parent does not contain v. So the connectivity is checked with one pass over the bags. Two connected
+	 * subtrees of a rooted tree intersect if, and only if, the top of one of them lies in the other, so an edge
+	 * {u, w} is covered if the top bag of u contains w or the top bag of w contains u. Membership is tested with
+	 * binary searches in the sorted bags, so the test runs in time \(O((\sum_i|B_i|+m)\log \mathrm{tw})\). With
+	 * -parallel, the bags and the vertices are processed in parallel.
+	 *
+	 * Edges incident to a vertex that is not in a bag, or whose bags are not connected, are not tested.
+	 * @return true if the decomposition is valid
+	 */
+	public boolean isValid() {
+		int n = vertices.size();
+		IntGraph<T> intGraph = new IntGraph<>(graph); // uses the same ids
+		int[] targets = intGraph.getTargets();
+
+		// count the top bags of every vertex
+		AtomicIntegerArray tops = new AtomicIntegerArray(n);
+		int[] top = new int[n];
+		range(numberOfBags).forEach(i -> {
+			int p = parent[i];
+			for (int k = bagOffsets[i]; k < bagOffsets[i+1]; k++) {
+				int v = bagContents[k];
+				if (p >= 0 && contains(p, v)) continue;
+				tops.incrementAndGet(v);
+				top[v] = i;
+			}
+		});
+
+		// test the edges of vertices with a connected subtree
+		boolean[] uncovered = new boolean[n];
+		range(n).forEach(u -> {
+			if (tops.get(u) != 1) return;
+			for (int j = intGraph.neighborhoodStart(u); j < intGraph.neighborhoodEnd(u); j++) {
+				int w = targets[j];
+				if (w < u || tops.get(w) != 1) continue;
+				if (!contains(top[u], w) && !contains(top[w], u)) {
+					uncovered[u] = true;
+					return;
+				}
+			}
+		});
+
+		// report the results
+		boolean valid = true;
+		for (int v = 0; v < n; v++) {
+			if (tops.get(v) == 0) {
+				valid = false;
+				LOG.warning("Vertex " + vertices.get(v) + " not contained in any bag!");
+			} else if (tops.get(v) > 1) {
+				valid = false;
+				LOG.warning("Tree containing vertex " + vertices.get(v) + " is not connected!");
+			}
+			if (!uncovered[v]) continue;
+			valid = false;
+			for (int j = intGraph.neighborhoodStart(v); j < intGraph.neighborhoodEnd(v); j++) {
+				int w = targets[j];
+				if (w < v || tops.get(w) != 1) continue;
+				if (!contains(top[v], w) && !contains(top[w], v)) {
+					LOG.warning("Edge {" + vertices.get(v) + ", " + vertices.get(w) + "} not contained in any bag!");
+				}
+			}
+		}
+
+		// done
+		return valid;
+	}
+
+	/**
+	 * A stream over \(\{0,\dots,size-1\}\) that is parallel if the parallel flag is set.
+	 */
+	private static IntStream range(int size) {
+		IntStream range = IntStream.range(0, size);
+		return JdrasilProperties.containsKey("parallel") ? range.parallel() : range;
+	}
+
+}
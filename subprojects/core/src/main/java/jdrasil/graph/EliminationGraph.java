@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.graph;
+
+import java.io.Serializable;
+import java.util.Arrays;
+
+/**
+ * A mutable graph over the vertex ids of an IntGraph that supports the elimination game: eliminating a vertex makes
+ * its neighborhood a clique and removes the vertex from the graph.
+ *
+ * In contrast to Graph.eliminateVertex(), eliminations do not allocate any objects. Neighborhoods are stored as
+ * unsorted int arrays and every operation is recorded on an int stack (the history), such that eliminations and
+ * added edges can be undone in reverse order by undo() or rollback(). Arrays only grow if a neighborhood or the
+ * history exceeds its capacity for the first time, so search algorithms that eliminate and undo vertices over and
+ * over again work without any allocation after a short warm up.
+ *
+ * If requested, the number of edges within the neighborhood of every vertex is maintained under all operations,
+ * which makes the fill-in value of a vertex available in O(1). Adding or removing an edge {u,w} costs
+ * \(O(\delta(u)+\delta(w))\) in this case.
+ *
+ * @param <T> the type of the vertices of the original graph
+ * @author Max Bannach
+ */
+public class EliminationGraph<T extends Comparable<T>> implements Serializable {
+
+	private static final long serialVersionUID = -4313283592744236906L;
+
+	/** Tags that mark the records on the history stack. */
+	private static final int ELIMINATION = 0;
+	private static final int EDGE = 1;
+
+	/** The graph this graph was created from, used to map ids to vertices. */
+	private final IntGraph<T> graph;
+
+	/** The number of vertex ids. */
+	private final int n;
+
+	/** The number of vertices that are not eliminated. */
+	private int numVertices;
+
+	/** The number of edges between vertices that are not eliminated. */
+	private int m;
+
+	/**
+	 * The neighborhood of v is stored in adj[v][0..deg[v]-1]. Eliminated vertices keep the neighborhood they had when
+	 * they got eliminated, which is needed to undo the elimination.
+	 */
+	private final int[][] adj;
+	private final int[] deg;
+
+	/** Vertices that are currently eliminated. */
+	private final boolean[] eliminated;
+
+	/** The number of edges in the neighborhood of every vertex, or null if fill-in values are not tracked. */
+	private final int[] edgesInNeighborhood;
+
+	/** Stamp arrays used to mark neighborhoods, mark is used for edge updates and pairMark while filling. */
+	private final int[] mark;
+	private final int[] pairMark;
+	private int stamp;
+	private int pairStamp;
+
+	/** The history of all operations, consisting of the arguments of an operation followed by its tag. */
+	private int[] history;
+	private int historySize;
+
+	/**
+	 * Creates an elimination graph that initially equals the given graph.
+	 * @param graph the initial graph
+	 * @param trackFillIn whether fill-in values should be maintained
+	 */
+	public EliminationGraph(IntGraph<T> graph, boolean trackFillIn) {
+		this.graph = graph;
+		this.n = graph.getNumVertices();
+		this.numVertices = n;
+		this.m = graph.getNumberOfEdges();
+		this.adj = new int[n][];
+		this.deg = new int[n];
+		for (int v = 0; v < n; v++) {
+			adj[v] = graph.getNeighborhood(v);
+			deg[v] = adj[v].length;
+		}
+		this.eliminated = new boolean[n];
+		if (trackFillIn) {
+			this.edgesInNeighborhood = graph.getEdgesInNeighborhoods();
+		} else {
+			this.edgesInNeighborhood = null;
+		}
+		this.mark = new int[n];
+		this.pairMark = new int[n];
+		this.stamp = 0;
+		this.pairStamp = 0;
+		this.history = new int[Math.max(16, 2*graph.getNumberOfEdges())];
+		this.historySize = 0;
+	}
+
+	/**
+	 * Creates an elimination graph that initially equals the given graph.
+	 * @param graph the initial graph
+	 * @param trackFillIn whether fill-in values should be maintained
+	 */
+	public EliminationGraph(Graph<T> graph, boolean trackFillIn) {
+		this(new IntGraph<>(graph), trackFillIn);
+	}
+
+	//MARK: queries
+
+	/**
+	 * The number of vertex ids, i.e., the number of vertices of the initial graph.
+	 * @return n
+	 */
+	public int getNumIds() {
+		return n;
+	}
+
+	/**
+	 * The number of vertices that are not eliminated.
+	 * @return the number of remaining vertices
+	 */
+	public int getNumVertices() {
+		return numVertices;
+	}
+
+	/**
+	 * The number of edges between vertices that are not eliminated.
+	 * @return m
+	 */
+	public int getNumberOfEdges() {
+		return m;
+	}
+
+	/**
+	 * Returns the vertex of the original graph with the given id.
+	 * @param v the id of a vertex
+	 * @return the original vertex
+	 */
+	public T getVertex(int v) {
+		return graph.getVertex(v);
+	}
+
+	/**
+	 * Returns the id of a vertex of the original graph.
+	 * @param v a vertex of the original graph
+	 * @return the id of v or -1 if v is not in the graph
+	 */
+	public int getId(T v) {
+		return graph.getId(v);
+	}
+
+	/**
+	 * Check if the vertex is currently eliminated.
+	 * @param v the id of a vertex
+	 * @return true if v is eliminated
+	 */
+	public boolean isEliminated(int v) {
+		return eliminated[v];
+	}
+
+	/**
+	 * The degree of a vertex. For an eliminated vertex this is the degree it had at the time of its elimination.
+	 * @param v the id of a vertex
+	 * @return \(\delta(v)\)
+	 */
+	public int getDegree(int v) {
+		return deg[v];
+	}
+
+	/**
+	 * The i'th neighbor of v, neighborhoods are not sorted.
+	 * @param v the id of a vertex
+	 * @param i an index in 0..getDegree(v)-1
+	 * @return the i'th neighbor of v
+	 */
+	public int getNeighbor(int v, int i) {
+		return adj[v][i];
+	}
+
+	/**
+	 * Check if two vertices are adjacent by scanning the smaller neighborhood.
+	 * @param u the id of the first vertex
+	 * @param v the id of the second vertex
+	 * @return true if {u,v} is an edge
+	 */
+	public boolean isAdjacent(int u, int v) {
+		if (eliminated[u] || eliminated[v]) return false;
+		if (deg[u] > deg[v]) { int tmp = u; u = v; v = tmp; }
+		for (int i = 0; i < deg[u]; i++) if (adj[u][i] == v) return true;
+		return false;
+	}
+
+	/**
+	 * Returns the number of edges the elimination of v will introduce to the graph in O(1).
+	 * This is only available if the graph was created with fill-in tracking.
+	 * @param v the id of a vertex
+	 * @return the fill-in value of v
+	 */
+	public int getFillInValue(int v) {
+		if (edgesInNeighborhood == null) throw new RuntimeException("Fill-in values are not tracked by this graph!");
+		return (deg[v]*deg[v]-deg[v])/2 - edgesInNeighborhood[v];
+	}
+
+	//MARK: modifications
+
+	/**
+	 * Eliminates the vertex v, i.e., makes its neighborhood a clique and removes v from the graph.
+	 * This operation is recorded in the history and can be undone.
+	 * @param v the id of a vertex that is not eliminated
+	 */
+	public void eliminateVertex(int v) {
+		if (eliminated[v]) throw new RuntimeException("Vertex " + v + " is already eliminated!");
+		int d = deg[v];
+		int[] Nv = adj[v];
+
+		// 1. detach v from its neighbors, the edges to Nv[i+1..d-1] are still present at step i
+		for (int i = 0; i < d; i++) {
+			int u = Nv[i];
+			if (edgesInNeighborhood != null) updateEdgesInNeighborhood(v, i+1, u, -1);
+			int j = indexOf(u, v);
+			adj[u][j] = adj[u][--deg[u]];
+			push(j);
+			m--;
+		}
+		eliminated[v] = true;
+		numVertices--;
+
+		// 2. make the neighborhood a clique
+		int fill = 0;
+		for (int i = 0; i < d; i++) {
+			int u = Nv[i];
+			int s = nextPairStamp();
+			for (int k = 0; k < deg[u]; k++) pairMark[adj[u][k]] = s;
+			for (int k = i+1; k < d; k++) {
+				int w = Nv[k];
+				if (pairMark[w] == s) continue;
+				addHalfOfEdge(u, w);
+				addHalfOfEdge(w, u);
+				m++;
+				if (edgesInNeighborhood != null) updateEdgesInNeighborhood(u, 0, w, +1);
+				push(u);
+				push(w);
+				fill++;
+			}
+		}
+		push(fill);
+		push(v);
+		push(ELIMINATION);
+	}
+
+	/**
+	 * Adds the edge {u,w}, which must not be present yet, to the graph.
+	 * This operation is recorded in the history and can be undone.
+	 * @param u the id of a vertex
+	 * @param w the id of a vertex
+	 */
+	public void addEdge(int u, int w) {
+		addHalfOfEdge(u, w);
+		addHalfOfEdge(w, u);
+		m++;
+		if (edgesInNeighborhood != null) updateEdgesInNeighborhood(u, 0, w, +1);
+		push(u);
+		push(w);
+		push(EDGE);
+	}
+
+	//MARK: history
+
+	/**
+	 * A checkpoint of the history, i.e., the state of the graph at this moment can be restored with rollback().
+	 * @return the current checkpoint
+	 */
+	public int getCheckpoint() {
+		return historySize;
+	}
+
+	/**
+	 * Undo all operations that were performed after the given checkpoint was obtained.
+	 * @param checkpoint a checkpoint obtained by getCheckpoint()
+	 */
+	public void rollback(int checkpoint) {
+		while (historySize > checkpoint) undo();
+	}
+
+	/**
+	 * Forget the history, the current state of the graph can not be undone anymore.
+	 * This should be used by algorithms that never undo operations, as the history otherwise keeps growing.
+	 */
+	public void clearHistory() {
+		historySize = 0;
+	}
+
+	/**
+	 * Undo the last operation, i.e., the last elimination or the last added edge.
+	 */
+	public void undo() {
+		if (historySize == 0) throw new RuntimeException("Nothing to undo!");
+		int tag = history[--historySize];
+		if (tag == EDGE) {
+			int w = history[--historySize];
+			int u = history[--historySize];
+			removeLastEdge(u, w);
+			return;
+		}
+
+		// undo an elimination in reverse order
+		int v = history[--historySize];
+		int fill = history[--historySize];
+		for (int f = 0; f < fill; f++) {
+			int w = history[--historySize];
+			int u = history[--historySize];
+			removeLastEdge(u, w);
+		}
+		eliminated[v] = false;
+		numVertices++;
+		int[] Nv = adj[v];
+		for (int i = deg[v]-1; i >= 0; i--) {
+			int u = Nv[i];
+			int j = history[--historySize];
+			if (deg[u] == adj[u].length) adj[u] = Arrays.copyOf(adj[u], 2*deg[u]+2);
+			adj[u][deg[u]++] = adj[u][j];
+			adj[u][j] = v;
+			m++;
+			if (edgesInNeighborhood != null) updateEdgesInNeighborhood(v, i+1, u, +1);
+		}
+	}
+
+	//MARK: internals
+
+	/**
+	 * Remove the edge {u,w}, which has to be the last entry of N(u) and N(w).
+	 */
+	private void removeLastEdge(int u, int w) {
+		if (edgesInNeighborhood != null) updateEdgesInNeighborhood(u, 0, w, -1);
+		deg[u]--;
+		deg[w]--;
+		m--;
+	}
+
+	/**
+	 * Update the number of edges in neighborhoods for an added (delta = 1) or removed (delta = -1) edge {u,w},
+	 * where the neighborhood of u is given by adj[u][from..deg[u]-1]. This counts the common neighbors x of u and w:
+	 * the edge lies in N(x) for each of them, and u and w gain or lose one edge in their neighborhood per x.
+	 */
+	private void updateEdgesInNeighborhood(int u, int from, int w, int delta) {
+		int s = nextStamp();
+		for (int i = from; i < deg[u]; i++) mark[adj[u][i]] = s;
+		int common = 0;
+		for (int i = 0; i < deg[w]; i++) {
+			int x = adj[w][i];
+			if (mark[x] == s) {
+				edgesInNeighborhood[x] += delta;
+				common++;
+			}
+		}
+		edgesInNeighborhood[u] += delta*common;
+		edgesInNeighborhood[w] += delta*common;
+	}
+
+	/**
+	 * Append w to N(u).
+	 */
+	private void addHalfOfEdge(int u, int w) {
+		if (deg[u] == adj[u].length) adj[u] = Arrays.copyOf(adj[u], 2*deg[u]+2);
+		adj[u][deg[u]++] = w;
+	}
+
+	/**
+	 * The position of w in N(u).
+	 */
+	private int indexOf(int u, int w) {
+		for (int i = 0; i < deg[u]; i++) if (adj[u][i] == w) return i;
+		throw new RuntimeException("Vertex " + w + " is not a neighbor of " + u + "!");
+	}
+
+	/**
+	 * Push a value on the history stack.
+	 */
+	private void push(int value) {
+		if (historySize == history.length) history = Arrays.copyOf(history, 2*history.length);
+		history[historySize++] = value;
+	}
+
+	/**
+	 * A fresh stamp for the mark array.
+	 */
+	private int nextStamp() {
+		if (stamp == Integer.MAX_VALUE) {
+			Arrays.fill(mark, 0);
+			stamp = 0;
+		}
+		return ++stamp;
+	}
+
+	/**
+	 * A fresh stamp for the pairMark array.
+	 */
+	private int nextPairStamp() {
+		if (pairStamp == Integer.MAX_VALUE) {
+			Arrays.fill(pairMark, 0);
+			pairStamp = 0;
+		}
+		return ++pairStamp;
+	}
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.graph;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.ReadableByteChannel;
+import java.util.Arrays;
+
+/**
+ * A parser for .gr files (as defined by PACE) that works directly on the bytes of the input. The input is either
+ * read in large blocks from a channel or given as (possibly memory mapped) ByteBuffer.
+ *
+ * Integers are parsed by hand and the edges are stored in a single int array, which is allocated with the size
+ * announced by the "p tw n m" line. Thus, parsing does not create any objects per line or per edge. The parsed
+ * edge list can be turned into an IntGraph, which in turn yields a Graph.
+ *
+ * As the old parser, this parser can also handle .dgf files: edges may be prefixed with "e" and the lines
+ * "n", "d", "v", "x", "b", and "l" are ignored, as are comments.
+ *
+ * @author Max Bannach
+ */
+public class GrParser {
+
+	/** Size of the blocks read from a channel. */
+	private static final int BLOCK_SIZE = 1 << 20;
+
+	/** The channel we read from, or null if the buffer contains the whole input. */
+	private final ReadableByteChannel channel;
+
+	/** The buffer storing the current part of the input. */
+	private final ByteBuffer buffer;
+
+	/** The current character of the input, or -1 at the end of the input. */
+	private int c;
+
+	/** Number of bytes consumed so far. */
+	private long bytes;
+
+	/** The number of vertices, i.e., the maximum of the announced number and the largest vertex seen. */
+	private int n;
+
+	/** The endpoints of the parsed edges, edge i is {edges[2i], edges[2i+1]}. */
+	private int[] edges;
+
+	/** The number of parsed edges. */
+	private int m;
+
+	/**
+	 * Create a parser that reads the input in blocks from the given channel.
+	 * @param channel the channel storing the .gr file
+	 */
+	public GrParser(ReadableByteChannel channel) {
+		this.channel = channel;
+		this.buffer = ByteBuffer.allocate(BLOCK_SIZE);
+		this.buffer.flip();
+		this.edges = new int[1024];
+	}
+
+	/**
+	 * Create a parser that reads the given buffer (from its position to its limit).
+	 * @param buffer the buffer storing the .gr file
+	 */
+	public GrParser(ByteBuffer buffer) {
+		this.channel = null;
+		this.buffer = buffer;
+		this.edges = new int[1024];
+	}
+
+	/**
+	 * Parse the complete input.
+	 * @return this parser
+	 * @throws IOException if the input can not be read or is not a valid .gr file
+	 */
+	public GrParser parse() throws IOException {
+		next();
+		while (c != -1) {
+			skipBlanks();
+			switch (c) {
+				case -1:
+				case '\n':
+					break;
+				case 'p': // the problem line "p tw n m"
+					next();
+					skipBlanks();
+					while (c > ' ') next(); // the problem descriptor
+					int announcedVertices = readInt();
+					n = Math.max(n, announcedVertices);
+					skipBlanks();
+					if (c >= '0' && c <= '9') {
+						int announcedEdges = readInt();
+						if (2L*announcedEdges > edges.length) edges = Arrays.copyOf(edges, 2*announcedEdges);
+					}
+					break;
+				case 'e': // .dgf edge
+					next();
+					readEdge();
+					break;
+				case 'c': case 'n': case 'd': case 'v': case 'x': case 'b': case 'l':
+					break; // comments and information from .dgf files we ignore
+				default:
+					if (c < '0' || c > '9') throw new IOException("Unexpected character '" + (char) c + "' at byte " + bytes);
+					readEdge();
+			}
+			skipLine();
+		}
+		return this;
+	}
+
+	/**
+	 * The number of vertices of the parsed graph.
+	 * @return n
+	 */
+	public int getNumVertices() {
+		return n;
+	}
+
+	/**
+	 * The number of parsed edges (including multiple edges and self loops, if the input contains them).
+	 * @return m
+	 */
+	public int getNumEdges() {
+		return m;
+	}
+
+	/**
+	 * The number of bytes consumed by the parser.
+	 * @return the size of the input
+	 */
+	public long getNumBytes() {
+		return bytes;
+	}
+
+	/**
+	 * The endpoints of the parsed edges, edge i is {edges[2i], edges[2i+1]}. This is the internal buffer of the parser,
+	 * which may be larger than 2m.
+	 * @return the edge buffer
+	 */
+	int[] getEdges() {
+		return edges;
+	}
+
+	/**
+	 * The parsed graph as IntGraph over the vertices 1,...,n.
+	 * @return the graph
+	 */
+	public IntGraph<Integer> toIntGraph() {
+		return IntGraph.fromEdges(n, edges, m);
+	}
+
+	/**
+	 * Reads an edge "u v", the vertices are added to the graph if necessary.
+	 */
+	private void readEdge() throws IOException {
+		int u = readInt();
+		int v = readInt();
+		if (u == 0 || v == 0) throw new IOException("Vertices are numbered from 1, found an edge {" + u + ", " + v + "}");
+		if (2*m+2 > edges.length) edges = Arrays.copyOf(edges, Math.max(2*m+2, edges.length + (edges.length >> 1)));
+		edges[2*m] = u;
+		edges[2*m+1] = v;
+		m++;
+		if (u > n) n = u;
+		if (v > n) n = v;
+	}
+
+	/**
+	 * Reads a non-negative integer, leading blanks are skipped.
+	 */
+	private int readInt() throws IOException {
+		skipBlanks();
+		if (c < '0' || c > '9') throw new IOException("Expected a number at byte " + bytes);
+		long value = 0;
+		while (c >= '0' && c <= '9') {
+			value = 10*value + (c - '0');
+			if (value > Integer.MAX_VALUE) throw new IOException("Number too large at byte " + bytes);
+			next();
+		}
+		return (int) value;
+	}
+
+	/**
+	 * Skip spaces, tabs, and carriage returns (but not line breaks).
+	 */
+	private void skipBlanks() throws IOException {
+		while (c == ' ' || c == '\t' || c == '\r') next();
+	}
+
+	/**
+	 * Skip the rest of the current line including the line break.
+	 */
+	private void skipLine() throws IOException {
+		while (c != '\n' && c != -1) next();
+		if (c == '\n') next();
+	}
+
+	/**
+	 * Advance to the next character of the input.
+	 */
+	private void next() throws IOException {
+		if (!buffer.hasRemaining() && !refill()) {
+			c = -1;
+			return;
+		}
+		c = buffer.get() & 0xff;
+		bytes++;
+	}
+
+	/**
+	 * Read the next block from the channel.
+	 * @return false if there is no more input
+	 */
+	private boolean refill() throws IOException {
+		if (channel == null) return false;
+		buffer.clear();
+		int read;
+		do {
+			read = channel.read(buffer);
+		} while (read == 0);
+		buffer.flip();
+		return read > 0;
+	}
+}
@@ -21,6 +21,7 @@ package jdrasil.graph;
 import java.io.Serializable;
 import java.security.KeyStore.Entry;
 import java.util.ArrayList;
+import java.util.Collections;
 import java.util.HashMap;
 import java.util.HashSet;
 import java.util.Iterator;
@@ -95,6 +96,19 @@ public class Graph<T extends Comparable<T>> implements Iterable<T>, Serializable
 		isDirected = false;
 	}
 	
+	/**
+	 * Package private constructor that initializes the data structures for the given number of vertices.
+	 * The graph has to be filled with setNeighborhood().
+	 * @param expectedVertices the number of vertices the graph will have
+	 */
+	Graph(int expectedVertices) {
+		int capacity = (int) (expectedVertices / 0.75f) + 1;
+		adjacencies = new HashMap<>(capacity);
+		edgesInNeighborhood = new HashMap<>(capacity);
+		setLogEdgesInNeighbourhood(true);
+		isDirected = false;
+	}
+	
 	public Graph(Graph<T> original){
 		isDirected = original.isDirected;
 		setLogEdgesInNeighbourhood(original.isLogEdgesInNeighbourhood());
@@ -119,6 +133,18 @@ public class Graph<T extends Comparable<T>> implements Iterable<T>, Serializable
 	public Set<T> getCopyOfVertices() {
 		return new HashSet<T>(adjacencies.keySet());
 	}
+
+	/**
+	 * Returns the vertices of this graph in ascending order. Solvers that number the vertices should use this
+	 * order instead of the hash order of the graph, such that their numbering follows the labels of the vertices
+	 * (for instance, the locality preserving labels of @see jdrasil.algorithms.preprocessing.GraphRelabeler).
+	 * @return A list of the vertices, sorted in ascending order.
+	 */
+	public List<T> getSortedVertices() {
+		List<T> vertices = new ArrayList<T>(adjacencies.keySet());
+		Collections.sort(vertices);
+		return vertices;
+	}
 	
 	public boolean containsNode(T v){
 		return adjacencies.containsKey(v);
@@ -175,6 +201,21 @@ public class Graph<T extends Comparable<T>> implements Iterable<T>, Serializable
 		}
 	}
 	
+	/**
+	 * Package private method to set the complete neighborhood of a vertex at once, used by the GraphFactory to build
+	 * graphs from edge lists without the cost of addEdge(). The caller is responsible for keeping the edge relation
+	 * symmetric and for providing the correct number of edges within the neighborhood.
+	 * @param v the vertex
+	 * @param neighborhood the neighborhood of v (used as is)
+	 * @param edges the number of edges in the neighborhood of v
+	 */
+	void setNeighborhood(T v, Set<T> neighborhood, int edges) {
+		Set<T> old = adjacencies.put(v, neighborhood);
+		if (old != null) m -= old.size();
+		m += neighborhood.size();
+		edgesInNeighborhood.put(v, edges);
+	}
+	
 	/**
 	 * Adds an directed edge (u,v) to the graph by adding the vertices to the neighborhood of the corresponding other vertex.
 	 * If u or v is not in the graph they will automatically be added.
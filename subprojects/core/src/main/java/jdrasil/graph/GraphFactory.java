@@ -19,15 +19,25 @@
 package jdrasil.graph;
 
 import java.io.BufferedReader;
+import java.io.ByteArrayInputStream;
 import java.io.File;
-import java.io.FileReader;
+import java.io.FileDescriptor;
+import java.io.FileInputStream;
 import java.io.IOException;
-import java.io.InputStreamReader;
+import java.io.InputStream;
+import java.io.SequenceInputStream;
+import java.nio.ByteBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.channels.ReadableByteChannel;
+import java.nio.file.StandardOpenOption;
 import java.io.ObjectInputStream.GetField;
 import java.security.GeneralSecurityException;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
+import java.util.HashSet;
 import java.util.Map;
 import java.util.Set;
 import java.util.logging.Logger;
@@ -125,6 +135,29 @@ public class GraphFactory {
 		return G;
 	}
 
+	/**
+	 * Construct a graph from the content of a .gr file given as channel, using the byte level GrParser.
+	 * If the "parallel" flag is set in JdrasilProperties and the channel is a FileChannel, the file is parsed in
+	 * chunks in parallel by the ParallelGrParser.
+	 * 
+	 * This method can also be used to parse .dgf files.
+	 * 
+	 * @param in - the channel storing the graph
+	 * @return A graph object with the graph (vertices are integer)
+	 * @throws IOException if the file was not found or is not correct encoded
+	 */
+	public static Graph<Integer> graphFromChannelGR(ReadableByteChannel in) throws IOException {
+		long t = System.currentTimeMillis();
+		if (in instanceof FileChannel && JdrasilProperties.containsKey("parallel")) {
+			ParallelGrParser parser = new ParallelGrParser((FileChannel) in).parse();
+			LOG.info("Parsed " + parser.getNumBytes() + " bytes in parallel in " + (System.currentTimeMillis()-t) + "ms");
+			return graphFromIntGraph(parser.toIntGraph());
+		}
+		GrParser parser = new GrParser(in).parse();
+		LOG.info("Parsed " + parser.getNumBytes() + " bytes in " + (System.currentTimeMillis()-t) + "ms");
+		return graphFromIntGraph(parser.toIntGraph());
+	}
+
 	/**
 	 * Construct a graph from a .gr file (as defined by PACE).
 	 * 
@@ -137,16 +170,15 @@ public class GraphFactory {
 	public static Graph<Integer> graphFromGr(File grFile) throws IOException {
 		
 		// read the graph
-		BufferedReader in = new BufferedReader(new FileReader(grFile));
-		Graph<Integer> G = graphFromBufferedReaderGR(in);
-		in.close();
-		
-		// done
-		return G;
+		try (FileChannel in = FileChannel.open(grFile.toPath(), StandardOpenOption.READ)) {
+			return graphFromChannelGR(in);
+		}
 	}
 	
 	/**
-	 * Construct a graph from the content of a .gr file read from stdin
+	 * Construct a graph from the content of a .gr file or of a binary snapshot (see GraphSnapshot) read from stdin.
+	 * The format is detected by the first bytes of the input. If stdin is redirected from a file, the bytes are peeked
+	 * without consuming them and a snapshot is memory-mapped.
 	 * 
 	 * This method can also be used to parse .dgf files.
 	 * 
@@ -154,13 +186,169 @@ public class GraphFactory {
 	 * @throws IOException if the file was not found or is not correct encoded
 	 */
 	public static Graph<Integer> graphFromStdin() throws IOException {
-		
+		FileChannel stdin = new FileInputStream(FileDescriptor.in).getChannel();
+		byte[] head = new byte[GraphSnapshot.MAGIC.length];
+		ReadableByteChannel in;
+		try {
+			// stdin is a regular file, peek at the first bytes
+			stdin.read(ByteBuffer.wrap(head), stdin.position());
+			in = stdin;
+		} catch (IOException e) {
+			// stdin is a pipe, read the first bytes and put them back in front of the stream
+			ByteBuffer buffer = ByteBuffer.wrap(head);
+			while (buffer.hasRemaining() && stdin.read(buffer) >= 0);
+			InputStream rest = Channels.newInputStream(stdin);
+			in = Channels.newChannel(new SequenceInputStream(new ByteArrayInputStream(head, 0, buffer.position()), rest));
+		}
+
 		// read the graph
-		BufferedReader in = new BufferedReader(new InputStreamReader(System.in));
-		Graph<Integer> G = graphFromBufferedReaderGR(in);
-		in.close();
-		
-		// done
+		if (GraphSnapshot.isSnapshot(head)) {
+			return snapshotFromChannel(in).toGraph();
+		}
+		return graphFromChannelGR(in);
+	}
+
+	/**
+	 * Load a binary snapshot (see GraphSnapshot) from a file. The file is memory-mapped, so loading is bound by I/O.
+	 * @param file the snapshot
+	 * @return the loaded snapshot
+	 * @throws IOException if the file can not be read or is not a valid snapshot
+	 */
+	public static GraphSnapshot snapshotFromFile(File file) throws IOException {
+		try (FileChannel in = FileChannel.open(file.toPath(), StandardOpenOption.READ)) {
+			return snapshotFromChannel(in);
+		}
+	}
+
+	/**
+	 * Construct a graph from a binary snapshot (see GraphSnapshot) stored in a file.
+	 * @param file the snapshot
+	 * @return A graph object with the graph (vertices are integer)
+	 * @throws IOException if the file can not be read or is not a valid snapshot
+	 */
+	public static Graph<Integer> graphFromSnapshot(File file) throws IOException {
+		return snapshotFromFile(file).toGraph();
+	}
+
+	/**
+	 * Load a binary snapshot (see GraphSnapshot) from a channel, starting at the current position of the channel.
+	 * If the channel is a FileChannel, the sections are memory-mapped instead of copied through a buffer.
+	 * @param in the channel storing the snapshot
+	 * @return the loaded snapshot
+	 * @throws IOException if the channel can not be read or does not store a valid snapshot
+	 */
+	public static GraphSnapshot snapshotFromChannel(ReadableByteChannel in) throws IOException {
+		long t = System.currentTimeMillis();
+
+		// read and check the header
+		ByteBuffer header = ByteBuffer.allocate(GraphSnapshot.HEADER_SIZE).order(GraphSnapshot.ORDER);
+		while (header.hasRemaining()) {
+			if (in.read(header) < 0) throw new IOException("Snapshot is truncated");
+		}
+		header.flip();
+		byte[] magic = new byte[GraphSnapshot.MAGIC.length];
+		header.get(magic);
+		if (!GraphSnapshot.isSnapshot(magic)) throw new IOException("Input is not a snapshot");
+		int version = header.getInt();
+		if (version != GraphSnapshot.VERSION) throw new IOException("Unsupported snapshot version " + version);
+		int flags = header.getInt();
+		if ((flags & ~GraphSnapshot.FLAG_EDGES_IN_NEIGHBORHOOD) != 0) throw new IOException("Unsupported snapshot sections " + flags);
+		int n = header.getInt();
+		long entries = header.getLong();
+		if (n < 0 || entries < 0 || entries > Integer.MAX_VALUE - 8) throw new IOException("Snapshot header is corrupted");
+
+		// read the sections
+		int[] labels = readInts(in, new int[n]);
+		int[] offsets = readInts(in, new int[n+1]);
+		int[] targets = readInts(in, new int[(int) entries]);
+		int[] edgesInNeighborhood = null;
+		if ((flags & GraphSnapshot.FLAG_EDGES_IN_NEIGHBORHOOD) != 0) edgesInNeighborhood = readInts(in, new int[n]);
+
+		// a corrupted snapshot should fail here and not somewhere in an algorithm
+		if (offsets[0] != 0 || offsets[n] != entries) throw new IOException("Snapshot offsets are corrupted");
+		for (int v = 0; v < n; v++) {
+			if (offsets[v] > offsets[v+1]) throw new IOException("Snapshot offsets are corrupted");
+		}
+		for (int w : targets) {
+			if (w < 0 || w >= n) throw new IOException("Snapshot neighborhoods are corrupted");
+		}
+
+		LOG.info("Loaded snapshot with " + n + " vertices in " + (System.currentTimeMillis()-t) + "ms");
+		IntGraph<Integer> graph = new IntGraph<>(GraphSnapshot.toVertices(labels), offsets, targets);
+		return new GraphSnapshot(graph, edgesInNeighborhood);
+	}
+
+	/** Maximal number of bytes that are mapped or buffered at once while reading a snapshot. */
+	private static final int SNAPSHOT_WINDOW = 1 << 26;
+
+	/**
+	 * Fill the given array with little-endian ints read from the channel. FileChannels are memory-mapped in windows
+	 * and their position is advanced behind the read data, other channels are read through a direct buffer.
+	 * @param in the channel
+	 * @param array the array to be filled
+	 * @return the filled array
+	 * @throws IOException if the channel ends before the array is full
+	 */
+	private static int[] readInts(ReadableByteChannel in, int[] array) throws IOException {
+		int done = 0;
+		if (in instanceof FileChannel) {
+			FileChannel file = (FileChannel) in;
+			long position = file.position();
+			if (file.size() - position < 4L*array.length) throw new IOException("Snapshot is truncated");
+			while (done < array.length) {
+				int count = Math.min(array.length - done, SNAPSHOT_WINDOW / 4);
+				MappedByteBuffer window = file.map(FileChannel.MapMode.READ_ONLY, position, 4L*count);
+				window.order(GraphSnapshot.ORDER).asIntBuffer().get(array, done, count);
+				position += 4L*count;
+				done += count;
+			}
+			file.position(position);
+			return array;
+		}
+		ByteBuffer buffer = ByteBuffer.allocateDirect((int) Math.min(SNAPSHOT_WINDOW, 4L*array.length + 4)).order(GraphSnapshot.ORDER);
+		while (done < array.length) {
+			buffer.clear();
+			buffer.limit((int) Math.min(buffer.capacity(), 4L*(array.length - done)));
+			while (buffer.hasRemaining()) {
+				if (in.read(buffer) < 0) throw new IOException("Snapshot is truncated");
+			}
+			buffer.flip();
+			int count = buffer.remaining() / 4;
+			buffer.asIntBuffer().get(array, done, count);
+			done += count;
+		}
+		return array;
+	}
+	
+	/**
+	 * Construct a graph from an IntGraph. The neighborhoods are created with their final size and the number of edges
+	 * in every neighborhood is computed on the compressed representation, so this is much faster than adding the
+	 * edges one by one.
+	 * @param graph the compressed graph
+	 * @return a graph with the same vertices and edges
+	 */
+	public static <T extends Comparable<T>> Graph<T> graphFromIntGraph(IntGraph<T> graph) {
+		return graphFromIntGraph(graph, graph.getEdgesInNeighborhoods());
+	}
+
+	/**
+	 * Construct a graph from an IntGraph for which the number of edges in every neighborhood is already known,
+	 * for instance because it was stored in a snapshot.
+	 * @param graph the compressed graph
+	 * @param edges the number of edges in the neighborhood of every vertex id
+	 * @return a graph with the same vertices and edges
+	 */
+	public static <T extends Comparable<T>> Graph<T> graphFromIntGraph(IntGraph<T> graph, int[] edges) {
+		int n = graph.getNumVertices();
+		Graph<T> G = new Graph<>(n);
+		int[] targets = graph.getTargets();
+		for (int v = 0; v < n; v++) {
+			Set<T> neighborhood = new HashSet<>((int) (graph.getDegree(v) / 0.75f) + 1);
+			for (int i = graph.neighborhoodStart(v); i < graph.neighborhoodEnd(v); i++) {
+				neighborhood.add(graph.getVertex(targets[i]));
+			}
+			G.setNeighborhood(graph.getVertex(v), neighborhood, edges[v]);
+		}
 		return G;
 	}
 	
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.graph;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * A graph in the binary snapshot format of Jdrasil. A snapshot stores the compressed sparse row representation of a
+ * graph together with optional precomputed data, so that large graphs can be reloaded without parsing and without
+ * recomputing the number of edges in every neighborhood. Snapshots are written with GraphWriter.writeSnapshot() and
+ * loaded (memory-mapped if possible) with GraphFactory.snapshotFromFile() or GraphFactory.snapshotFromChannel().
+ *
+ * All values are stored little-endian. The file starts with a header of 32 bytes:
+ *  - the magic bytes "JDGS",
+ *  - the version of the format (int),
+ *  - flags describing the optional sections (int),
+ *  - the number of vertices n (int),
+ *  - the length of the target array, i.e., 2m (long),
+ *  - 8 reserved bytes.
+ * The header is followed by the sections:
+ *  - the labels of the vertices (int[n], sorted),
+ *  - the offsets of the neighborhoods (int[n+1]),
+ *  - the concatenated sorted neighborhoods (int[2m]),
+ *  - if FLAG_EDGES_IN_NEIGHBORHOOD is set: the number of edges in every neighborhood (int[n]).
+ * Other flags are not defined, a snapshot with unknown flags is rejected by the loader.
+ *
+ * @author Max Bannach
+ */
+public class GraphSnapshot {
+
+	/** The magic bytes at the start of every snapshot. */
+	static final byte[] MAGIC = { 'J', 'D', 'G', 'S' };
+
+	/** The version of the format. */
+	static final int VERSION = 1;
+
+	/** The size of the header in bytes. */
+	static final int HEADER_SIZE = 32;
+
+	/** Byte order of all stored values. */
+	static final ByteOrder ORDER = ByteOrder.LITTLE_ENDIAN;
+
+	/** Flag for the section storing the number of edges in every neighborhood. */
+	static final int FLAG_EDGES_IN_NEIGHBORHOOD = 1;
+
+	/** The stored graph. */
+	private final IntGraph<Integer> graph;
+
+	/** The number of edges in the neighborhood of every vertex, or null. */
+	private final int[] edgesInNeighborhood;
+
+	/**
+	 * Create a snapshot of the given graph.
+	 * @param graph the graph to be stored
+	 * @param precompute if true, the number of edges in every neighborhood is computed and stored
+	 */
+	public GraphSnapshot(IntGraph<Integer> graph, boolean precompute) {
+		this(graph, precompute ? graph.getEdgesInNeighborhoods() : null);
+	}
+
+	/**
+	 * Create a snapshot from its parts, used by the loader.
+	 * @param graph the stored graph
+	 * @param edgesInNeighborhood the number of edges in every neighborhood, or null
+	 */
+	GraphSnapshot(IntGraph<Integer> graph, int[] edgesInNeighborhood) {
+		this.graph = graph;
+		this.edgesInNeighborhood = edgesInNeighborhood;
+	}
+
+	/**
+	 * Checks if the given bytes start with the magic bytes of a snapshot.
+	 * @param head the first bytes of an input
+	 * @return true if the input is a snapshot
+	 */
+	public static boolean isSnapshot(byte[] head) {
+		if (head.length < MAGIC.length) return false;
+		for (int i = 0; i < MAGIC.length; i++) {
+			if (head[i] != MAGIC[i]) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Builds the header of this snapshot.
+	 * @return a buffer storing the header, ready to be written
+	 */
+	ByteBuffer getHeader() {
+		ByteBuffer header = ByteBuffer.allocate(HEADER_SIZE).order(ORDER);
+		header.put(MAGIC);
+		header.putInt(VERSION);
+		header.putInt(getFlags());
+		header.putInt(graph.getNumVertices());
+		header.putLong(graph.getTargets().length);
+		header.putLong(0);
+		header.flip();
+		return header;
+	}
+
+	/**
+	 * The flags describing the optional sections of this snapshot.
+	 * @return the flags
+	 */
+	int getFlags() {
+		int flags = 0;
+		if (edgesInNeighborhood != null) flags |= FLAG_EDGES_IN_NEIGHBORHOOD;
+		return flags;
+	}
+
+	/**
+	 * The labels of the vertices, i.e., the original vertex of every id.
+	 * @return an array storing the label of every vertex id
+	 */
+	int[] getLabels() {
+		int[] labels = new int[graph.getNumVertices()];
+		for (int v = 0; v < labels.length; v++) labels[v] = graph.getVertex(v);
+		return labels;
+	}
+
+	/**
+	 * Turn the labels of a snapshot into the vertex list of an IntGraph.
+	 * @param labels the stored labels
+	 * @return the vertices
+	 */
+	static List<Integer> toVertices(int[] labels) {
+		List<Integer> vertices = new ArrayList<>(labels.length);
+		for (int label : labels) vertices.add(label);
+		return vertices;
+	}
+
+	/**
+	 * The stored graph.
+	 * @return the graph
+	 */
+	public IntGraph<Integer> getGraph() {
+		return graph;
+	}
+
+	/**
+	 * The stored number of edges in the neighborhood of every vertex id.
+	 * @return the precomputed values, or null if they are not stored
+	 */
+	public int[] getEdgesInNeighborhood() {
+		return edgesInNeighborhood;
+	}
+
+	/**
+	 * Converts the snapshot into a Graph, using the precomputed values if they are available.
+	 * @return the stored graph as Graph
+	 */
+	public Graph<Integer> toGraph() {
+		return edgesInNeighborhood != null
+				? GraphFactory.graphFromIntGraph(graph, edgesInNeighborhood)
+				: GraphFactory.graphFromIntGraph(graph);
+	}
+}
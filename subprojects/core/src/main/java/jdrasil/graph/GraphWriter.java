@@ -19,9 +19,19 @@
 package jdrasil.graph;
 
 import java.io.BufferedWriter;
+import java.io.File;
+import java.io.FileDescriptor;
+import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.OutputStream;
 import java.io.OutputStreamWriter;
+import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.channels.WritableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.StandardOpenOption;
 import java.util.HashMap;
 import java.util.Map;
 
@@ -32,6 +42,12 @@ import java.util.Map;
  */
 public class GraphWriter {
 
+	/** Size of the buffer used to stream tree decompositions. */
+	private static final int STREAM_BUFFER_SIZE = 1 << 16;
+
+	/** Free space that has to be available in the buffer before a token (a line prefix or a number) is written. */
+	private static final int MAX_TOKEN_SIZE = 32;
+
 	// hide the constructor
 	private GraphWriter() {}
 	
@@ -126,25 +142,150 @@ public class GraphWriter {
 	}
 	
 	/**
-	 * Write the string of @see treedecompositionToString to System.out.
+	 * Write the tree decomposition in the format of @see treedecompositionToString to the standard output, followed by
+	 * a line break. The decomposition is streamed with @see writeTreeDecomposition(TreeDecomposition, WritableByteChannel)
+	 * directly to the file descriptor, after System.out was flushed.
 	 * @param td the tree decomposition to be written
 	 * @throws IOException
 	 */
 	public static <T extends Comparable<T>> void writeTreeDecomposition(TreeDecomposition<T> td) throws IOException {
-		writeTreeDecomposition(td, System.out);
+		System.out.flush();
+		writeTreeDecomposition(td, new FileOutputStream(FileDescriptor.out).getChannel()); // do not close the stream, it would close stdout
 	}
 	
 	/**
-	 * Write the string of @see treedecompositionToString to the given output stream.
+	 * Write the tree decomposition in the format of @see treedecompositionToString to the given output stream,
+	 * followed by a line break. The stream will be closed.
 	 * @param td the tree decomposition to be written
 	 * @param stream to which the graph should be written
 	 * @throws IOException
 	 */
 	public static <T extends Comparable<T>> void writeTreeDecomposition(TreeDecomposition<T> td, OutputStream stream) throws IOException {
-		BufferedWriter out = new BufferedWriter(new OutputStreamWriter(stream));
-		out.write(treedecompositionToString(td));
-		out.flush();
-		out.close();
+		writeTreeDecomposition(td, Channels.newChannel(stream));
+		stream.flush();
+		stream.close();
+	}
+
+	/**
+	 * Stream the tree decomposition in the format of @see treedecompositionToString, followed by a line break, into the
+	 * given channel. Bags and tree edges are written one by one through a fixed buffer and integers are formatted
+	 * directly into it, so no string of the whole decomposition is created.
+	 * @param td the tree decomposition to be written
+	 * @param out the channel, which is not closed
+	 * @throws IOException
+	 */
+	public static <T extends Comparable<T>> void writeTreeDecomposition(TreeDecomposition<T> td, WritableByteChannel out) throws IOException {
+		ByteBuffer buffer = ByteBuffer.allocateDirect(STREAM_BUFFER_SIZE);
+
+		// print solution line
+		putASCII(buffer, "s td ");
+		putDecimal(buffer, td.numberOfBags);
+		buffer.put((byte) ' ');
+		putDecimal(buffer, td.width+1);
+		buffer.put((byte) ' ');
+		putDecimal(buffer, td.n);
+
+		// print the bags
+		for (Bag<T> bag : td.tree) {
+			ensureRemaining(buffer, out);
+			buffer.put((byte) '\n').put((byte) 'b').put((byte) ' ');
+			putDecimal(buffer, bag.id);
+			for (T v : bag.vertices) {
+				ensureRemaining(buffer, out);
+				buffer.put((byte) ' ');
+				if (v instanceof Integer) {
+					putDecimal(buffer, (Integer) v);
+				} else {
+					putBytes(buffer, out, String.valueOf(v).getBytes(StandardCharsets.UTF_8));
+				}
+			}
+		}
+
+		// print the edges
+		for (Bag<T> v : td.tree) {
+			for (Bag<T> w : td.tree.getNeighborhood(v)) {
+				if (v.id >= w.id) continue;
+				ensureRemaining(buffer, out);
+				buffer.put((byte) '\n');
+				putDecimal(buffer, v.id);
+				buffer.put((byte) ' ');
+				putDecimal(buffer, w.id);
+			}
+		}
+		ensureRemaining(buffer, out);
+		buffer.put((byte) '\n');
+
+		// done
+		drain(buffer, out);
+	}
+
+	/**
+	 * Write the content of the buffer into the channel and clear it.
+	 * @param buffer the buffer in write mode
+	 * @param out the channel
+	 * @throws IOException
+	 */
+	private static void drain(ByteBuffer buffer, WritableByteChannel out) throws IOException {
+		buffer.flip();
+		while (buffer.hasRemaining()) out.write(buffer);
+		buffer.clear();
+	}
+
+	/**
+	 * Drain the buffer if there is no space for a further token.
+	 * @param buffer the buffer in write mode
+	 * @param out the channel
+	 * @throws IOException
+	 */
+	private static void ensureRemaining(ByteBuffer buffer, WritableByteChannel out) throws IOException {
+		if (buffer.remaining() < MAX_TOKEN_SIZE) drain(buffer, out);
+	}
+
+	/**
+	 * Put an ASCII string that fits into the buffer.
+	 * @param buffer the buffer in write mode
+	 * @param s the string
+	 */
+	private static void putASCII(ByteBuffer buffer, String s) {
+		for (int i = 0; i < s.length(); i++) buffer.put((byte) s.charAt(i));
+	}
+
+	/**
+	 * Put arbitrary many bytes, draining the buffer as often as needed.
+	 * @param buffer the buffer in write mode
+	 * @param out the channel
+	 * @param bytes the bytes to be written
+	 * @throws IOException
+	 */
+	private static void putBytes(ByteBuffer buffer, WritableByteChannel out, byte[] bytes) throws IOException {
+		int done = 0;
+		while (done < bytes.length) {
+			if (!buffer.hasRemaining()) drain(buffer, out);
+			int count = Math.min(buffer.remaining(), bytes.length - done);
+			buffer.put(bytes, done, count);
+			done += count;
+		}
+	}
+
+	/**
+	 * Format an integer in decimal directly into the buffer, which must have at least 11 bytes left.
+	 * @param buffer the buffer in write mode
+	 * @param value the integer
+	 */
+	private static void putDecimal(ByteBuffer buffer, int value) {
+		long x = value;
+		if (x < 0) {
+			buffer.put((byte) '-');
+			x = -x;
+		}
+		int digits = 1;
+		for (long p = 10; p <= x; p *= 10) digits++;
+		int start = buffer.position();
+		for (int i = start + digits - 1; i >= start; i--) {
+			buffer.put(i, (byte) ('0' + x % 10));
+			x /= 10;
+		}
+		buffer.position(start + digits);
 	}
 	
 	/**
@@ -294,4 +435,58 @@ public class GraphWriter {
 		out.close();
 	}
 	
+
+	/**
+	 * Write the given graph as binary snapshot (see GraphSnapshot) into a file, including the precomputed number of
+	 * edges in every neighborhood. The snapshot can be loaded with GraphFactory.snapshotFromFile()
+	 * and is detected automatically by GraphFactory.graphFromStdin().
+	 * @param graph the graph to be written
+	 * @param file the file in which the snapshot is stored, an existing file is overwritten
+	 * @throws IOException
+	 */
+	public static void writeSnapshot(Graph<Integer> graph, File file) throws IOException {
+		try (FileChannel out = FileChannel.open(file.toPath(), StandardOpenOption.CREATE, StandardOpenOption.WRITE, StandardOpenOption.TRUNCATE_EXISTING)) {
+			writeSnapshot(new GraphSnapshot(new IntGraph<>(graph), true), out);
+		}
+	}
+
+	/**
+	 * Write a binary snapshot to the given channel.
+	 * @param snapshot the snapshot to be written
+	 * @param out the channel, which is not closed
+	 * @throws IOException
+	 */
+	public static void writeSnapshot(GraphSnapshot snapshot, WritableByteChannel out) throws IOException {
+		ByteBuffer header = snapshot.getHeader();
+		while (header.hasRemaining()) out.write(header);
+		ByteBuffer buffer = ByteBuffer.allocateDirect(1 << 20).order(GraphSnapshot.ORDER);
+		IntGraph<Integer> graph = snapshot.getGraph();
+		int n = graph.getNumVertices();
+		int[] offsets = new int[n+1];
+		for (int v = 0; v < n; v++) offsets[v+1] = graph.neighborhoodEnd(v);
+		writeInts(snapshot.getLabels(), buffer, out);
+		writeInts(offsets, buffer, out);
+		writeInts(graph.getTargets(), buffer, out);
+		if (snapshot.getEdgesInNeighborhood() != null) writeInts(snapshot.getEdgesInNeighborhood(), buffer, out);
+	}
+
+	/**
+	 * Write an int array through the given buffer into a channel.
+	 * @param array the values to be written
+	 * @param buffer a buffer with the byte order of the snapshot format
+	 * @param out the channel
+	 * @throws IOException
+	 */
+	private static void writeInts(int[] array, ByteBuffer buffer, WritableByteChannel out) throws IOException {
+		int done = 0;
+		while (done < array.length) {
+			buffer.clear();
+			IntBuffer ints = buffer.asIntBuffer();
+			int count = Math.min(ints.remaining(), array.length - done);
+			ints.put(array, done, count);
+			buffer.limit(4*count);
+			while (buffer.hasRemaining()) out.write(buffer);
+			done += count;
+		}
+	}
 }
@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.graph;
+
+import java.io.Serializable;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * An immutable graph with vertices \(\{0,\dots,n-1\}\) stored in compressed sparse row format: the neighbors of
+ * vertex v are stored in targets[offsets[v]] to targets[offsets[v+1]-1], sorted in ascending order.
+ *
+ * This representation is meant for algorithms that only read a graph, as it has no per vertex objects and
+ * neighborhoods can be scanned without iterators or boxing. Adjacency tests use a binary search and cost \(O(\log\delta(v))\).
+ *
+ * An IntGraph is constructed from a Graph and remembers the original vertices. Vertex ids follow the natural order of
+ * the original vertices, so the id of a vertex is deterministic. The graph can be converted back with toGraph().
+ *
+ * @param <T> the type of the vertices of the original graph
+ * @author Max Bannach
+ */
+public class IntGraph<T extends Comparable<T>> implements Serializable {
+
+	private static final long serialVersionUID = 2946209436217339431L;
+
+	/** The number of vertices. */
+	private final int n;
+
+	/** The neighbors of v are stored in targets[offsets[v]..offsets[v+1]-1]. */
+	private final int[] offsets;
+
+	/** The concatenated, sorted neighborhoods of all vertices. */
+	private final int[] targets;
+
+	/** Maps the id of a vertex to the vertex of the original graph. */
+	private final List<T> vertices;
+
+	/** Maps the vertices of the original graph to their id. */
+	private final Map<T, Integer> ids;
+
+	/**
+	 * Creates the IntGraph of the given (undirected) graph. Self loops are removed.
+	 * @param graph the graph to be represented
+	 */
+	public IntGraph(Graph<T> graph) {
+		this.vertices = new ArrayList<>(graph.getCopyOfVertices());
+		Collections.sort(vertices);
+		this.n = vertices.size();
+		this.ids = new HashMap<>(2*n);
+		for (int v = 0; v < n; v++) ids.put(vertices.get(v), v);
+
+		// compute offsets from the degrees
+		this.offsets = new int[n+1];
+		for (int v = 0; v < n; v++) {
+			Set<T> N = graph.getNeighborhood(vertices.get(v));
+			offsets[v+1] = offsets[v] + N.size() - (N.contains(vertices.get(v)) ? 1 : 0);
+		}
+
+		// fill and sort the neighborhoods
+		this.targets = new int[offsets[n]];
+		for (int v = 0; v < n; v++) {
+			int i = offsets[v];
+			for (T w : graph.getNeighborhood(vertices.get(v))) if (!w.equals(vertices.get(v))) targets[i++] = ids.get(w);
+			Arrays.sort(targets, offsets[v], offsets[v+1]);
+		}
+	}
+
+	/**
+	 * Creates an IntGraph directly from its compressed sparse row representation. The vertices have to be sorted and
+	 * the neighborhoods have to be sorted and free of duplicates.
+	 * @param vertices the original vertices, vertex v gets id v
+	 * @param offsets the offsets of the neighborhoods (size n+1)
+	 * @param targets the concatenated neighborhoods
+	 */
+	IntGraph(List<T> vertices, int[] offsets, int[] targets) {
+		this.vertices = vertices;
+		this.n = vertices.size();
+		this.ids = new HashMap<>(2*n);
+		for (int v = 0; v < n; v++) ids.put(vertices.get(v), v);
+		this.offsets = offsets;
+		this.targets = targets;
+	}
+
+	/**
+	 * Creates the IntGraph over the vertices \(\{1,\dots,n\}\) (as used by .gr files) from a list of edges. Vertex v
+	 * gets the id v-1. Self loops and multiple edges are removed.
+	 * @param n the number of vertices
+	 * @param edges the endpoints of the edges, edge i is {edges[2i], edges[2i+1]}
+	 * @param numEdges the number of edges stored in the array
+	 * @return the graph
+	 */
+	static IntGraph<Integer> fromEdges(int n, int[] edges, int numEdges) {
+		// count the degrees
+		int[] offsets = new int[n+1];
+		for (int i = 0; i < 2*numEdges; i += 2) {
+			if (edges[i] == edges[i+1]) continue;
+			offsets[edges[i]]++; // vertex v has id v-1, so this is offsets[id+1]
+			offsets[edges[i+1]]++;
+		}
+		for (int v = 0; v < n; v++) offsets[v+1] += offsets[v];
+
+		// place the edges
+		int[] next = Arrays.copyOf(offsets, n);
+		int[] targets = new int[offsets[n]];
+		for (int i = 0; i < 2*numEdges; i += 2) {
+			int u = edges[i]-1, w = edges[i+1]-1;
+			if (u == w) continue;
+			targets[next[u]++] = w;
+			targets[next[w]++] = u;
+		}
+
+		// sort the neighborhoods and remove duplicates in place
+		int size = 0;
+		for (int v = 0; v < n; v++) {
+			int start = offsets[v], end = offsets[v+1];
+			Arrays.sort(targets, start, end);
+			offsets[v] = size;
+			for (int i = start; i < end; i++) {
+				if (size > offsets[v] && targets[size-1] == targets[i]) continue;
+				targets[size++] = targets[i];
+			}
+		}
+		offsets[n] = size;
+		if (size < targets.length) targets = Arrays.copyOf(targets, size);
+
+		List<Integer> vertices = new ArrayList<>(n);
+		for (int v = 1; v <= n; v++) vertices.add(v);
+		return new IntGraph<>(vertices, offsets, targets);
+	}
+
+	/**
+	 * Converts this graph back to a Graph over the original vertices.
+	 * @return a new graph with the same edge relation
+	 */
+	public Graph<T> toGraph() {
+		return GraphFactory.graphFromIntGraph(this);
+	}
+
+	/**
+	 * The number of vertices of the graph.
+	 * @return n
+	 */
+	public int getNumVertices() {
+		return n;
+	}
+
+	/**
+	 * The number of (undirected) edges of the graph.
+	 * @return m
+	 */
+	public int getNumberOfEdges() {
+		return targets.length / 2;
+	}
+
+	/**
+	 * Returns the vertex of the original graph with the given id.
+	 * @param v the id of a vertex
+	 * @return the original vertex
+	 */
+	public T getVertex(int v) {
+		return vertices.get(v);
+	}
+
+	/**
+	 * Returns the id of a vertex of the original graph.
+	 * @param v a vertex of the original graph
+	 * @return the id of v or -1 if v is not in the graph
+	 */
+	public int getId(T v) {
+		Integer id = ids.get(v);
+		return id == null ? -1 : id;
+	}
+
+	/**
+	 * The degree of a vertex.
+	 * @param v the id of a vertex
+	 * @return \(\delta(v)\)
+	 */
+	public int getDegree(int v) {
+		return offsets[v+1] - offsets[v];
+	}
+
+	/**
+	 * Compute the maximum degree of this graph.
+	 * @return Delta(G)
+	 */
+	public int getMaxDegree() {
+		int max = 0;
+		for (int v = 0; v < n; v++) max = Math.max(max, getDegree(v));
+		return max;
+	}
+
+	/**
+	 * The first index of the neighborhood of v in the array returned by getTargets().
+	 * @param v the id of a vertex
+	 * @return the start of N(v)
+	 */
+	public int neighborhoodStart(int v) {
+		return offsets[v];
+	}
+
+	/**
+	 * The index behind the last neighbor of v in the array returned by getTargets().
+	 * @param v the id of a vertex
+	 * @return the end (exclusive) of N(v)
+	 */
+	public int neighborhoodEnd(int v) {
+		return offsets[v+1];
+	}
+
+	/**
+	 * The concatenated neighborhoods of all vertices. This is the internal array of the graph and must not be modified.
+	 * @return the target array of the graph
+	 */
+	public int[] getTargets() {
+		return targets;
+	}
+
+	/**
+	 * Returns a copy of the neighborhood of v.
+	 * @param v the id of a vertex
+	 * @return the sorted neighbors of v
+	 */
+	public int[] getNeighborhood(int v) {
+		return Arrays.copyOfRange(targets, offsets[v], offsets[v+1]);
+	}
+
+	/**
+	 * Check if two vertices are adjacent using a binary search in the neighborhood of u.
+	 * @param u the id of the first vertex
+	 * @param v the id of the second vertex
+	 * @return true if {u,v} is an edge
+	 */
+	public boolean isAdjacent(int u, int v) {
+		return Arrays.binarySearch(targets, offsets[u], offsets[u+1], v) >= 0;
+	}
+
+	/**
+	 * Computes the number of edges in the neighborhood of every vertex.
+	 * The edges within a neighborhood N(v) are counted by marking N(v) and scanning the neighborhoods of its members.
+	 * @return an array storing the number of edges in N(v) for every vertex v
+	 */
+	public int[] getEdgesInNeighborhoods() {
+		int[] edges = new int[n];
+		int[] mark = new int[n];
+		for (int v = 0; v < n; v++) {
+			int stamp = v+1;
+			for (int i = offsets[v]; i < offsets[v+1]; i++) mark[targets[i]] = stamp;
+			for (int i = offsets[v]; i < offsets[v+1]; i++) {
+				int u = targets[i];
+				for (int j = offsets[u+1]-1; j >= offsets[u] && targets[j] > u; j--) {
+					if (mark[targets[j]] == stamp) edges[v]++;
+				}
+			}
+		}
+		return edges;
+	}
+
+	/**
+	 * Computes the fill-in value of every vertex, i.e., the number of edges the elimination of the vertex would add.
+	 * @return an array storing the fill-in value of every vertex
+	 */
+	public int[] getFillInValues() {
+		int[] fill = getEdgesInNeighborhoods();
+		for (int v = 0; v < n; v++) {
+			long delta = getDegree(v);
+			fill[v] = (int) ((delta*delta-delta)/2 - fill[v]);
+		}
+		return fill;
+	}
+
+	/**
+	 * Computes a degeneracy order of the graph with the bucket algorithm of Matula and Beck in time \(O(n+m)\), i.e.,
+	 * an order in which every vertex has at most d neighbors after it, where d is the degeneracy of the graph.
+	 * @return the ids of the vertices in degeneracy order
+	 */
+	public int[] getDegeneracyOrder() {
+		int[] degree = new int[n];
+		int maxDegree = 0;
+		for (int v = 0; v < n; v++) {
+			degree[v] = getDegree(v);
+			maxDegree = Math.max(maxDegree, degree[v]);
+		}
+
+		// bucket sort the vertices by degree, bin[d] is the start of the bucket of degree d
+		int[] bin = new int[maxDegree+1];
+		for (int v = 0; v < n; v++) bin[degree[v]]++;
+		for (int d = 0, start = 0; d <= maxDegree; d++) {
+			int size = bin[d];
+			bin[d] = start;
+			start += size;
+		}
+		int[] order = new int[n];
+		int[] position = new int[n];
+		for (int v = 0; v < n; v++) {
+			position[v] = bin[degree[v]]++;
+			order[position[v]] = v;
+		}
+		for (int d = maxDegree; d > 0; d--) bin[d] = bin[d-1];
+		bin[0] = 0;
+
+		// remove the vertices in order and move their neighbors one bucket down
+		for (int i = 0; i < n; i++) {
+			int v = order[i];
+			for (int j = offsets[v]; j < offsets[v+1]; j++) {
+				int u = targets[j];
+				if (degree[u] <= degree[v]) continue;
+				int w = order[bin[degree[u]]];
+				if (u != w) {
+					order[position[u]] = w;
+					order[bin[degree[u]]] = u;
+					position[w] = position[u];
+					position[u] = bin[degree[u]];
+				}
+				bin[degree[u]]++;
+				degree[u]--;
+			}
+		}
+		return order;
+	}
+
+	/**
+	 * Computes a breadth-first order of the graph. Every connected component is traversed from its vertex with the
+	 * smallest id, and neighbors are visited in ascending order of their ids.
+	 * @return the ids of the vertices in BFS order
+	 */
+	public int[] getBreadthFirstOrder() {
+		int[] start = new int[n];
+		for (int v = 0; v < n; v++) start[v] = v;
+		return breadthFirstOrder(start, null);
+	}
+
+	/**
+	 * Computes the reverse Cuthill-McKee order of the graph, i.e., a BFS order in which every component is traversed
+	 * from a vertex of minimum degree and the new neighbors of a vertex are visited in ascending order of their degrees,
+	 * reversed. Ordering the vertices this way keeps the ids of adjacent vertices close together (it reduces the
+	 * bandwidth of the adjacency matrix).
+	 * @return the ids of the vertices in reverse Cuthill-McKee order
+	 */
+	public int[] getReverseCuthillMcKeeOrder() {
+		// counting sort of the vertices by degree, rank[v] is the position of v in this order
+		int maxDegree = getMaxDegree();
+		int[] bin = new int[maxDegree+2];
+		for (int v = 0; v < n; v++) bin[getDegree(v)+1]++;
+		for (int d = 0; d <= maxDegree; d++) bin[d+1] += bin[d];
+		int[] byDegree = new int[n];
+		int[] rank = new int[n];
+		for (int v = 0; v < n; v++) {
+			rank[v] = bin[getDegree(v)]++;
+			byDegree[rank[v]] = v;
+		}
+
+		int[] order = breadthFirstOrder(byDegree, rank);
+		for (int i = 0, j = n-1; i < j; i++, j--) {
+			int tmp = order[i];
+			order[i] = order[j];
+			order[j] = tmp;
+		}
+		return order;
+	}
+
+	/**
+	 * BFS over all components, which are started in the order given by start.
+	 * @param start all vertex ids in the order in which they are tried as start of a new component
+	 * @param rank if not null, the new neighbors of a vertex are visited in ascending order of their rank
+	 * @return the ids of the vertices in BFS order
+	 */
+	private int[] breadthFirstOrder(int[] start, int[] rank) {
+		int[] order = new int[n];
+		boolean[] visited = new boolean[n];
+		int size = 0;
+		for (int s : start) {
+			if (visited[s]) continue;
+			visited[s] = true;
+			order[size++] = s;
+			for (int head = size-1; head < size; head++) {
+				int v = order[head];
+				int first = size;
+				for (int i = offsets[v]; i < offsets[v+1]; i++) {
+					int u = targets[i];
+					if (visited[u]) continue;
+					visited[u] = true;
+					order[size++] = u;
+				}
+				if (rank != null) { // sort the new vertices by replacing them with their rank
+					for (int i = first; i < size; i++) order[i] = rank[order[i]];
+					Arrays.sort(order, first, size);
+					for (int i = first; i < size; i++) order[i] = start[order[i]];
+				}
+			}
+		}
+		return order;
+	}
+
+	/**
+	 * Renames the vertices of the graph according to the given order: the vertex with id order[i] becomes vertex i+1
+	 * (with id i) of the new graph, which has the vertices \(\{1,\dots,n\}\) as used by .gr files.
+	 * @param order a permutation of the vertex ids, for instance computed by getReverseCuthillMcKeeOrder()
+	 * @return the relabeled graph
+	 */
+	public IntGraph<Integer> relabel(int[] order) {
+		int[] rank = new int[n];
+		for (int i = 0; i < n; i++) rank[order[i]] = i;
+		int[] newOffsets = new int[n+1];
+		int[] newTargets = new int[targets.length];
+		for (int i = 0; i < n; i++) {
+			int v = order[i];
+			int size = newOffsets[i];
+			for (int j = offsets[v]; j < offsets[v+1]; j++) newTargets[size++] = rank[targets[j]];
+			Arrays.sort(newTargets, newOffsets[i], size);
+			newOffsets[i+1] = size;
+		}
+		List<Integer> vertices = new ArrayList<>(n);
+		for (int v = 1; v <= n; v++) vertices.add(v);
+		return new IntGraph<>(vertices, newOffsets, newTargets);
+	}
+
+	/**
+	 * Computes the connected components of the graph without the given vertices using a DFS with an explicit stack.
+	 * Components are numbered from 0 on, removed vertices get the label -1.
+	 * @param removed a mask of vertices that should be ignored, or null
+	 * @param component the array in which the label of every vertex is stored (size at least n)
+	 * @return the number of components
+	 */
+	public int getConnectedComponents(boolean[] removed, int[] component) {
+		Arrays.fill(component, 0, n, -1);
+		int[] stack = new int[n];
+		int count = 0;
+		for (int s = 0; s < n; s++) {
+			if (component[s] >= 0 || (removed != null && removed[s])) continue;
+			int top = 0;
+			stack[top++] = s;
+			component[s] = count;
+			while (top > 0) {
+				int v = stack[--top];
+				for (int i = offsets[v]; i < offsets[v+1]; i++) {
+					int w = targets[i];
+					if (component[w] >= 0 || (removed != null && removed[w])) continue;
+					component[w] = count;
+					stack[top++] = w;
+				}
+			}
+			count++;
+		}
+		return count;
+	}
+
+	/**
+	 * Computes the number of connected components of the graph.
+	 * @return the number of components
+	 */
+	public int getNumberOfConnectedComponents() {
+		return getConnectedComponents(null, new int[n]);
+	}
+
+	/**
+	 * Computes the connected components of the graph without the vertices in S as graphs over the original vertices.
+	 * @param S a set of original vertices that are removed from the graph
+	 * @return the induced subgraphs of the connected components of G[V\S]
+	 */
+	public List<Graph<T>> getComponentsAsSubgraphs(Set<T> S) {
+		boolean[] removed = new boolean[n];
+		for (T s : S) {
+			int v = getId(s);
+			if (v >= 0) removed[v] = true;
+		}
+		int[] component = new int[n];
+		int count = getConnectedComponents(removed, component);
+
+		List<Graph<T>> subgraphs = new ArrayList<>(count);
+		for (int c = 0; c < count; c++) subgraphs.add(GraphFactory.emptyGraph());
+		for (int v = 0; v < n; v++) {
+			if (component[v] >= 0) subgraphs.get(component[v]).addVertex(vertices.get(v));
+		}
+		for (int v = 0; v < n; v++) {
+			if (component[v] < 0) continue;
+			Graph<T> G = subgraphs.get(component[v]);
+			for (int i = offsets[v]; i < offsets[v+1]; i++) {
+				int w = targets[i];
+				if (v < w && component[w] >= 0) G.addEdge(vertices.get(v), vertices.get(w));
+			}
+		}
+		return subgraphs;
+	}
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.graph;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicIntegerArray;
+
+/**
+ * A parallel parser for large .gr files stored in a file. The file is split into chunks at line boundaries, the chunks
+ * are memory-mapped and parsed by GrParser instances on the common ForkJoinPool, each into its own edge buffer.
+ * The edge buffers are then merged into the compressed sparse row representation of an IntGraph with a parallel
+ * counting sort: the degrees are counted and the edges are placed concurrently using atomic counters, afterwards the
+ * neighborhoods are sorted and freed of duplicates in parallel.
+ *
+ * The result is the same graph as produced by GrParser.toIntGraph(). As the chunks are parsed independently, the
+ * positions in error messages are relative to the chunk they occur in.
+ *
+ * @author Max Bannach
+ */
+public class ParallelGrParser {
+
+	/** Smallest chunk size, smaller files are not worth to be split. */
+	private static final long MIN_CHUNK_SIZE = 1 << 20;
+
+	/** Largest chunk size, chunks have to fit into a single mapped buffer. */
+	private static final long MAX_CHUNK_SIZE = 1 << 28;
+
+	/** The file we read from. */
+	private final FileChannel channel;
+
+	/** The pool that runs the tasks. */
+	private final ForkJoinPool pool;
+
+	/** Number of bytes of the input. */
+	private long bytes;
+
+	/** The parsed graph. */
+	private IntGraph<Integer> graph;
+
+	/**
+	 * Create a parser for the file behind the given channel, the file is parsed from the current position to its end.
+	 * @param channel the channel storing the .gr file
+	 */
+	public ParallelGrParser(FileChannel channel) {
+		this.channel = channel;
+		this.pool = ForkJoinPool.commonPool();
+	}
+
+	/**
+	 * Parse the complete input and build the graph.
+	 * @return this parser
+	 * @throws IOException if the input can not be read or is not a valid .gr file
+	 */
+	public ParallelGrParser parse() throws IOException {
+		long[] starts = computeChunks();
+		bytes = starts[starts.length-1] - starts[0];
+
+		// 1. parse the chunks into their own edge buffers
+		GrParser[] parsers = new GrParser[starts.length-1];
+		inParallel(parsers.length, i -> {
+			ByteBuffer chunk = channel.map(FileChannel.MapMode.READ_ONLY, starts[i], starts[i+1] - starts[i]);
+			try {
+				parsers[i] = new GrParser(chunk).parse();
+			} catch (IOException e) {
+				throw new IOException(e.getMessage() + " (in the chunk starting at byte " + starts[i] + ")", e);
+			}
+		});
+		int n = 0;
+		for (GrParser parser : parsers) n = Math.max(n, parser.getNumVertices());
+
+		// 2. count the degrees, vertex v has id v-1, so the counter of v is offsets[id+1]
+		AtomicIntegerArray degree = new AtomicIntegerArray(n+1);
+		inParallel(parsers.length, i -> {
+			int[] edges = parsers[i].getEdges();
+			for (int j = 0; j < 2*parsers[i].getNumEdges(); j += 2) {
+				if (edges[j] == edges[j+1]) continue;
+				degree.getAndIncrement(edges[j]);
+				degree.getAndIncrement(edges[j+1]);
+			}
+		});
+		int[] offsets = new int[n+1];
+		for (int v = 0; v < n; v++) {
+			long end = (long) offsets[v] + degree.get(v+1);
+			if (end > Integer.MAX_VALUE - 8) throw new IOException("Graph has too many edges");
+			offsets[v+1] = (int) end;
+		}
+
+		// 3. place the edges
+		AtomicIntegerArray next = new AtomicIntegerArray(Arrays.copyOf(offsets, n));
+		int[] targets = new int[offsets[n]];
+		inParallel(parsers.length, i -> {
+			int[] edges = parsers[i].getEdges();
+			for (int j = 0; j < 2*parsers[i].getNumEdges(); j += 2) {
+				int u = edges[j]-1, w = edges[j+1]-1;
+				if (u == w) continue;
+				targets[next.getAndIncrement(u)] = w;
+				targets[next.getAndIncrement(w)] = u;
+			}
+		});
+		for (int i = 0; i < parsers.length; i++) parsers[i] = null; // the edge buffers are no longer needed
+
+		// 4. sort the neighborhoods and remove duplicates within them
+		int blocks = Math.max(1, Math.min(n, 4*pool.getParallelism()));
+		int blockSize = (n + blocks - 1) / blocks;
+		int[] size = new int[n];
+		final int vertices = n;
+		inParallel(blocks, b -> {
+			for (int v = b*blockSize; v < Math.min(vertices, (b+1)*blockSize); v++) {
+				int start = offsets[v], end = offsets[v+1];
+				Arrays.sort(targets, start, end);
+				int k = start;
+				for (int i = start; i < end; i++) {
+					if (k > start && targets[k-1] == targets[i]) continue;
+					targets[k++] = targets[i];
+				}
+				size[v] = k - start;
+			}
+		});
+
+		// 5. compact the neighborhoods if duplicates were removed
+		int[] compactOffsets = new int[n+1];
+		for (int v = 0; v < n; v++) compactOffsets[v+1] = compactOffsets[v] + size[v];
+		int[] compactTargets = targets;
+		if (compactOffsets[n] < targets.length) {
+			int[] compact = new int[compactOffsets[n]];
+			inParallel(blocks, b -> {
+				for (int v = b*blockSize; v < Math.min(vertices, (b+1)*blockSize); v++) {
+					System.arraycopy(targets, offsets[v], compact, compactOffsets[v], size[v]);
+				}
+			});
+			compactTargets = compact;
+		}
+
+		List<Integer> labels = new ArrayList<>(n);
+		for (int v = 1; v <= n; v++) labels.add(v);
+		graph = new IntGraph<>(labels, compactOffsets, compactTargets);
+		return this;
+	}
+
+	/**
+	 * The number of bytes consumed by the parser.
+	 * @return the size of the input
+	 */
+	public long getNumBytes() {
+		return bytes;
+	}
+
+	/**
+	 * The parsed graph as IntGraph over the vertices 1,...,n.
+	 * @return the graph
+	 */
+	public IntGraph<Integer> toIntGraph() {
+		return graph;
+	}
+
+	/**
+	 * Split the file into chunks that start at the beginning of a line.
+	 * @return the start positions of the chunks followed by the end of the file
+	 */
+	private long[] computeChunks() throws IOException {
+		long from = channel.position(), to = channel.size();
+		long chunkSize = Math.max(MIN_CHUNK_SIZE, Math.min(MAX_CHUNK_SIZE, (to - from) / (4*pool.getParallelism())));
+		List<Long> starts = new ArrayList<>();
+		starts.add(from);
+		ByteBuffer buffer = ByteBuffer.allocate(1 << 12);
+		for (long position = from + chunkSize; position < to; position += chunkSize) {
+			// a chunk starts behind the first line break at or after position-1
+			long start = position - 1;
+			boolean found = false;
+			while (!found && start < to) {
+				buffer.clear();
+				int read = channel.read(buffer, start);
+				if (read <= 0) break;
+				for (int i = 0; i < read; i++, start++) {
+					if (buffer.get(i) == '\n') {
+						found = true;
+						start++;
+						break;
+					}
+				}
+			}
+			if (!found || start >= to) break;
+			if (start - starts.get(starts.size()-1) > Integer.MAX_VALUE) throw new IOException("Line too long to be parsed");
+			if (start > starts.get(starts.size()-1)) starts.add(start);
+			position = Math.max(position, start);
+		}
+		if (to - starts.get(starts.size()-1) > Integer.MAX_VALUE) throw new IOException("Line too long to be parsed");
+		starts.add(to);
+		long[] result = new long[starts.size()];
+		for (int i = 0; i < result.length; i++) result[i] = starts.get(i);
+		return result;
+	}
+
+	/**
+	 * A task that processes the i-th part of some work.
+	 */
+	private interface Task {
+		void run(int i) throws IOException;
+	}
+
+	/**
+	 * Run the given task for all i in {0,...,count-1} on the pool and wait for all of them.
+	 * @param count the number of parts
+	 * @param task the task
+	 * @throws IOException if one of the tasks failed
+	 */
+	private void inParallel(int count, Task task) throws IOException {
+		List<Callable<Void>> callables = new ArrayList<>(count);
+		for (int i = 0; i < count; i++) {
+			final int part = i;
+			callables.add(() -> {
+				task.run(part);
+				return null;
+			});
+		}
+		try {
+			for (Future<Void> future : pool.invokeAll(callables)) future.get();
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			throw new InterruptedIOException("Parsing was interrupted");
+		} catch (ExecutionException e) {
+			Throwable cause = e.getCause();
+			if (cause instanceof IOException) throw (IOException) cause;
+			if (cause instanceof RuntimeException) throw (RuntimeException) cause;
+			if (cause instanceof Error) throw (Error) cause;
+			throw new IOException(cause);
+		}
+	}
+}
@@ -20,11 +20,9 @@ package jdrasil.graph;
 
 import java.util.ArrayList;
 import java.util.HashMap;
-import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
-import java.util.Stack;
 import java.util.logging.Logger;
 
 import jdrasil.graph.invariants.MinimalSeparator;
@@ -216,84 +214,35 @@ public class TreeDecomposition<T extends Comparable<T>> implements java.io.Seria
 		return GraphWriter.treedecompositionToString(this);
 	}
 	
-	/**
-	 * Compute the connected components of the tree-decomposition of bags that contain the vertex $x$.
-	 * For each connected component there will be one arbitrary vertex on the returned stack, i.e.,
-	 * in a valid decomposition the size of the stack is 1.
-	 * @param x The vertex for which we extract the connected components.
-	 * @return A Stack containing one bag for each connected component that contains bags with $x$.
-	 */
-	private Stack<Bag<T>> connectedComponents(T x) {
-		Stack<Bag<T>> startVertices = new Stack<>();
-		Set<Bag<T>> visited = new HashSet<>();
-		
-		// one each node, there could start a connected component
-		for (Bag<T> b : tree) {
-			if (visited.contains(b) || !b.contains(x)) continue;
-			startVertices.push(b);
-			visited.add(b);
-			
-			// perform DFS on current vertex
-			Stack<Bag<T>> S = new Stack<>();
-			S.push(b);
-			while (!S.isEmpty()) {
-				Bag<T> v = S.pop();				
-				for (Bag<T> w : tree.getNeighborhood(v)) {					
-					if (!visited.contains(w) && w.contains(x))  {
-						visited.add(w);
-						S.push(w);
-					}
-				}
-			}			
-		}
-		
-		// done
-		return startVertices;
-	}
-
 	/**
 	 * This method checks whether nor not the tree decomposition is valid.
 	 * If it is invalid, the reason will be logged.
+	 *
+	 * The test is performed on the compact representation of the decomposition, see
+	 * @see CompactTreeDecomposition#isValid(), which runs in almost linear time. Since that representation only keeps a
+	 * spanning forest of the tree, it is checked here that the tree has no cycles.
 	 * @return true if the decomposition is valid
 	 */
 	public boolean isValid() {
-		boolean valid = true;
-
-		// Property 1: every vertex is in a bag
-		for (T v : graph) {
-			boolean contained = false;
-			for (Bag<T> b : tree) {
-				if (b.contains(v)) contained = true;
-			}
-			if (!contained) {
-				valid = false;
-				LOG.warning("Vertex " + v + " not contained in any bag!");
-			}
+		CompactTreeDecomposition<T> compact;
+		try {
+			compact = new CompactTreeDecomposition<>(this);
+		} catch (IllegalArgumentException e) {
+			LOG.warning(e.getMessage());
+			return false;
 		}
+		boolean valid = true;
 
-		// Property 2: every edge is in a bag
-		for (T v : graph) {
-			for (T w : graph.getNeighborhood(v)) {
-				if (v.compareTo(w) >= 0) continue;
-				boolean contained = false;
-				for (Bag<T> b : tree) {
-					if (b.contains(v) && b.contains(w)) contained = true;
-				}
-				if (!contained) {
-					valid = false;
-					LOG.warning("Edge {" + v + ", " + w + "} not contained in any bag!");
-				}
-			}
+		// a forest with b nodes and c components has b-c edges
+		long degrees = 0;
+		for (Bag<T> b : tree) degrees += tree.getNeighborhood(b).size();
+		if (degrees / 2 != compact.getNumberOfBags() - compact.getNumberOfRoots()) {
+			valid = false;
+			LOG.warning("The tree of the decomposition contains a cycle!");
 		}
 
-		// Property 3: subtrees connected
-		for (T v : graph) {
-			Stack<Bag<T>> S = connectedComponents(v);
-			if (S.size() != 1) {
-				valid = false;
-				LOG.warning("Tree containing vertex " + v + " is not connected!");
-			}
-		}
+		// Properties 1-3: vertices and edges are in bags, subtrees connected
+		if (!compact.isValid()) valid = false;
 
 		// done
 		return valid;
@@ -69,6 +69,15 @@ public class Formula implements Iterable<List<Integer>> {
 		return signature;
 	}
 	
+	/**
+	 * Asks all running native SAT solvers to stop as soon as possible, their current calls of @see isSatisfiable()
+	 * will return false. This is intended to be used from signal handlers, i.e., if Jdrasil has to stop the computation
+	 * and print the best solution it has found so far.
+	 */
+	public static void signalShutdown() {
+		NativeSATSolver.signalShutdown();
+	}
+	
 	/**
 	 * The formula (in CNF) is represented as list of clauses, a clause 
 	 * is represented as list of integers. Each variable is represented by a positive integer, a
@@ -536,14 +545,11 @@ public class Formula implements Iterable<List<Integer>> {
 	 */
 	public String registerSATSolver() throws ISATSolver.SATSolverNotAvailableException {
 		
-		// try to load a solver	
-		if (NativeSATSolver.isAvailable()) {
-			this.solver = new NativeSATSolver();
-		} else if (SAT4JSolver.isAvailable()) {
-			this.solver = new SAT4JSolver();
-		} else {
-			throw new ISATSolver.SATSolverNotAvailableException();
-		}
+		// try to load a solver
+		this.solver = SATSolverPool.obtain();
+		
+		// announce the used variables, so that the solver can allocate them at once
+		solver.reserve(highestVariable);
 		
 		// transfer all previous clauses to the solver
 		for (List<Integer> clause : data) {
@@ -561,9 +567,11 @@ public class Formula implements Iterable<List<Integer>> {
 	 *  2) Clauses can be modified again
 	 *  3) @see isSatisfiable() will throw an Exception until a new solver is registerd.
 	 *  
+	 * The solver is handed back to the @see SATSolverPool and may be reused by other formulas.
+	 *  
 	 */
 	public void unregisterSATSolver() {
-		if (this.solver != null) this.solver.release();
+		if (this.solver != null) SATSolverPool.recycle(this.solver);
 		this.solver = null;
 	}
 	
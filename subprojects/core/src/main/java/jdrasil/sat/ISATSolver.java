@@ -88,6 +88,19 @@ public interface ISATSolver {
 	 */
 	void release();
 	
+	/**
+	 * Announces that the formula will use the variables 1,...,n. The solver may use this hint to allocate
+	 * all variable related data structures at once, instead of growing them whenever a new variable is added.
+	 * Solvers that do not benefit from this hint may ignore it.
+	 * 
+	 * If called for a native solver, use the pointer stored in the callingObject to identify the solver.
+	 * 
+	 * @param n The highest variable that is expected to be used.
+	 * 
+	 * State: {INPUT, SAT, UNSAT} to {INPUT, SAT, UNSAT}
+	 */
+	void reserve(int n);
+	
 	/**
 	 * Adds an literal to the currently constructed clause (by definition, there is always a clause at construction).
 	 * The literal is represented in the DIMACS format (a non-zero integer where \(x \gt 0\) is a positive literal and -x its negation).
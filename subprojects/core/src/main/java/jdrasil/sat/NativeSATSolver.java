@@ -18,6 +18,10 @@
  */
 package jdrasil.sat;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import jdrasil.utilities.JdrasilProperties;
 
 /**
  * This class builds the interface to an native SAT solver that implements the IPASIR SAT solver interface.
@@ -46,6 +50,21 @@ class NativeSATSolver implements ISATSolver {
 	 /** This value is true if, and only if, the static constructor successfully loaded the native library. */
 	 private final static boolean libraryLoaded;
 	 
+	 /**
+	  * A word in native memory that is shared by all native solvers. The termination callbacks of the solvers
+	  * poll this word, so setting it to a non-zero value (@see signalShutdown()) will stop all running
+	  * solvers without any call from the native side into the JVM.
+	  */
+	 private final static ByteBuffer shutdownWord = ByteBuffer.allocateDirect(4).order(ByteOrder.nativeOrder());
+	 
+	 /**
+	  * Asks every running native solver to stop as soon as possible, calls of @see solve() will then return 0.
+	  * This method is safe to be called from a signal handler.
+	  */
+	 static void signalShutdown() {
+		 shutdownWord.putInt(0, 1);
+	 }
+	 
 	 /**
 	  * Checks whether or not a native SAT solver is available.
 	  * @return true if the static constructor managed to load a native sat solver.
@@ -74,6 +93,18 @@ class NativeSATSolver implements ISATSolver {
 	 NativeSATSolver() throws SATSolverNotAvailableException {
 		 if (!NativeSATSolver.isAvailable()) throw new ISATSolver.SATSolverNotAvailableException();
 		 init();
+		 setShutdownWord(shutdownWord);
+		 if (JdrasilProperties.containsKey("t")) setDeadline(Long.parseLong(JdrasilProperties.getProperty("t")));
+		 if (JdrasilProperties.containsKey("r")) record(JdrasilProperties.getProperty("r"));
+	 }
+	 
+	 /**
+	  * Set an absolute deadline (with respect to @see System#nanoTime()) for this solver. The native side checks the
+	  * deadline during the search, and a call of @see solve() running at the deadline will return 0.
+	  * @param deadline The point in time (as in @see System#nanoTime()) at which the solver should stop.
+	  */
+	 void setDeadline(long deadline) {
+		 setTimeout(deadline - System.nanoTime());
 	 }
 	 
 	 /**
@@ -126,6 +157,22 @@ class NativeSATSolver implements ISATSolver {
 	@Override
 	public native void release();
 
+	/**
+	 * Resets the solver to the state of a freshly initialized one, i.e., removes all clauses, variables, and
+	 * assumptions. The native solver may keep its allocated memory, so that the next formula can reuse it.
+	 * 
+	 * State: {INPUT, SAT, UNSAT} to INPUT
+	 * 
+	 * @return true if the solver was reset, false if the native solver does not support this (the solver is then unchanged).
+	 */
+	public native boolean reset();
+
+	/* (non-Javadoc)
+	 * @see jdrasil.sat.ISATSolver#reserve(int)
+	 */
+	@Override
+	public native void reserve(int n);
+
 	/* (non-Javadoc)
 	 * @see jdrasil.sat.ISATSolver#add(int)
 	 */
@@ -161,5 +208,32 @@ class NativeSATSolver implements ISATSolver {
 	 */
 	@Override
 	public native void terminate();
+
+	/**
+	 * Let the native solver stop its search the given amount of nanoseconds from now.
+	 * The native side converts this into an absolute point in time of its own clock.
+	 * @param nanos The time the solver may still search.
+	 */
+	private native void setTimeout(long nanos);
+	
+	/**
+	 * Let the native solver poll the given direct buffer during the search, it will stop if the first word of the
+	 * buffer is non-zero.
+	 * @param word A direct ByteBuffer in native byte order, or null to remove the word.
+	 */
+	private native void setShutdownWord(ByteBuffer word);
+	
+	/**
+	 * Let the native side record every call of this solver to a binary trace file in the given directory, which
+	 * can be replayed outside of the JVM with ipasir-replay. Each formula (@see reset()) gets its own file.
+	 * @param directory An existing directory in which the trace files are created.
+	 */
+	private native void record(String directory);
+
+	/**
+	 * Close the trace files of all native solvers (@see record(String)), solvers that are still in use stop recording.
+	 * This is called once the JVM shuts down, so that no trace is left truncated.
+	 */
+	static native void closeTraces();
 	
 }
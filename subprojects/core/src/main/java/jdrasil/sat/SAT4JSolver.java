@@ -210,6 +210,14 @@ class SAT4JSolver implements ISATSolver {
 		// not needed
 	}
 
+	/* (non-Javadoc)
+	 * @see jdrasil.sat.ISATSolver#reserve(int)
+	 */
+	@Override
+	public void reserve(int n) {
+		// not needed
+	}
+
 	/* (non-Javadoc)
 	 * @see jdrasil.sat.ISATSolver#add(int)
 	 */
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.sat;
+
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.Iterator;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+
+/**
+ * A factory for ISATSolver objects that keeps a bounded pool of idle native solvers per thread.
+ *
+ * Creating and releasing a native solver is expensive, as the solver has to allocate (and later free) its clause
+ * arena and watcher lists. Algorithms that split the graph into many small atoms create a new @see Formula for
+ * each atom, which would otherwise pay this cost every time. Instead, a solver that is handed back via
+ * @see recycle(ISATSolver) is reset (keeping its memory) and handed out again by the next call of @see obtain().
+ *
+ * Solvers that can not be reset (for instance, because the native library does not support it) are just released.
+ * Idle solvers hold native memory that the garbage collector does not know about: they are released by
+ * @see trim() (for the calling thread and for all threads that have terminated) and, at the latest, by a
+ * shutdown hook, which also closes all trace files.
+ *
+ * @author Max Bannach
+ */
+public class SATSolverPool {
+
+	/** The maximum number of idle solvers that are kept per thread. */
+	private static final int MAX_IDLE_SOLVERS = 4;
+
+	/** The idle solvers of one thread. Accessed by the owner, and by trim() and shutdown() of other threads. */
+	private static class Pool {
+		final Thread owner = Thread.currentThread();
+		final Deque<NativeSATSolver> solvers = new ArrayDeque<>();
+
+		/** Release all solvers in this pool. */
+		synchronized void clear() {
+			for (NativeSATSolver solver : solvers) solver.release();
+			solvers.clear();
+		}
+	}
+
+	/** The pools of all threads, such that solvers of terminated threads can be released. */
+	private static final Set<Pool> pools = ConcurrentHashMap.newKeySet();
+
+	/** Idle solvers of the current thread, ready to be reused. */
+	private static final ThreadLocal<Pool> idle = ThreadLocal.withInitial(() -> {
+		trimTerminated(); // a new thread is a good moment to clean up after old ones
+		Pool pool = new Pool();
+		pools.add(pool);
+		return pool;
+	});
+
+	/** Set by the shutdown hook, afterwards solvers are not pooled anymore. */
+	private static volatile boolean shutdown = false;
+
+	static {
+		Runtime.getRuntime().addShutdownHook(new Thread(SATSolverPool::shutdown));
+	}
+
+	/**
+	 * Get a SAT solver in the state INPUT, i.e., without any clauses. A pooled native solver will be reused if possible,
+	 * otherwise a new solver is created (native if available, otherwise SAT4J).
+	 * @return A solver that does not contain any clauses.
+	 * @throws ISATSolver.SATSolverNotAvailableException if Jdrasil has no access to any SATSolver.
+	 */
+	public static ISATSolver obtain() throws ISATSolver.SATSolverNotAvailableException {
+		if (NativeSATSolver.isAvailable()) {
+			Pool pool = idle.get();
+			NativeSATSolver solver;
+			synchronized (pool) { solver = pool.solvers.pollFirst(); }
+			if (solver != null) return solver;
+			return new NativeSATSolver();
+		} else if (SAT4JSolver.isAvailable()) {
+			return new SAT4JSolver();
+		}
+		throw new ISATSolver.SATSolverNotAvailableException();
+	}
+
+	/**
+	 * Hand a solver obtained by @see obtain() back to the pool. The solver must not be used by the caller afterwards.
+	 * If the pool of the current thread is full, or if the solver can not be reset, it will be released.
+	 * @param solver The solver that is not needed anymore.
+	 */
+	public static void recycle(ISATSolver solver) {
+		if (solver instanceof NativeSATSolver && !shutdown) {
+			Pool pool = idle.get();
+			NativeSATSolver nativeSolver = (NativeSATSolver) solver;
+			synchronized (pool) {
+				if (!shutdown && pool.solvers.size() < MAX_IDLE_SOLVERS && nativeSolver.reset()) {
+					pool.solvers.addFirst(nativeSolver);
+					return;
+				}
+			}
+		}
+		solver.release();
+	}
+
+	/**
+	 * Release the idle solvers of the current thread and of all threads that have terminated.
+	 * Algorithms should call this once they do not need SAT solvers for a while.
+	 */
+	public static void trim() {
+		idle.get().clear();
+		trimTerminated();
+	}
+
+	/**
+	 * Release the idle solvers of all threads that have terminated and forget their pools.
+	 */
+	private static void trimTerminated() {
+		for (Iterator<Pool> it = pools.iterator(); it.hasNext(); ) {
+			Pool pool = it.next();
+			if (pool.owner.isAlive()) continue;
+			pool.clear();
+			it.remove();
+		}
+	}
+
+	/**
+	 * Release all idle solvers and close all trace files, called by a shutdown hook.
+	 * Solvers that are still in use at this point are freed by the operating system.
+	 */
+	private static void shutdown() {
+		shutdown = true;
+		for (Pool pool : pools) pool.clear();
+		pools.clear();
+		if (NativeSATSolver.isAvailable()) NativeSATSolver.closeTraces();
+	}
+
+}
@@ -84,7 +84,7 @@ public class BaseEncoder<T extends Comparable<T>> {
 		
 		// compute the bijection
 		int varCount = 0;
-		for (T v : graph) {
+		for (T v : graph.getSortedVertices()) {
 			varCount++;
 			vertexToInt.put(v, varCount);
 			intToVertex.put(varCount, v);
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.utilities.logging.JdrasilLogger;
+
+import java.io.*;
+import java.nio.ByteBuffer;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.logging.Logger;
+
+/**
+ * A Checkpoint stores the state of a long running computation as binary snapshot in a file, from which the computation
+ * can be resumed later (for instance after the machine was restarted).
+ *
+ * The solver owns the checkpoint and decides when its state is consistent: at such points it calls @see isDue() and,
+ * if this returns true, writes its state with @see write(Writer). A checkpoint is due if the interval since the last
+ * snapshot has passed, or if it was requested by another thread, for instance by a signal handler using
+ * @see requestAll(long).
+ *
+ * A snapshot starts with a magic number, the kind of the solver, and a fingerprint of its input, such that a solver
+ * only resumes from snapshots of the same computation. The given file is only a base name: the snapshot is stored in
+ * the file {@code <file>.<kind>.<fingerprint in hex>}, so computations on different inputs (for instance the atoms of
+ * a graph, which may be solved one after another or at the same time) never replace the snapshots of each other. The
+ * state is written sequentially through a large buffer, arrays in chunks of bytes, to a uniquely named temporary file
+ * next to the snapshot that then replaces it. Hence, a crash while writing leaves the previous snapshot intact.
+ *
+ * @author Max Bannach
+ */
+public class Checkpoint {
+
+    /** Jdrasils Logger */
+    private final static Logger LOG = Logger.getLogger(JdrasilLogger.getName());
+
+    /** Magic number at the start of every snapshot ("JDCK"). */
+    private static final int MAGIC = 0x4A44434B;
+
+    /** Size of the stream buffers and of the chunks in which arrays are written. */
+    private static final int BUFFER_SIZE = 1 << 20;
+    private static final int CHUNK_SIZE = 1 << 16;
+
+    /** Default interval between two snapshots in milliseconds. */
+    public static final long DEFAULT_INTERVAL = 10 * 60 * 1000;
+
+    /** Checkpoints of running computations, which are notified by @see requestAll(long). */
+    private static final Set<Checkpoint> active = ConcurrentHashMap.newKeySet();
+
+    /**
+     * The state of a solver, written to the stream of a snapshot.
+     */
+    @FunctionalInterface
+    public interface Writer {
+        void write(DataOutputStream out) throws IOException;
+    }
+
+    /** The file that stores the snapshot of this computation. */
+    private final File file;
+
+    /** Interval between two snapshots in milliseconds. */
+    private final long interval;
+
+    /** Identification of the computation. */
+    private final String kind;
+    private final long fingerprint;
+
+    /** Time of the last snapshot, and whether a snapshot was requested. */
+    private long last;
+    private volatile boolean requested;
+
+    /**
+     * Creates a checkpoint for a computation.
+     *
+     * @param file The base name of the file that stores the snapshot, see @see getFile().
+     * @param intervalMillis The interval between two snapshots in milliseconds.
+     * @param kind The kind of the solver, for instance its class name.
+     * @param fingerprint A fingerprint of the input of the solver.
+     */
+    public Checkpoint(File file, long intervalMillis, String kind, long fingerprint) {
+        this.file = new File(file.getPath() + "." + kind + "." + Long.toHexString(fingerprint));
+        this.interval = intervalMillis;
+        this.kind = kind;
+        this.fingerprint = fingerprint;
+        this.last = System.currentTimeMillis();
+    }
+
+    /**
+     * The interval between two snapshots that is given by the property "i" (in seconds), or @see DEFAULT_INTERVAL.
+     * @return The interval in milliseconds.
+     */
+    public static long getInterval() {
+        return JdrasilProperties.containsKey("i")
+                ? Long.parseLong(JdrasilProperties.getProperty("i")) * 1000
+                : DEFAULT_INTERVAL;
+    }
+
+    /**
+     * The file that stores the snapshot of this computation, which is derived from the base name, the kind, and the
+     * fingerprint.
+     * @return The file of the snapshot.
+     */
+    public File getFile() {
+        return file;
+    }
+
+    /**
+     * Mark the computation as running, such that it gets notified by @see requestAll(long).
+     */
+    public void start() {
+        active.add(this);
+    }
+
+    /**
+     * Mark the computation as stopped. Threads waiting for a snapshot of it return.
+     */
+    public void stop() {
+        active.remove(this);
+        synchronized (this) {
+            requested = false;
+            notifyAll();
+        }
+    }
+
+    /**
+     * Request a snapshot, which is written the next time the solver checks @see isDue(). May be called from any thread.
+     */
+    public void request() {
+        requested = true;
+    }
+
+    /**
+     * Check if the solver should write a snapshot now.
+     * @return True if the interval has passed or a snapshot was requested.
+     */
+    public boolean isDue() {
+        return requested || System.currentTimeMillis() - last >= interval;
+    }
+
+    /**
+     * Write a snapshot. Errors are logged, as a failed snapshot should not stop the computation.
+     * @param writer Writes the state of the solver.
+     */
+    public void write(Writer writer) {
+        long start = System.currentTimeMillis();
+        File tmp = null;
+        try {
+            tmp = File.createTempFile(file.getName(), ".tmp", file.getAbsoluteFile().getParentFile());
+            try (DataOutputStream out = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(tmp), BUFFER_SIZE))) {
+                out.writeInt(MAGIC);
+                out.writeUTF(kind);
+                out.writeLong(fingerprint);
+                writer.write(out);
+            }
+            Files.move(tmp.toPath(), file.toPath(), StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+            LOG.info("wrote checkpoint " + file.getName() + " (" + file.length() / 1024 + " KB) in " + (System.currentTimeMillis() - start) + " ms");
+        } catch (IOException e) {
+            LOG.warning("could not write checkpoint: " + e.getMessage());
+            if (tmp != null) tmp.delete();
+        }
+        last = System.currentTimeMillis();
+        synchronized (this) {
+            requested = false;
+            notifyAll();
+        }
+    }
+
+    /**
+     * Open the snapshot for reading, if there is one of the same computation.
+     * @return A stream positioned after the header, or null if there is no matching snapshot.
+     * @throws IOException
+     */
+    public DataInputStream open() throws IOException {
+        if (!file.exists()) return null;
+        DataInputStream in = new DataInputStream(new BufferedInputStream(new FileInputStream(file), BUFFER_SIZE));
+        try {
+            if (in.readInt() == MAGIC && in.readUTF().equals(kind) && in.readLong() == fingerprint) return in;
+        } catch (IOException e) {
+            // not a snapshot, handled as mismatch
+        }
+        in.close();
+        return null;
+    }
+
+    /**
+     * Wait till a requested snapshot was written, or till the computation stopped.
+     * @param timeoutMillis The maximal time to wait in milliseconds.
+     * @return True if no snapshot is pending anymore.
+     * @throws InterruptedException
+     */
+    public synchronized boolean await(long timeoutMillis) throws InterruptedException {
+        long deadline = System.currentTimeMillis() + timeoutMillis;
+        while (requested && active.contains(this)) {
+            long rest = deadline - System.currentTimeMillis();
+            if (rest <= 0) return false;
+            wait(rest);
+        }
+        return true;
+    }
+
+    /**
+     * Request a snapshot of all running computations and wait till they are written. This is used by signal handlers
+     * before the program exits.
+     * @param timeoutMillis The maximal time to wait for each computation in milliseconds.
+     */
+    public static void requestAll(long timeoutMillis) {
+        for (Checkpoint checkpoint : active) checkpoint.request();
+        for (Checkpoint checkpoint : active) {
+            try {
+                if (!checkpoint.await(timeoutMillis)) LOG.warning("checkpoint was not written in time");
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                return;
+            }
+        }
+    }
+
+    /**
+     * Write the first length entries of an int array (preceded by length).
+     */
+    public static void writeInts(DataOutput out, int[] array, int length) throws IOException {
+        out.writeInt(length);
+        ByteBuffer buffer = ByteBuffer.allocate(4 * CHUNK_SIZE);
+        for (int from = 0; from < length; from += CHUNK_SIZE) {
+            int len = Math.min(CHUNK_SIZE, length - from);
+            buffer.clear();
+            buffer.asIntBuffer().put(array, from, len);
+            out.write(buffer.array(), 0, 4 * len);
+        }
+    }
+
+    /**
+     * Read an int array written by @see writeInts(DataOutput, int[], int).
+     */
+    public static int[] readInts(DataInput in) throws IOException {
+        int[] array = new int[in.readInt()];
+        ByteBuffer buffer = ByteBuffer.allocate(4 * CHUNK_SIZE);
+        for (int from = 0; from < array.length; from += CHUNK_SIZE) {
+            int len = Math.min(CHUNK_SIZE, array.length - from);
+            in.readFully(buffer.array(), 0, 4 * len);
+            buffer.clear();
+            buffer.asIntBuffer().get(array, from, len);
+        }
+        return array;
+    }
+
+    /**
+     * Write the first length entries of a long array (preceded by length).
+     */
+    public static void writeLongs(DataOutput out, long[] array, int length) throws IOException {
+        out.writeInt(length);
+        ByteBuffer buffer = ByteBuffer.allocate(8 * CHUNK_SIZE);
+        for (int from = 0; from < length; from += CHUNK_SIZE) {
+            int len = Math.min(CHUNK_SIZE, length - from);
+            buffer.clear();
+            buffer.asLongBuffer().put(array, from, len);
+            out.write(buffer.array(), 0, 8 * len);
+        }
+    }
+
+    /**
+     * Read a long array written by @see writeLongs(DataOutput, long[], int).
+     */
+    public static long[] readLongs(DataInput in) throws IOException {
+        long[] array = new long[in.readInt()];
+        ByteBuffer buffer = ByteBuffer.allocate(8 * CHUNK_SIZE);
+        for (int from = 0; from < array.length; from += CHUNK_SIZE) {
+            int len = Math.min(CHUNK_SIZE, array.length - from);
+            in.readFully(buffer.array(), 0, 8 * len);
+            buffer.clear();
+            buffer.asLongBuffer().get(array, from, len);
+        }
+        return array;
+    }
+
+}
@@ -68,6 +68,14 @@ public class JdrasilProperties {
     public static void setProperty(String key, String value) {
         properties.setProperty(key, value);
     }
+
+    /**
+     * Removes the property 'key'.
+     * @param key
+     */
+    public static void removeProperty(String key) {
+        properties.remove(key);
+    }
     
     /**
     * If a timeout is specified, return whether this has been reached or not. 
@@ -142,7 +150,14 @@ public class JdrasilProperties {
         System.out.println("  -h : print this dialog");
         System.out.println("  -s <seed> : set a random seed");
         System.out.println("  -t <timeout> : set a time limit");
+        System.out.println("  -r <directory> : record the calls of native SAT solvers as traces in the directory");
+        System.out.println("  -b <file> : store the input graph as binary snapshot, which can be given as input instead of a .gr file");
+        System.out.println("  -m <megabytes> : memory budget for memorized results of the exact decomposer, shared by all concurrent runs (default: a quarter of the heap)");
+        System.out.println("  -c <file> : periodically store the state of the exact decomposer in files <file>.<solver>.<fingerprint>, and on SIGTERM");
+        System.out.println("  -i <seconds> : interval between two checkpoints (default: 600)");
+        System.out.println("  -resume : continue the exact decomposer from the checkpoint given by -c");
         System.out.println("  -parallel : enable parallel processing");
+        System.out.println("  -speculative : test several widths at once with PID-BT (only exact mode)");
         System.out.println("  -instant : computes solution directly (only heuristic mode)");
         System.out.println("  -log : enable log output");
         System.out.println("  -debug : Run some more debugging");
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * A memory budget in bytes that is shared by a varying number of consumers, for instance the memorization caches of
+ * all BitSetGraphs used by concurrently running solvers. Every consumer takes a share with @see acquire() and returns
+ * it with @see release(); the budget is split evenly among the consumers that currently hold a share. Hence, a
+ * consumer has to read @see getShare() whenever it allocates, its share shrinks if others join and grows if they leave.
+ *
+ * This class is thread-safe.
+ *
+ * @author Max Bannach
+ */
+public class MemoryBudget {
+
+    /** The total budget in bytes. */
+    private final long total;
+
+    /** The number of consumers that hold a share. */
+    private final AtomicInteger consumers = new AtomicInteger();
+
+    /**
+     * Creates a budget without consumers.
+     * @param total the total budget in bytes
+     */
+    public MemoryBudget(long total) {
+        this.total = total;
+    }
+
+    /**
+     * Register a new consumer.
+     */
+    public void acquire() {
+        consumers.incrementAndGet();
+    }
+
+    /**
+     * Unregister a consumer, which must have called @see acquire() before.
+     */
+    public void release() {
+        consumers.decrementAndGet();
+    }
+
+    /**
+     * The total budget.
+     * @return the budget in bytes
+     */
+    public long getTotal() {
+        return total;
+    }
+
+    /**
+     * The current share of every consumer.
+     * @return the total budget divided by the number of consumers
+     */
+    public long getShare() {
+        return total / Math.max(1, consumers.get());
+    }
+
+    /**
+     * The number of consumers that currently hold a share.
+     * @return the number of consumers
+     */
+    public int getConsumers() {
+        return consumers.get();
+    }
+}
@@ -3,12 +3,13 @@ package jdrasil.workontd;
 import jdrasil.algorithms.SmartDecomposer;
 import jdrasil.algorithms.postprocessing.NiceTreeDecomposition;
 import jdrasil.graph.Bag;
+import jdrasil.graph.CompactTreeDecomposition;
 import jdrasil.graph.Graph;
 import jdrasil.graph.TreeDecomposition;
 import jdrasil.utilities.logging.JdrasilLogger;
 
-import java.util.HashSet;
-import java.util.Set;
+import java.util.HashMap;
+import java.util.Map;
 import java.util.Stack;
 import java.util.logging.Level;
 import java.util.logging.Logger;
@@ -19,7 +20,8 @@ import java.util.logging.Logger;
  * optimize the tree decomposition and transform it into a nice one. Then it will traverse the decomposition in
  * post-order and simulate a stack machine while doing so. On leaf bags, the stack machine will push new
  * \JClass{StateConfigurations} using a provided \JClass{StateVectorFactory}. For all other bag types, the stack machine
- * will only use the top of the stack and the methods of \JClass{StateVector}.
+ * will only use the top of the stack and the methods of \JClass{StateVector}. The traversal runs over the
+ * \JClass{CompactTreeDecomposition} of the nice tree decomposition, i.e., over the flat child offsets of the bags.
  *
  * Note that the \emph{actual} program that will be executed is encoded in the \JClass{StateVector} class, which is provided
  * to the stack machine in form the the given \JClass{StateVectorFactory}. All operations performed by this class
@@ -59,6 +61,13 @@ public class DynamicProgrammingOnTreeDecomposition<T extends Comparable<T>> {
      */
     private NiceTreeDecomposition<T> niceTreeDecomposition;
 
+    /**
+     * The compact representation of the nice tree decomposition, rooted at its root, over which the program traverses.
+     * The bag of the nice tree decomposition that corresponds to the compact bag i is stored in bags[i].
+     */
+    private CompactTreeDecomposition<T> compactTreeDecomposition;
+    private Bag<T>[] bags;
+
     /**
      * The tree width of the nice (or very nice) tree decomposition.
      */
@@ -98,7 +107,7 @@ public class DynamicProgrammingOnTreeDecomposition<T extends Comparable<T>> {
      */
     public DynamicProgrammingOnTreeDecomposition(Graph<T> graph,
                                                  StateVectorFactory<T> leafFactory, boolean veryNice) {
-        this(graph, leafFactory, veryNice, null);
+        this(graph, leafFactory, veryNice, (TreeDecomposition<T>) null);
     }
 
     /**
@@ -126,6 +135,22 @@ public class DynamicProgrammingOnTreeDecomposition<T extends Comparable<T>> {
         initialize();
     }
 
+    /**
+     * Initialize a new instance of a program that runs over the given compact tree decomposition, see
+     * @see DynamicProgrammingOnTreeDecomposition(Graph, StateVectorFactory, boolean, TreeDecomposition). The
+     * decomposition is converted once, as it is transformed into a nice tree decomposition anyway.
+     *
+     * @param graph The graph for which the program shall be executed.
+     * @param leafFactory A StateVectorFactory that generates (usually empty) state vectors for leafs.
+     * @param veryNice Indicates if the program should be executed on a \emph{very} nice tree decomposition.
+     * @param treeDecomposition A given compact tree decomposition on which the program shall run.
+     */
+    public DynamicProgrammingOnTreeDecomposition(Graph<T> graph,
+                                                 StateVectorFactory<T> leafFactory, boolean veryNice,
+                                                 CompactTreeDecomposition<T> treeDecomposition) {
+        this(graph, leafFactory, veryNice, treeDecomposition.toTreeDecomposition());
+    }
+
     /**
      * Initialize the dynamic program. This will
      * \begin{enumerate}
@@ -147,6 +172,15 @@ public class DynamicProgrammingOnTreeDecomposition<T extends Comparable<T>> {
         this.niceTreeDecomposition = new NiceTreeDecomposition<>(treeDecomposition, this.worksOnVeryNiceTreeDecomposition);
         this.treeDecomposition = niceTreeDecomposition.getProcessedTreeDecomposition(); // actually compute nice tree decomposition
         this.tw = this.treeDecomposition.getWidth();
+
+        // compute the compact representation and map its bags to the bags of the nice tree decomposition
+        this.compactTreeDecomposition = new CompactTreeDecomposition<>(treeDecomposition, niceTreeDecomposition.getRoot());
+        Map<Integer, Bag<T>> bagOfId = new HashMap<>();
+        for (Bag<T> bag : treeDecomposition.getBags()) bagOfId.put(bag.id, bag);
+        @SuppressWarnings("unchecked")
+        Bag<T>[] bags = new Bag[compactTreeDecomposition.getNumberOfBags()];
+        for (int i = 0; i < bags.length; i++) bags[i] = bagOfId.get(compactTreeDecomposition.getBagId(i));
+        this.bags = bags;
         LOG.info("Initialization of dynamic program completed.");
     }
 
@@ -158,24 +192,25 @@ public class DynamicProgrammingOnTreeDecomposition<T extends Comparable<T>> {
      */
     public StateVector<T> run() {
 
-        // traverse the tree decomposition in post-order
-        Set<Bag<T>> visited = new HashSet<>();
-        Stack<Bag<T>> stack = new Stack<>();
-        stack.push(niceTreeDecomposition.getRoot()); // start at the root of the tree decomposition
+        // traverse the tree decomposition in post-order, starting at the root (bag 0 of the compact decomposition)
+        CompactTreeDecomposition<T> td = compactTreeDecomposition;
+        int[] stack = new int[td.getNumberOfBags()];
+        int[] nextChild = new int[td.getNumberOfBags()]; // the next child of every bag on the stack
+        int top = 0;
+        stack[0] = 0;
+        nextChild[0] = td.childrenStart(0);
 
         // post-order DFS
-        while (!stack.isEmpty()) {
-            Bag<T> v = stack.peek();
-            if (visited.contains(v)) {
-                stack.pop();
-                handleBag(v);
+        while (top >= 0) {
+            int v = stack[top];
+            if (nextChild[top] < td.childrenEnd(v)) {
+                int w = nextChild[top]++;
+                stack[++top] = w;
+                nextChild[top] = td.childrenStart(w);
                 continue;
             }
-            visited.add(v);
-            for (Bag<T> w : treeDecomposition.getNeighborhood(v)) {
-                if (visited.contains(w)) continue;
-                stack.push(w);
-            }
+            top--;
+            handleBag(bags[v]);
         }
 
         // done, top of the stack is result for the root
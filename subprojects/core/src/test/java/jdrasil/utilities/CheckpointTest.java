@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.exact.DynamicProgrammingDecomposer;
+import jdrasil.algorithms.exact.PidBT;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+import org.junit.rules.TemporaryFolder;
+
+import java.io.DataInputStream;
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the Checkpoint and for resuming PidBT and TWDP from snapshots.
+ *
+ * @author Max Bannach
+ */
+public class CheckpointTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 20;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Folder for the snapshots, which is deleted after each test */
+    @org.junit.Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    /* Create a random connected graph over {1,...,n}, i.e., a random tree with additional edges of probability p. */
+    private Graph<Integer> randomGraph(Random rng, int n, double p) {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= n; v++) G.addVertex(v);
+        for (int v = 2; v <= n; v++) G.addEdge(1 + rng.nextInt(v-1), v);
+        for (int u = 1; u <= n; u++) {
+            for (int v = u+1; v <= n; v++) if (rng.nextDouble() < p) G.addEdge(u, v);
+        }
+        return G;
+    }
+
+    /* The files in the snapshot folder whose name starts with the given prefix. */
+    private File[] files(String prefix) {
+        return folder.getRoot().listFiles((dir, name) -> name.startsWith(prefix));
+    }
+
+    @org.junit.Test
+    public void fileNames() throws Exception {
+        File base = new File(folder.getRoot(), "snapshot");
+        Checkpoint checkpoint = new Checkpoint(base, 0, "Test", 0xABCDL);
+        assertEquals(new File(base.getPath() + ".Test.abcd"), checkpoint.getFile());
+
+        // the snapshot of PidBT is named after its fingerprint
+        Graph<Integer> G = randomGraph(new Random(SEED), 10, 0.3);
+        PidBT<Integer> pidBT = new PidBT<>(G);
+        pidBT.setCheckpoint(base, 0);
+        File file = new File(base.getPath() + ".PidBT." + Long.toHexString(pidBT.fingerprint()));
+        pidBT.call();
+        assertTrue(file.exists());
+        assertEquals(1, files("snapshot").length);
+    }
+
+    @org.junit.Test
+    public void roundTrip() throws Exception {
+        Random rng = new Random(SEED);
+        int[] ints = new int[200003];
+        for (int i = 0; i < ints.length; i++) ints[i] = rng.nextInt();
+        long[] longs = new long[150001];
+        for (int i = 0; i < longs.length; i++) longs[i] = rng.nextLong();
+
+        Checkpoint checkpoint = new Checkpoint(new File(folder.getRoot(), "snapshot"), 0, "Test", 42);
+        assertNull(checkpoint.open());
+        checkpoint.write(out -> {
+            out.writeInt(7);
+            Checkpoint.writeInts(out, ints, ints.length);
+            Checkpoint.writeLongs(out, longs, longs.length - 1);
+        });
+        try (DataInputStream in = checkpoint.open()) {
+            assertNotNull(in);
+            assertEquals(7, in.readInt());
+            assertArrayEquals(ints, Checkpoint.readInts(in));
+            long[] read = Checkpoint.readLongs(in);
+            assertEquals(longs.length - 1, read.length);
+            for (int i = 0; i < read.length; i++) assertEquals(longs[i], read[i]);
+        }
+
+        // the temporary file was moved onto the snapshot
+        assertEquals(1, files("snapshot").length);
+    }
+
+    @org.junit.Test
+    public void failedWrite() throws Exception {
+        Checkpoint checkpoint = new Checkpoint(new File(folder.getRoot(), "snapshot"), 0, "Test", 42);
+        checkpoint.write(out -> out.writeInt(1));
+
+        // a write that fails halfway leaves the previous snapshot intact and removes its temporary file
+        checkpoint.write(out -> {
+            out.writeInt(2);
+            throw new IOException("disk full");
+        });
+        try (DataInputStream in = checkpoint.open()) {
+            assertNotNull(in);
+            assertEquals(1, in.readInt());
+        }
+        assertEquals(1, files("snapshot").length);
+
+        // a successful write replaces it
+        checkpoint.write(out -> out.writeInt(3));
+        try (DataInputStream in = checkpoint.open()) {
+            assertEquals(3, in.readInt());
+        }
+        assertEquals(1, files("snapshot").length);
+    }
+
+    @org.junit.Test
+    public void otherComputation() throws Exception {
+        File base = new File(folder.getRoot(), "snapshot");
+        Checkpoint checkpoint = new Checkpoint(base, 0, "Test", 1);
+        checkpoint.write(out -> out.writeInt(1));
+
+        // snapshots of other fingerprints or kinds are ignored, even if they are stored under the expected name
+        Checkpoint otherFingerprint = new Checkpoint(base, 0, "Test", 2);
+        Checkpoint otherKind = new Checkpoint(base, 0, "Other", 1);
+        assertNull(otherFingerprint.open());
+        assertNull(otherKind.open());
+        Files.copy(checkpoint.getFile().toPath(), otherFingerprint.getFile().toPath());
+        Files.copy(checkpoint.getFile().toPath(), otherKind.getFile().toPath());
+        assertNull(otherFingerprint.open());
+        assertNull(otherKind.open());
+
+        // the same holds for a snapshot of PidBT on another graph
+        Random rng = new Random(SEED);
+        Graph<Integer> G = randomGraph(rng, 12, 0.3);
+        Graph<Integer> H = randomGraph(rng, 12, 0.3);
+        PidBT<Integer> pidBT = new PidBT<>(G);
+        pidBT.setCheckpoint(base, 0);
+        pidBT.call();
+        PidBT<Integer> other = new PidBT<>(H);
+        other.setCheckpoint(base, 0);
+        assertNotEquals(pidBT.fingerprint(), other.fingerprint());
+        assertFalse(other.resume());
+        File file = new File(base.getPath() + ".PidBT." + Long.toHexString(pidBT.fingerprint()));
+        File otherFile = new File(base.getPath() + ".PidBT." + Long.toHexString(other.fingerprint()));
+        Files.copy(file.toPath(), otherFile.toPath());
+        assertFalse(other.resume());
+        other.release();
+    }
+
+    @org.junit.Test
+    public void resumePidBT() throws Exception {
+        Random rng = new Random(SEED);
+        int resumed = 0;
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 5 + rng.nextInt(12), 0.1 + 0.3 * rng.nextDouble());
+            int tw = new PidBT<>(G).call().getWidth();
+            File base = new File(folder.getRoot(), "pidbt" + i);
+
+            // interrupt the search after the last failed width, the snapshot is taken before the last step of its test
+            PidBT<Integer> interrupted = new PidBT<>(G);
+            interrupted.setCheckpoint(base, 0);
+            for (int k = 1; k < tw; k++) assertFalse(interrupted.decide(k));
+            interrupted.release();
+            PidBT<Integer> pidBT = new PidBT<>(G);
+            pidBT.setCheckpoint(base, 0);
+            if (pidBT.resume()) resumed++;
+            TreeDecomposition<Integer> td = pidBT.call();
+            assertTrue(td.isValid());
+            assertEquals(tw, td.getWidth());
+
+            // the snapshot of a complete run is taken before the last step of the test of the tree width
+            PidBT<Integer> complete = new PidBT<>(G);
+            complete.setCheckpoint(base, 0);
+            complete.call();
+            pidBT = new PidBT<>(G);
+            pidBT.setCheckpoint(base, 0);
+            if (pidBT.resume()) resumed++;
+            td = pidBT.call();
+            assertTrue(td.isValid());
+            assertEquals(tw, td.getWidth());
+        }
+        assertTrue(resumed > 0);
+    }
+
+    @org.junit.Test
+    public void resumeTWDP() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 3 + rng.nextInt(12), 0.1 + 0.5 * rng.nextDouble());
+            File base = new File(folder.getRoot(), "twdp" + i);
+
+            // every layer replaces the snapshot, so the last layer and all vertices to eliminate are stored
+            DynamicProgrammingDecomposer<Integer> dp = new DynamicProgrammingDecomposer<>(G, DynamicProgrammingDecomposer.Mode.TWDP);
+            dp.setCheckpoint(base, 0);
+            int tw = dp.call().getWidth();
+            assertEquals(1, files("twdp" + i + ".DynamicProgrammingDecomposer.").length);
+
+            // a fresh instance reads the tables and builds the decomposition from them
+            dp = new DynamicProgrammingDecomposer<>(G, DynamicProgrammingDecomposer.Mode.TWDP);
+            dp.setCheckpoint(base, 0);
+            assertTrue(dp.resume());
+            TreeDecomposition<Integer> td = dp.call();
+            assertTrue(td.isValid());
+            assertEquals(tw, td.getWidth());
+
+            // a snapshot of another graph is ignored
+            Graph<Integer> H = GraphFactory.copy(G);
+            H.addVertex(0);
+            H.addEdge(0, 1);
+            dp = new DynamicProgrammingDecomposer<>(H, DynamicProgrammingDecomposer.Mode.TWDP);
+            dp.setCheckpoint(base, 0);
+            assertFalse(dp.resume());
+        }
+    }
+
+}
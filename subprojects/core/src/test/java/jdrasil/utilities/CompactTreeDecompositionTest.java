@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.upperbounds.GreedyPermutationDecomposer;
+import jdrasil.graph.Bag;
+import jdrasil.graph.CompactTreeDecomposition;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+import jdrasil.workontd.DynamicProgrammingOnTreeDecomposition;
+import jdrasil.workontd.StateVector;
+
+import java.util.Arrays;
+import java.util.HashSet;
+import java.util.Map;
+import java.util.Random;
+import java.util.Set;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the CompactTreeDecomposition that converts random tree decompositions to the compact representation and
+ * back, and runs a dynamic program over both representations.
+ *
+ * @author Max Bannach
+ */
+public class CompactTreeDecompositionTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 20;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random connected graph over {1,...,n}: a path plus random edges. */
+    private Graph<Integer> randomGraph(Random rng, int n) {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= n; v++) G.addVertex(v);
+        for (int v = 1; v < n; v++) G.addEdge(v, v+1);
+        for (int i = 0; i < 2*n; i++) {
+            int u = 1 + rng.nextInt(n);
+            int v = 1 + rng.nextInt(n);
+            if (u != v) G.addEdge(u, v);
+        }
+        return G;
+    }
+
+    /* A state vector that collects the introduced vertices and edges, and checks that forgotten vertices were introduced. */
+    private static class Collector implements StateVector<Integer> {
+        final Set<Integer> vertices = new HashSet<>();
+        final Set<String> edges = new HashSet<>();
+
+        @Override
+        public StateVector<Integer> introduce(Bag<Integer> bag, Integer v, Map<Integer, Integer> treeIndex) {
+            assertTrue(bag.contains(v));
+            vertices.add(v);
+            return this;
+        }
+
+        @Override
+        public StateVector<Integer> forget(Bag<Integer> bag, Integer v, Map<Integer, Integer> treeIndex) {
+            assertFalse(bag.contains(v));
+            assertTrue(vertices.contains(v));
+            return this;
+        }
+
+        @Override
+        public StateVector<Integer> join(Bag<Integer> bag, StateVector<Integer> o, Map<Integer, Integer> treeIndex) {
+            vertices.addAll(((Collector) o).vertices);
+            for (String e : ((Collector) o).edges) assertTrue(edges.add(e));
+            return this;
+        }
+
+        @Override
+        public StateVector<Integer> edge(Bag<Integer> bag, Integer v, Integer w, Map<Integer, Integer> treeIndex) {
+            assertTrue(edges.add(Math.min(v, w) + " " + Math.max(v, w))); // every edge is introduced once
+            return this;
+        }
+
+        @Override
+        public boolean shouldReduce(Bag<Integer> bag, Map<Integer, Integer> treeIndex) {
+            return false;
+        }
+
+        @Override
+        public void reduce(Bag<Integer> bag, Map<Integer, Integer> treeIndex) {
+        }
+    }
+
+    @org.junit.Test
+    public void roundTrip() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 5 + rng.nextInt(30));
+            TreeDecomposition<Integer> td = new GreedyPermutationDecomposer<>(G).call();
+            CompactTreeDecomposition<Integer> compact = new CompactTreeDecomposition<>(td);
+            assertEquals(td.getNumberOfBags(), compact.getNumberOfBags());
+            assertEquals(td.getWidth(), compact.getWidth());
+            assertTrue(compact.isValid());
+
+            // the bags of the original decomposition are stored sorted under their ids
+            for (Bag<Integer> bag : td.getBags()) {
+                int b = -1;
+                for (int j = 0; j < compact.getNumberOfBags(); j++) if (compact.getBagId(j) == bag.id) b = j;
+                assertTrue(b >= 0);
+                assertEquals(bag.vertices.size(), compact.getBagSize(b));
+                for (int v : compact.getBag(b)) assertTrue(bag.contains(compact.getVertex(v)));
+            }
+
+            // bag j gets id j+1 in the restored decomposition, whose compact representation has the same rooted tree
+            TreeDecomposition<Integer> restored = compact.toTreeDecomposition();
+            assertEquals(td.getNumberOfBags(), restored.getNumberOfBags());
+            assertEquals(td.getWidth(), restored.getWidth());
+            assertTrue(restored.isValid());
+            CompactTreeDecomposition<Integer> again = new CompactTreeDecomposition<>(restored);
+            assertEquals(compact.getNumberOfRoots(), again.getNumberOfRoots());
+            for (int j = 0; j < again.getNumberOfBags(); j++) {
+                int b = again.getBagId(j) - 1;
+                assertArrayEquals(compact.getBag(b), again.getBag(j));
+                int p = again.getParent(j);
+                assertEquals(compact.getParent(b), p < 0 ? -1 : again.getBagId(p) - 1);
+            }
+        }
+    }
+
+    @org.junit.Test
+    public void rootedAtGivenBag() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 5 + rng.nextInt(30));
+            TreeDecomposition<Integer> td = new GreedyPermutationDecomposer<>(G).call();
+            Bag<Integer>[] bags = td.getBags().toArray(new Bag[0]);
+            Bag<Integer> root = bags[rng.nextInt(bags.length)];
+            CompactTreeDecomposition<Integer> compact = new CompactTreeDecomposition<>(td, root);
+            assertEquals(root.id, compact.getBagId(0));
+            assertEquals(-1, compact.getParent(0));
+            for (int j = compact.getNumberOfRoots(); j < compact.getNumberOfBags(); j++) {
+                assertTrue(compact.getParent(j) < j);
+            }
+            assertTrue(compact.isValid());
+        }
+    }
+
+    @org.junit.Test
+    public void dynamicProgram() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 5 + rng.nextInt(30));
+            for (boolean veryNice : new boolean[] {false, true}) {
+                TreeDecomposition<Integer> td = new GreedyPermutationDecomposer<>(G).call();
+                CompactTreeDecomposition<Integer> compact = new CompactTreeDecomposition<>(td);
+                Collector fromCompact = (Collector) new DynamicProgrammingOnTreeDecomposition<>(G, tw -> new Collector(), veryNice, compact).run();
+                Collector fromTree = (Collector) new DynamicProgrammingOnTreeDecomposition<>(G, tw -> new Collector(), veryNice, td).run();
+                assertEquals(G.getCopyOfVertices(), fromCompact.vertices);
+                assertEquals(G.getCopyOfVertices(), fromTree.vertices);
+                if (!veryNice) continue;
+                for (String e : fromCompact.edges) {
+                    int[] uv = Arrays.stream(e.split(" ")).mapToInt(Integer::parseInt).toArray();
+                    assertTrue(G.isAdjacent(uv[0], uv[1]));
+                }
+            }
+        }
+    }
+
+}
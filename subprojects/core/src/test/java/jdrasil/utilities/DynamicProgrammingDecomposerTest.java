@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.exact.DynamicProgrammingDecomposer;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the parallel mode of the DynamicProgrammingDecomposer, which has to find decompositions of the same width
+ * as the sequential TWDP on random graphs.
+ *
+ * @author Max Bannach
+ */
+public class DynamicProgrammingDecomposerTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 30;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random graph over {1,...,n} with edge probability p. */
+    private Graph<Integer> randomGraph(Random rng, int n, double p) {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= n; v++) G.addVertex(v);
+        for (int u = 1; u <= n; u++) {
+            for (int v = u+1; v <= n; v++) if (rng.nextDouble() < p) G.addEdge(u, v);
+        }
+        return G;
+    }
+
+    @org.junit.Test
+    public void parallelTWDP() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 2 + rng.nextInt(14), 0.1 + 0.6 * rng.nextDouble());
+            TreeDecomposition<Integer> sequential = new DynamicProgrammingDecomposer<>(G, DynamicProgrammingDecomposer.Mode.TWDP).call();
+            TreeDecomposition<Integer> parallel = new DynamicProgrammingDecomposer<>(G, DynamicProgrammingDecomposer.Mode.parallelTWDP).call();
+            assertTrue(parallel.isValid());
+            assertEquals(sequential.getWidth(), parallel.getWidth());
+        }
+    }
+
+}
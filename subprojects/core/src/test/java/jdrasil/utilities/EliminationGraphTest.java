@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.exact.BranchAndBoundDecomposer;
+import jdrasil.algorithms.exact.DynamicProgrammingDecomposer;
+import jdrasil.graph.EliminationGraph;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+
+import java.util.*;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the EliminationGraph, which has to behave like Graph.eliminateVertex() on random graphs, has to restore
+ * earlier states with undo() and rollback(), and is used by the BranchAndBoundDecomposer.
+ *
+ * @author Max Bannach
+ */
+public class EliminationGraphTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 30;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random graph over {1,...,n} with edge probability p. */
+    private Graph<Integer> randomGraph(Random rng, int n, double p) {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= n; v++) G.addVertex(v);
+        for (int u = 1; u <= n; u++) {
+            for (int v = u+1; v <= n; v++) if (rng.nextDouble() < p) G.addEdge(u, v);
+        }
+        return G;
+    }
+
+    /* A random vertex of the elimination graph that is not eliminated yet. */
+    private int randomVertex(EliminationGraph<Integer> E, Random rng) {
+        int v;
+        do { v = rng.nextInt(E.getNumIds()); } while (E.isEliminated(v));
+        return v;
+    }
+
+    /* The neighborhood of v in E as sorted array. */
+    private int[] neighborhood(EliminationGraph<Integer> E, int v) {
+        int[] N = new int[E.getDegree(v)];
+        for (int i = 0; i < N.length; i++) N[i] = E.getNeighbor(v, i);
+        Arrays.sort(N);
+        return N;
+    }
+
+    /* The number of missing edges in the neighborhood of v in G. */
+    private int bruteForceFillIn(Graph<Integer> G, Integer v) {
+        List<Integer> N = new ArrayList<>(G.getNeighborhood(v));
+        int fill = 0;
+        for (int i = 0; i < N.size(); i++) {
+            for (int j = i+1; j < N.size(); j++) if (!G.isAdjacent(N.get(i), N.get(j))) fill++;
+        }
+        return fill;
+    }
+
+    /* Everything that can be observed from the outside: counters, eliminated vertices, neighborhoods and fill-in values. */
+    private List<Object> snapshot(EliminationGraph<Integer> E) {
+        List<Object> state = new ArrayList<>();
+        state.add(E.getNumVertices());
+        state.add(E.getNumberOfEdges());
+        for (int v = 0; v < E.getNumIds(); v++) {
+            state.add(E.isEliminated(v));
+            if (E.isEliminated(v)) continue;
+            state.add(Arrays.toString(neighborhood(E, v)));
+            state.add(E.getFillInValue(v));
+        }
+        return state;
+    }
+
+    /* Eliminate a random vertex or add a random missing edge. */
+    private void randomOperation(EliminationGraph<Integer> E, Random rng) {
+        if (E.getNumVertices() >= 2 && rng.nextInt(3) == 0) {
+            int u = randomVertex(E, rng);
+            int w = randomVertex(E, rng);
+            if (u != w && !E.isAdjacent(u, w)) {
+                E.addEdge(u, w);
+                return;
+            }
+        }
+        E.eliminateVertex(randomVertex(E, rng));
+    }
+
+    @org.junit.Test
+    public void eliminationMatchesGraph() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 1 + rng.nextInt(40), 0.05 + 0.4 * rng.nextDouble());
+            EliminationGraph<Integer> E = new EliminationGraph<>(G, true);
+            Graph<Integer> H = GraphFactory.copy(G);
+            while (E.getNumVertices() > 0) {
+                int v = randomVertex(E, rng);
+                assertEquals(bruteForceFillIn(H, E.getVertex(v)), E.getFillInValue(v));
+                E.eliminateVertex(v);
+                H.eliminateVertex(E.getVertex(v));
+
+                // compare the remaining graphs
+                assertEquals(H.getNumVertices(), E.getNumVertices());
+                assertEquals(H.getNumberOfEdges(), E.getNumberOfEdges());
+                for (int u = 0; u < E.getNumIds(); u++) {
+                    assertEquals(!H.containsNode(E.getVertex(u)), E.isEliminated(u));
+                    if (E.isEliminated(u)) continue;
+                    Set<Integer> N = new HashSet<>();
+                    for (int w : neighborhood(E, u)) N.add(E.getVertex(w));
+                    assertEquals(H.getNeighborhood(E.getVertex(u)), N);
+                    assertEquals(bruteForceFillIn(H, E.getVertex(u)), E.getFillInValue(u));
+                }
+            }
+        }
+    }
+
+    @org.junit.Test
+    public void undo() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 1 + rng.nextInt(30), 0.05 + 0.4 * rng.nextDouble());
+            EliminationGraph<Integer> E = new EliminationGraph<>(G, true);
+            Deque<List<Object>> states = new ArrayDeque<>();
+            while (E.getNumVertices() > 0) {
+                states.push(snapshot(E));
+                randomOperation(E, rng);
+            }
+            while (!states.isEmpty()) {
+                E.undo();
+                assertEquals(states.pop(), snapshot(E));
+            }
+        }
+    }
+
+    @org.junit.Test
+    public void rollback() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 1 + rng.nextInt(30), 0.05 + 0.4 * rng.nextDouble());
+            EliminationGraph<Integer> E = new EliminationGraph<>(G, true);
+            List<Object> initial = snapshot(E);
+
+            // go to a random intermediate state and remember it
+            int steps = rng.nextInt(E.getNumVertices());
+            for (int s = 0; s < steps; s++) randomOperation(E, rng);
+            int checkpoint = E.getCheckpoint();
+            List<Object> intermediate = snapshot(E);
+
+            // branch off several times and return to the checkpoint
+            for (int branch = 0; branch < 3; branch++) {
+                while (E.getNumVertices() > 0 && rng.nextInt(4) != 0) randomOperation(E, rng);
+                E.rollback(checkpoint);
+                assertEquals(intermediate, snapshot(E));
+            }
+            E.rollback(0);
+            assertEquals(initial, snapshot(E));
+        }
+    }
+
+    @org.junit.Test
+    public void branchAndBound() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 2 + rng.nextInt(11), 0.1 + 0.6 * rng.nextDouble());
+            TreeDecomposition<Integer> bb = new BranchAndBoundDecomposer<>(G).call();
+            TreeDecomposition<Integer> dp = new DynamicProgrammingDecomposer<>(G, DynamicProgrammingDecomposer.Mode.TWDP).call();
+            assertTrue(bb.isValid());
+            assertEquals(dp.getWidth(), bb.getWidth());
+        }
+    }
+
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.graph.GrParser;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.ParallelGrParser;
+
+import java.io.BufferedReader;
+import java.io.ByteArrayInputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.StringReader;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.StandardOpenOption;
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the byte level GrParser and the ParallelGrParser, which have to build the same graphs as the line based
+ * parser of the GraphFactory -- also if the input contains comments, blank lines, .dgf edges, and Windows line breaks.
+ *
+ * @author Max Bannach
+ */
+public class GrParserTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 20;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random graph in .gr format with comments, blank lines, and .dgf edges between the edges. */
+    private String randomGr(Random rng, int n, int m, String newline) {
+        StringBuilder sb = new StringBuilder();
+        sb.append("c random graph").append(newline);
+        sb.append("p tw ").append(n).append(" ").append(m).append(newline);
+        for (int i = 0; i < m; i++) {
+            int u = 1 + rng.nextInt(n);
+            int v = 1 + rng.nextInt(n);
+            if (u == v) v = 1 + (v % n); // the line based parser would keep self loops
+            if (rng.nextInt(100) == 0) sb.append("c comment").append(newline);
+            if (rng.nextInt(100) == 0) sb.append(newline);
+            if (rng.nextInt(10) == 0) sb.append("e ");
+            sb.append(u).append(" ").append(v).append(newline);
+        }
+        return sb.toString();
+    }
+
+    /* Parse the input with the line based parser of the GraphFactory. */
+    private Graph<Integer> readWithReader(String gr) throws IOException {
+        return GraphFactory.graphFromBufferedReaderGR(new BufferedReader(new StringReader(gr)));
+    }
+
+    /* Check that both graphs have the same vertices, edges, and fill-in values. */
+    private void assertSameGraph(Graph<Integer> expected, Graph<Integer> actual) {
+        assertEquals(expected.getNumVertices(), actual.getNumVertices());
+        assertEquals(expected.getNumberOfEdges(), actual.getNumberOfEdges());
+        for (Integer v : expected) {
+            assertEquals(expected.getNeighborhood(v), actual.getNeighborhood(v));
+            assertEquals(expected.getFillInValue(v), actual.getFillInValue(v));
+        }
+    }
+
+    @org.junit.Test
+    public void sequentialParser() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            int n = 2 + rng.nextInt(100);
+            String gr = randomGr(rng, n, rng.nextInt(4*n), "\n");
+            byte[] bytes = gr.getBytes(StandardCharsets.US_ASCII);
+            Graph<Integer> expected = readWithReader(gr);
+
+            GrParser fromBuffer = new GrParser(ByteBuffer.wrap(bytes)).parse();
+            assertEquals(bytes.length, fromBuffer.getNumBytes());
+            assertSameGraph(expected, GraphFactory.graphFromIntGraph(fromBuffer.toIntGraph()));
+            assertSameGraph(expected, GraphFactory.graphFromChannelGR(Channels.newChannel(new ByteArrayInputStream(bytes))));
+        }
+    }
+
+    @org.junit.Test
+    public void windowsLineBreaks() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            int n = 2 + rng.nextInt(100);
+            int m = rng.nextInt(4*n);
+            long seed = rng.nextLong();
+            Graph<Integer> expected = readWithReader(randomGr(new Random(seed), n, m, "\n"));
+            byte[] crlf = randomGr(new Random(seed), n, m, "\r\n").getBytes(StandardCharsets.US_ASCII);
+            assertSameGraph(expected, GraphFactory.graphFromIntGraph(new GrParser(ByteBuffer.wrap(crlf)).parse().toIntGraph()));
+        }
+    }
+
+    @org.junit.Test
+    public void parallelParser() throws Exception {
+        // the input has to be larger than a chunk (1 MB) to be split, and larger than a block to test refills
+        Random rng = new Random(SEED);
+        int n = 50000, m = 300000;
+        long seed = rng.nextLong();
+        String gr = randomGr(new Random(seed), n, m, "\n");
+        Graph<Integer> expected = readWithReader(gr);
+        for (String newline : new String[] {"\n", "\r\n"}) {
+            File file = File.createTempFile("jdrasil-test", ".gr");
+            file.deleteOnExit();
+            Files.write(file.toPath(), randomGr(new Random(seed), n, m, newline).getBytes(StandardCharsets.US_ASCII));
+            try (FileChannel in = FileChannel.open(file.toPath(), StandardOpenOption.READ)) {
+                ParallelGrParser parser = new ParallelGrParser(in).parse();
+                assertEquals(file.length(), parser.getNumBytes());
+                assertSameGraph(expected, GraphFactory.graphFromIntGraph(parser.toIntGraph()));
+            }
+            assertSameGraph(expected, GraphFactory.graphFromGr(file));
+            file.delete();
+        }
+    }
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.exact.DynamicProgrammingDecomposer;
+import jdrasil.algorithms.preprocessing.GraphRelabeler;
+import jdrasil.algorithms.upperbounds.GreedyPermutationDecomposer;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+
+import java.util.HashSet;
+import java.util.Random;
+import java.util.Set;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the GraphRelabeler, which has to produce isomorphic graphs under all orders and has to map tree
+ * decompositions of the relabeled graph back to valid tree decompositions of the original graph.
+ *
+ * @author Max Bannach
+ */
+public class GraphRelabelerTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 30;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random graph with n vertices with scattered labels and edge probability p. */
+    private Graph<Integer> randomGraph(Random rng, int n, double p) {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= n; v++) G.addVertex(7*v + 3);
+        for (int u = 1; u <= n; u++) {
+            for (int v = u+1; v <= n; v++) if (rng.nextDouble() < p) G.addEdge(7*u + 3, 7*v + 3);
+        }
+        return G;
+    }
+
+    @org.junit.Test
+    public void isomorphism() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 1 + rng.nextInt(50), 0.02 + 0.3 * rng.nextDouble());
+            for (GraphRelabeler.Order order : GraphRelabeler.Order.values()) {
+                GraphRelabeler<Integer> relabeler = new GraphRelabeler<>(G, order);
+                Graph<Integer> H = relabeler.getRelabeledGraph();
+                assertEquals(G.getNumVertices(), H.getNumVertices());
+                assertEquals(G.getNumberOfEdges(), H.getNumberOfEdges());
+
+                // the relabeled graph is over {1,...,n} and the mapping is an isomorphism
+                Set<Integer> original = new HashSet<>();
+                for (int v = 1; v <= H.getNumVertices(); v++) {
+                    assertTrue(H.containsNode(v));
+                    original.add(relabeler.getOriginalVertex(v));
+                    Set<Integer> N = new HashSet<>();
+                    for (Integer w : H.getNeighborhood(v)) N.add(relabeler.getOriginalVertex(w));
+                    assertEquals(G.getNeighborhood(relabeler.getOriginalVertex(v)), N);
+                }
+                assertEquals(G.getCopyOfVertices(), original);
+            }
+        }
+    }
+
+    @org.junit.Test
+    public void restoreTreeDecomposition() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 2 + rng.nextInt(40), 0.05 + 0.3 * rng.nextDouble());
+            for (GraphRelabeler.Order order : GraphRelabeler.Order.values()) {
+                GraphRelabeler<Integer> relabeler = new GraphRelabeler<>(G, order);
+                TreeDecomposition<Integer> td = new GreedyPermutationDecomposer<>(relabeler.getRelabeledGraph()).call();
+                TreeDecomposition<Integer> restored = relabeler.restoreTreeDecomposition(td);
+                assertTrue(restored.isValid());
+                assertEquals(td.getWidth(), restored.getWidth());
+                assertEquals(td.getNumberOfBags(), restored.getNumberOfBags());
+            }
+        }
+    }
+
+    @org.junit.Test
+    public void treewidth() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 2 + rng.nextInt(12), 0.1 + 0.6 * rng.nextDouble());
+            int tw = new DynamicProgrammingDecomposer<>(G, DynamicProgrammingDecomposer.Mode.TWDP).call().getWidth();
+            for (GraphRelabeler.Order order : GraphRelabeler.Order.values()) {
+                GraphRelabeler<Integer> relabeler = new GraphRelabeler<>(G, order);
+                TreeDecomposition<Integer> td = new DynamicProgrammingDecomposer<>(relabeler.getRelabeledGraph(), DynamicProgrammingDecomposer.Mode.TWDP).call();
+                TreeDecomposition<Integer> restored = relabeler.restoreTreeDecomposition(td);
+                assertTrue(restored.isValid());
+                assertEquals(tw, restored.getWidth());
+            }
+        }
+    }
+
+}
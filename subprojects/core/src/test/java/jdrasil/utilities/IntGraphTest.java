@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.IntGraph;
+import jdrasil.graph.invariants.ConnectedComponents;
+
+import java.util.HashSet;
+import java.util.List;
+import java.util.Random;
+import java.util.Set;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the IntGraph that converts random graphs to the compressed representation and back, and compares its
+ * connected components with the ones computed on the Graph.
+ *
+ * @author Max Bannach
+ */
+public class IntGraphTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 30;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random graph over {offset+1,...,offset+n}, which may contain self loops and edges that are added twice. */
+    private void addRandomGraph(Graph<Integer> G, Random rng, int offset, int n, int m) {
+        for (int v = 1; v <= n; v++) G.addVertex(offset + v);
+        for (int i = 0; i < m; i++) {
+            int u = offset + 1 + rng.nextInt(n);
+            int v = offset + 1 + rng.nextInt(n);
+            G.addEdge(u, v);
+            if (rng.nextInt(10) == 0) G.addEdge(v, u);
+        }
+    }
+
+    /* The neighborhood of v in G without v itself. */
+    private Set<Integer> neighborhood(Graph<Integer> G, Integer v) {
+        Set<Integer> N = new HashSet<>(G.getNeighborhood(v));
+        N.remove(v);
+        return N;
+    }
+
+    @org.junit.Test
+    public void roundTrip() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = GraphFactory.emptyGraph();
+            int n = 1 + rng.nextInt(50);
+            addRandomGraph(G, rng, 0, n, rng.nextInt(3*n));
+            IntGraph<Integer> I = new IntGraph<>(G);
+            assertEquals(G.getNumVertices(), I.getNumVertices());
+
+            // the rows are sorted, free of duplicates and self loops, and contain the neighbors of the vertex
+            int degrees = 0;
+            for (int v = 0; v < I.getNumVertices(); v++) {
+                int[] row = I.getNeighborhood(v);
+                assertEquals(I.neighborhoodEnd(v) - I.neighborhoodStart(v), row.length);
+                for (int j = 0; j < row.length; j++) {
+                    assertEquals(I.getTargets()[I.neighborhoodStart(v) + j], row[j]);
+                    if (j > 0) assertTrue(row[j-1] < row[j]);
+                    assertNotEquals(v, row[j]);
+                    assertTrue(I.isAdjacent(v, row[j]));
+                }
+                Set<Integer> N = new HashSet<>();
+                for (int w : row) N.add(I.getVertex(w));
+                assertEquals(neighborhood(G, I.getVertex(v)), N);
+                assertEquals(v, I.getId(I.getVertex(v)));
+                degrees += row.length;
+            }
+            assertEquals(degrees / 2, I.getNumberOfEdges());
+
+            // and back to a Graph with the same vertices and edges
+            Graph<Integer> H = I.toGraph();
+            assertEquals(G.getCopyOfVertices(), H.getCopyOfVertices());
+            for (Integer v : G) assertEquals(neighborhood(G, v), H.getNeighborhood(v));
+            assertEquals(I.getNumberOfEdges(), H.getNumberOfEdges());
+        }
+    }
+
+    @org.junit.Test
+    public void connectedComponents() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            // a disconnected graph made of several sparse random graphs
+            Graph<Integer> G = GraphFactory.emptyGraph();
+            int parts = 1 + rng.nextInt(5);
+            for (int p = 0; p < parts; p++) {
+                int n = 1 + rng.nextInt(20);
+                addRandomGraph(G, rng, 100*p, n, rng.nextInt(2*n));
+            }
+            IntGraph<Integer> I = new IntGraph<>(G);
+            assertEquals(G.getConnectedComponents().size(), I.getNumberOfConnectedComponents());
+
+            // remove a random separator and compare the components as sets and as induced subgraphs
+            Set<Integer> S = new HashSet<>();
+            for (Integer v : G) if (rng.nextInt(5) == 0) S.add(v);
+            List<Graph<Integer>> components = I.getComponentsAsSubgraphs(S);
+            Set<Set<Integer>> expected = new ConnectedComponents<>(G, S).getAsSets();
+            Set<Set<Integer>> actual = new HashSet<>();
+            for (Graph<Integer> C : components) {
+                actual.add(C.getCopyOfVertices());
+                Graph<Integer> induced = GraphFactory.graphFromSubgraph(G, C.getCopyOfVertices());
+                for (Integer v : C) assertEquals(neighborhood(induced, v), C.getNeighborhood(v));
+            }
+            assertEquals(expected.size(), components.size());
+            assertEquals(expected, actual);
+        }
+    }
+
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.datastructures.LongIntHashMap;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the LongIntHashMap that performs pseudo random insertions and compares the map with a HashMap.
+ *
+ * @author Max Bannach
+ */
+public class LongIntHashMapTest {
+
+    /* how many operations are performed? */
+    private final int TEST_SIZE = 100000;
+
+    /* Seed for the random number generator used to create keys */
+    private final long SEED = 123456789;
+
+    @org.junit.Test
+    public void putAndPutMin() throws Exception {
+        Random rng = new Random(SEED);
+        LongIntHashMap map = new LongIntHashMap();
+        Map<Long, Integer> reference = new HashMap<>();
+        for (int i = 0; i < TEST_SIZE; i++) {
+            long key = 1 + rng.nextInt(5000) * 0x100000001L; // few keys with equal lower bits
+            int value = rng.nextInt(1000);
+            if (rng.nextBoolean()) {
+                map.put(key, value);
+                reference.put(key, value);
+            } else {
+                map.putMin(key, value);
+                reference.merge(key, value, Math::min);
+            }
+        }
+        assertEquals(reference.size(), map.size());
+        for (Map.Entry<Long, Integer> entry : reference.entrySet()) {
+            assertEquals((int) entry.getValue(), map.get(entry.getKey(), -1));
+        }
+        int stored = 0;
+        for (int slot = 0; slot < map.capacity(); slot++) {
+            if (map.keyAt(slot) == 0) continue;
+            assertEquals((int) reference.get(map.keyAt(slot)), map.valueAt(slot));
+            stored++;
+        }
+        assertEquals(reference.size(), stored);
+        assertFalse(map.containsKey(0));
+        assertEquals(-1, map.get(2, -1));
+    }
+
+}
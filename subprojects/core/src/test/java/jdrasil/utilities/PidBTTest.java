@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.exact.DynamicProgrammingDecomposer;
+import jdrasil.algorithms.exact.PidBT;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the parallel mode of PidBT, in which I-blocks are expanded in batches. It has to give the same answers as
+ * the sequential mode on random graphs.
+ *
+ * @author Max Bannach
+ */
+public class PidBTTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 30;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random connected graph over {1,...,n}, i.e., a random tree with additional edges of probability p. */
+    private Graph<Integer> randomGraph(Random rng, int n, double p) {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= n; v++) G.addVertex(v);
+        for (int v = 2; v <= n; v++) G.addEdge(1 + rng.nextInt(v-1), v);
+        for (int u = 1; u <= n; u++) {
+            for (int v = u+1; v <= n; v++) if (rng.nextDouble() < p) G.addEdge(u, v);
+        }
+        return G;
+    }
+
+    @org.junit.Test
+    public void decide() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 3 + rng.nextInt(15), 0.1 + 0.4 * rng.nextDouble());
+            int tw = new DynamicProgrammingDecomposer<>(G, DynamicProgrammingDecomposer.Mode.TWDP).call().getWidth();
+            PidBT<Integer> sequential = new PidBT<>(G);
+            PidBT<Integer> parallel = new PidBT<>(G);
+            parallel.setParallel(true);
+
+            // both modes reject every k below the tree width and accept the tree width
+            int k = 1;
+            while (true) {
+                boolean answer = sequential.decide(k);
+                assertEquals(answer, parallel.decide(k));
+                assertEquals(k >= tw, answer);
+                if (answer) break;
+                k++;
+            }
+
+            // and build valid decompositions of that width
+            TreeDecomposition<Integer> sequentialTD = sequential.getTreeDecomposition(k);
+            TreeDecomposition<Integer> parallelTD = parallel.getTreeDecomposition(k);
+            assertTrue(sequentialTD.isValid());
+            assertTrue(parallelTD.isValid());
+            assertEquals(tw, sequentialTD.getWidth());
+            assertEquals(tw, parallelTD.getWidth());
+            sequential.release();
+            parallel.release();
+        }
+    }
+
+    @org.junit.Test
+    public void call() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 3 + rng.nextInt(25), 0.05 + 0.3 * rng.nextDouble());
+            TreeDecomposition<Integer> sequential = new PidBT<>(G).call();
+            PidBT<Integer> pidBT = new PidBT<>(G);
+            pidBT.setParallel(true);
+            TreeDecomposition<Integer> parallel = pidBT.call();
+            assertTrue(sequential.isValid());
+            assertTrue(parallel.isValid());
+            assertEquals(sequential.getWidth(), parallel.getWidth());
+        }
+    }
+
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.exact.PidBT;
+import jdrasil.algorithms.exact.SpeculativePidBT;
+import jdrasil.algorithms.upperbounds.GreedyPermutationDecomposer;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the SpeculativePidBT, which has to find decompositions of the same width as PidBT on random graphs, and for
+ * the cancellation of PidBT instances it relies on.
+ *
+ * @author Max Bannach
+ */
+public class SpeculativePidBTTest {
+
+    /* how many random graphs are tested? */
+    private final int TEST_SIZE = 30;
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* Create a random connected graph over {1,...,n}, i.e., a random tree with additional edges of probability p. */
+    private Graph<Integer> randomGraph(Random rng, int n, double p) {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= n; v++) G.addVertex(v);
+        for (int v = 2; v <= n; v++) G.addEdge(1 + rng.nextInt(v-1), v);
+        for (int u = 1; u <= n; u++) {
+            for (int v = u+1; v <= n; v++) if (rng.nextDouble() < p) G.addEdge(u, v);
+        }
+        return G;
+    }
+
+    @org.junit.Test
+    public void sameWidth() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 3 + rng.nextInt(25), 0.05 + 0.3 * rng.nextDouble());
+            TreeDecomposition<Integer> ubTD = new GreedyPermutationDecomposer<>(G).call();
+            int tw = new PidBT<>(G).call().getWidth();
+            MemoryBudget budget = new MemoryBudget(1 << 20);
+            TreeDecomposition<Integer> td = new SpeculativePidBT<>(G, 1, ubTD.getWidth(), ubTD, budget, 1 + rng.nextInt(4)).call();
+            assertTrue(td.isValid());
+            assertEquals(tw, td.getWidth());
+            assertEquals(0, budget.getConsumers());
+        }
+    }
+
+    @org.junit.Test
+    public void cancelLargerWidths() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            // without upper bound there is a worker for every width, so workers on larger widths often finish first
+            // and have to be cancelled by the ones on smaller widths
+            Graph<Integer> G = randomGraph(rng, 3 + rng.nextInt(15), 0.1 + 0.4 * rng.nextDouble());
+            int tw = new PidBT<>(G).call().getWidth();
+            MemoryBudget budget = new MemoryBudget(1 << 16);
+            TreeDecomposition<Integer> td = new SpeculativePidBT<>(G, 1, 0, null, budget, G.getNumVertices()).call();
+            assertTrue(td.isValid());
+            assertEquals(tw, td.getWidth());
+            assertEquals(0, budget.getConsumers());
+        }
+    }
+
+    @org.junit.Test
+    public void cancelAndRelease() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            Graph<Integer> G = randomGraph(rng, 4 + rng.nextInt(15), 0.1 + 0.3 * rng.nextDouble());
+            int tw = new PidBT<>(G).call().getWidth();
+            if (tw >= G.getNumVertices()-1) continue; // trivial widths are accepted without search
+
+            // a cancelled instance rejects every width
+            PidBT<Integer> cancelled = new PidBT<>(G);
+            cancelled.cancel();
+            assertTrue(cancelled.isCancelled());
+            assertFalse(cancelled.decide(tw));
+            cancelled.release();
+
+            // a released instance still works, it just does not memorize anymore
+            MemoryBudget budget = new MemoryBudget(1 << 16);
+            PidBT<Integer> released = new PidBT<>(G, 1, G.getNumVertices()-1, null, budget);
+            assertEquals(1, budget.getConsumers());
+            released.release();
+            assertEquals(0, budget.getConsumers());
+            for (int k = 1; k < tw; k++) assertFalse(released.decide(k));
+            assertTrue(released.decide(tw));
+            TreeDecomposition<Integer> td = released.getTreeDecomposition(tw);
+            assertTrue(td.isValid());
+            assertEquals(tw, td.getWidth());
+            released.release();
+            assertEquals(0, budget.getConsumers());
+        }
+    }
+
+}
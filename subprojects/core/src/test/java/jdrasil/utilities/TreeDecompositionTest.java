@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.algorithms.upperbounds.GreedyPermutationDecomposer;
+import jdrasil.graph.Bag;
+import jdrasil.graph.CompactTreeDecomposition;
+import jdrasil.graph.Graph;
+import jdrasil.graph.GraphFactory;
+import jdrasil.graph.TreeDecomposition;
+
+import java.util.Arrays;
+import java.util.HashSet;
+import java.util.Random;
+import java.util.Set;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the validation of tree decompositions by TreeDecomposition.isValid() and CompactTreeDecomposition.isValid(),
+ * both sequential and with the -parallel flag.
+ *
+ * @author Max Bannach
+ */
+public class TreeDecompositionTest {
+
+    /* Seed for the random number generator used to create graphs */
+    private final long SEED = 123456789;
+
+    /* A test that runs once sequentially and once in parallel mode. */
+    private interface ValidationTest {
+        void run() throws Exception;
+    }
+
+    /* Run the test without and with the parallel flag. */
+    private void inBothModes(ValidationTest test) throws Exception {
+        test.run();
+        JdrasilProperties.setProperty("parallel", "");
+        try {
+            test.run();
+        } finally {
+            JdrasilProperties.removeProperty("parallel");
+        }
+    }
+
+    /* The path 1 - 2 - 3 - 4. */
+    private Graph<Integer> path() {
+        Graph<Integer> G = GraphFactory.emptyGraph();
+        for (int v = 1; v <= 4; v++) G.addVertex(v);
+        for (int v = 1; v < 4; v++) G.addEdge(v, v+1);
+        return G;
+    }
+
+    /* Create a tree decomposition of G with the given bags, connected as path in the given order. */
+    private TreeDecomposition<Integer> pathDecomposition(Graph<Integer> G, Integer[]... bags) {
+        TreeDecomposition<Integer> td = new TreeDecomposition<>(G);
+        Bag<Integer> last = null;
+        for (Integer[] bag : bags) {
+            Bag<Integer> next = td.createBag(new HashSet<>(Arrays.asList(bag)));
+            if (last != null) td.addTreeEdge(last, next);
+            last = next;
+        }
+        return td;
+    }
+
+    /* Check both representations of the decomposition. */
+    private void assertValid(boolean expected, TreeDecomposition<Integer> td) {
+        assertEquals(expected, new CompactTreeDecomposition<>(td).isValid());
+        assertEquals(expected, td.isValid());
+    }
+
+    @org.junit.Test
+    public void validDecomposition() throws Exception {
+        inBothModes(() -> {
+            Graph<Integer> G = path();
+            assertValid(true, pathDecomposition(G, new Integer[] {1, 2}, new Integer[] {2, 3}, new Integer[] {3, 4}));
+        });
+    }
+
+    @org.junit.Test
+    public void missingVertex() throws Exception {
+        inBothModes(() -> {
+            Graph<Integer> G = path();
+            assertValid(false, pathDecomposition(G, new Integer[] {1, 2}, new Integer[] {2, 3}));
+        });
+    }
+
+    @org.junit.Test
+    public void uncoveredEdge() throws Exception {
+        inBothModes(() -> {
+            Graph<Integer> G = path();
+            assertValid(false, pathDecomposition(G, new Integer[] {1, 2}, new Integer[] {2, 3}, new Integer[] {4}));
+        });
+    }
+
+    @org.junit.Test
+    public void disconnectedSubtree() throws Exception {
+        inBothModes(() -> {
+            Graph<Integer> G = path();
+            assertValid(false, pathDecomposition(G, new Integer[] {1, 2}, new Integer[] {3, 4}, new Integer[] {2, 3}));
+        });
+    }
+
+    @org.junit.Test
+    public void cyclicTree() throws Exception {
+        inBothModes(() -> {
+            Graph<Integer> G = path();
+            TreeDecomposition<Integer> td = pathDecomposition(G, new Integer[] {1, 2}, new Integer[] {2, 3}, new Integer[] {3, 4});
+            Bag<Integer> first = null, last = null;
+            for (Bag<Integer> bag : td.getBags()) {
+                if (first == null || bag.id < first.id) first = bag;
+                if (last == null || bag.id > last.id) last = bag;
+            }
+            td.addTreeEdge(first, last);
+            assertTrue(new CompactTreeDecomposition<>(td).isValid()); // the compact form only keeps a spanning tree
+            assertFalse(td.isValid());
+        });
+    }
+
+    @org.junit.Test
+    public void largeDecompositions() throws Exception {
+        // large enough that the parallel streams are split
+        inBothModes(() -> {
+            Random rng = new Random(SEED);
+            int n = 2000;
+            Graph<Integer> G = GraphFactory.emptyGraph();
+            for (int v = 1; v <= n; v++) G.addVertex(v);
+            for (int v = 1; v < n; v++) G.addEdge(v, v+1);
+            for (int i = 0; i < n; i++) {
+                int u = 1 + rng.nextInt(n);
+                int v = Math.min(n, u + 1 + rng.nextInt(10));
+                if (u != v) G.addEdge(u, v);
+            }
+            TreeDecomposition<Integer> td = new GreedyPermutationDecomposer<>(G).call();
+            assertValid(true, td);
+
+            // remove a vertex from all bags
+            int x = 1 + rng.nextInt(n);
+            Set<Bag<Integer>> withX = new HashSet<>();
+            for (Bag<Integer> bag : td.getBags()) if (bag.contains(x)) withX.add(bag);
+            for (Bag<Integer> bag : withX) bag.vertices.remove(x);
+            assertValid(false, td);
+        });
+    }
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.datastructures.VertexSet;
+import jdrasil.datastructures.VertexSetCache;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the VertexSetCache that performs pseudo random insertions and lookups and checks that cached values are
+ * correct and that the budget is respected.
+ *
+ * @author Max Bannach
+ */
+public class VertexSetCacheTest {
+
+    /* size of the universe */
+    private final int UNIVERSE_SIZE = 100;
+
+    /* how many operations are performed? */
+    private final int TEST_SIZE = 50000;
+
+    /* Seed for the random number generator used to create sets */
+    private final long SEED = 123456789;
+
+    /* Create a random set with few elements, such that keys repeat. */
+    private VertexSet randomSet(Random rng) {
+        VertexSet set = new VertexSet(UNIVERSE_SIZE);
+        for (int i = 0; i < 3; i++) set.set(rng.nextInt(12));
+        return set;
+    }
+
+    @org.junit.Test
+    public void boundedLookups() throws Exception {
+        Random rng = new Random(SEED);
+        long budget = 1 << 14;
+        VertexSetCache<Integer> cache = new VertexSetCache<>(budget, (key, value) -> key.sizeInBytes());
+        Map<VertexSet, Integer> reference = new HashMap<>();
+        for (int i = 0; i < TEST_SIZE; i++) {
+            VertexSet key = randomSet(rng);
+            if (rng.nextBoolean()) {
+                cache.put(key, key.cardinality());
+                reference.put(key, key.cardinality());
+            } else {
+                Integer value = cache.get(key);
+                if (value != null) assertEquals(reference.get(key), value);
+            }
+            assertTrue(cache.getWeight() <= budget);
+        }
+        assertTrue(cache.getHits() > 0);
+        assertTrue(cache.getEvictions() > 0);
+        assertTrue(cache.size() < reference.size());
+
+        cache.clear();
+        assertEquals(0, cache.size());
+        assertNull(cache.get(randomSet(rng)));
+    }
+
+    @org.junit.Test
+    public void sharedBudget() throws Exception {
+        Random rng = new Random(SEED);
+        MemoryBudget budget = new MemoryBudget(1 << 14);
+        budget.acquire();
+        VertexSetCache<Integer> cache = new VertexSetCache<>(budget::getShare, (key, value) -> key.sizeInBytes());
+        for (int i = 0; i < TEST_SIZE; i++) {
+            if (i == TEST_SIZE / 2) budget.acquire(); // a second consumer halves the share
+            VertexSet key = randomSet(rng);
+            cache.put(key, key.cardinality());
+            assertTrue(cache.getWeight() <= budget.getShare());
+        }
+        assertEquals(budget.getTotal() / 2, cache.getBudget());
+        budget.release();
+        budget.release();
+        assertEquals(0, budget.getConsumers());
+    }
+
+}
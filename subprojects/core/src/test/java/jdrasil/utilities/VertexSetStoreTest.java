@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.datastructures.VertexSet;
+import jdrasil.datastructures.VertexSetStore;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the VertexSetStore that adds pseudo random sets and checks that handles are stable and that the stored sets
+ * can be found and restored.
+ *
+ * @author Max Bannach
+ */
+public class VertexSetStoreTest {
+
+    /* size of the universe, not a multiple of 64 */
+    private final int UNIVERSE_SIZE = 150;
+
+    /* how many sets are added? */
+    private final int TEST_SIZE = 20000;
+
+    /* Seed for the random number generator used to create sets */
+    private final long SEED = 123456789;
+
+    /* Create a random set with few elements, such that sets repeat. */
+    private VertexSet randomSet(Random rng) {
+        VertexSet set = new VertexSet(UNIVERSE_SIZE);
+        for (int i = 0; i < 3; i++) set.set(rng.nextInt(UNIVERSE_SIZE) % 40 + (i * 50));
+        return set;
+    }
+
+    @org.junit.Test
+    public void stableHandles() throws Exception {
+        Random rng = new Random(SEED);
+        VertexSetStore store = new VertexSetStore(UNIVERSE_SIZE);
+        Map<VertexSet, Integer> reference = new HashMap<>();
+        List<VertexSet> sets = new ArrayList<>();
+        for (int i = 0; i < TEST_SIZE; i++) {
+            VertexSet set = randomSet(rng);
+            Integer expected = reference.get(set);
+            if (rng.nextBoolean()) {
+                int handle = store.add(set);
+                if (expected == null) {
+                    assertEquals(sets.size(), handle);
+                    reference.put(set, handle);
+                    sets.add(set);
+                } else {
+                    assertEquals((int) expected, handle);
+                }
+            } else {
+                assertEquals(expected == null ? -1 : (int) expected, store.find(set));
+            }
+        }
+        assertEquals(sets.size(), store.size());
+        VertexSet scratch = new VertexSet(UNIVERSE_SIZE);
+        for (int handle = 0; handle < sets.size(); handle++) {
+            assertEquals(sets.get(handle), store.get(handle));
+            assertEquals(sets.get(handle), store.get(handle, scratch));
+            assertEquals(sets.get(handle).cardinality(), store.cardinality(handle));
+        }
+
+        store.clear();
+        assertEquals(0, store.size());
+        assertFalse(store.contains(sets.get(0)));
+    }
+
+    @org.junit.Test
+    public void writeAndRead() throws Exception {
+        Random rng = new Random(SEED);
+        VertexSetStore store = new VertexSetStore(UNIVERSE_SIZE);
+        for (int i = 0; i < TEST_SIZE; i++) store.add(randomSet(rng));
+
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        store.write(new DataOutputStream(bytes));
+        VertexSetStore copy = VertexSetStore.read(new DataInputStream(new ByteArrayInputStream(bytes.toByteArray())));
+        assertEquals(store.size(), copy.size());
+        for (int handle = 0; handle < store.size(); handle++) {
+            assertEquals(store.get(handle), copy.get(handle));
+            assertEquals(handle, copy.find(store.get(handle)));
+        }
+        VertexSet set = new VertexSet(UNIVERSE_SIZE);
+        set.set(UNIVERSE_SIZE - 1); // not created by randomSet
+        assertEquals(store.size(), copy.add(set));
+    }
+
+}
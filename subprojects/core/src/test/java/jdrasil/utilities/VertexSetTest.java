@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2016-present, Max Bannach, Sebastian Berndt, Thorsten Ehlers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+package jdrasil.utilities;
+
+import jdrasil.datastructures.BitSetTrie;
+import jdrasil.datastructures.VertexSet;
+
+import java.util.BitSet;
+import java.util.HashSet;
+import java.util.Random;
+import java.util.Set;
+
+import static org.junit.Assert.*;
+
+/**
+ * Test for the VertexSet that performs pseudo random set operations on VertexSets and on BitSets and compares the
+ * results. Furthermore, VertexSets are used as queries for the BitSetTrie.
+ *
+ * @author Max Bannach
+ */
+public class VertexSetTest {
+
+    /* size of the universe, chosen such that the last word is only partially used */
+    private final int UNIVERSE_SIZE = 150;
+
+    /* how many random sets are tested? */
+    private final int TEST_SIZE = 1024;
+
+    /* Seed for the random number generator used to create sets */
+    private final long SEED = 123456789;
+
+    /* Create a random BitSet over the universe. */
+    private BitSet randomBitSet(Random rng) {
+        BitSet set = new BitSet();
+        double density = rng.nextDouble();
+        for (int i = 0; i < UNIVERSE_SIZE; i++) set.set(i, rng.nextDouble() < density);
+        return set;
+    }
+
+    @org.junit.Test
+    public void conversion() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            BitSet set = randomBitSet(rng);
+            VertexSet S = VertexSet.valueOf(set, UNIVERSE_SIZE);
+            assertEquals(set, S.toBitSet());
+            assertEquals(set.cardinality(), S.cardinality());
+            assertEquals(set.length(), S.length());
+            assertEquals(set.isEmpty(), S.isEmpty());
+            assertEquals(S, new VertexSet(S));
+            assertEquals(S.hashCode(), new VertexSet(S).hashCode());
+        }
+    }
+
+    @org.junit.Test
+    public void setOperations() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            BitSet a = randomBitSet(rng), b = randomBitSet(rng);
+            VertexSet A = VertexSet.valueOf(a, UNIVERSE_SIZE), B = VertexSet.valueOf(b, UNIVERSE_SIZE);
+
+            BitSet expected = (BitSet) a.clone();
+            expected.or(b);
+            assertEquals(expected, new VertexSet(A).or(B).toBitSet());
+
+            expected = (BitSet) a.clone();
+            expected.and(b);
+            assertEquals(expected, new VertexSet(A).and(B).toBitSet());
+
+            expected = (BitSet) a.clone();
+            expected.andNot(b);
+            assertEquals(expected, new VertexSet(A).andNot(B).toBitSet());
+            assertEquals(expected.isEmpty(), A.isSubsetOf(B));
+            assertEquals(a.intersects(b), A.intersects(B));
+
+            expected = (BitSet) a.clone();
+            expected.flip(0, UNIVERSE_SIZE);
+            assertEquals(expected, new VertexSet(A).complement().toBitSet());
+            assertEquals(UNIVERSE_SIZE, new VertexSet(UNIVERSE_SIZE).setAll().cardinality());
+        }
+    }
+
+    @org.junit.Test
+    public void iteration() throws Exception {
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            BitSet a = randomBitSet(rng), b = randomBitSet(rng);
+            VertexSet A = VertexSet.valueOf(a, UNIVERSE_SIZE), B = VertexSet.valueOf(b, UNIVERSE_SIZE);
+            BitSet difference = (BitSet) a.clone();
+            difference.andNot(b);
+            for (int v = 0; v < UNIVERSE_SIZE; v++) {
+                assertEquals(a.nextSetBit(v), A.nextSetBit(v));
+                assertEquals(a.previousSetBit(v), A.previousSetBit(v));
+                assertEquals(Math.min(a.nextClearBit(v), UNIVERSE_SIZE), A.nextClearBit(v));
+                assertEquals(difference.nextSetBit(v), A.nextSetBitNotIn(B, v));
+            }
+        }
+    }
+
+    @org.junit.Test
+    public void trieQueries() throws Exception {
+        BitSetTrie T = new BitSetTrie();
+        Set<BitSet> sets = new HashSet<>();
+        Random rng = new Random(SEED);
+        for (int i = 0; i < TEST_SIZE; i++) {
+            BitSet set = randomBitSet(rng);
+            sets.add(set);
+            T.insert(VertexSet.valueOf(set, UNIVERSE_SIZE));
+        }
+        for (BitSet set : sets) assertTrue(T.contains(VertexSet.valueOf(set, UNIVERSE_SIZE)));
+
+        // compare sub- and super-sets with a manual computation
+        for (int i = 0; i < 32; i++) {
+            BitSet query = randomBitSet(rng);
+            VertexSet Q = VertexSet.valueOf(query, UNIVERSE_SIZE);
+            Set<BitSet> subsets = new HashSet<>(), supersets = new HashSet<>();
+            for (BitSet set : sets) {
+                BitSet tmp = (BitSet) set.clone();
+                tmp.andNot(query);
+                if (tmp.isEmpty()) subsets.add(set);
+                tmp = (BitSet) query.clone();
+                tmp.andNot(set);
+                if (tmp.isEmpty()) supersets.add(set);
+            }
+            Set<BitSet> trieSubsets = new HashSet<>(), trieSupersets = new HashSet<>();
+            for (VertexSet S : T.getSubSets(Q)) trieSubsets.add(S.toBitSet());
+            for (VertexSet S : T.getSuperSets(Q)) trieSupersets.add(S.toBitSet());
+            assertEquals(subsets, trieSubsets);
+            assertEquals(supersets, trieSupersets);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * ipasir-replay: replays IPASIR call traces recorded by Jdrasil (see ipasir_trace.h) against the IPASIR
+ * solver it is linked with, and reports the time of every solve call.
+ *
+ * Usage: ipasir-replay [-q] <trace> [<trace> ...]
+ *   -q : only print the summary line of each trace
+ */
+
+/* default includes */
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+/* IPASIR includes */
+extern "C" {
+  #include "ipasir.h"
+  #include "ipasir_ext.h"
+}
+#include "ipasir_trace.h"
+
+/**
+ * Replay a single trace on a fresh solver.
+ * @return false if the trace could not be read or a solve call returned another result than recorded
+ */
+static bool replay(const char* path, bool quiet) {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    fprintf(stderr, "c could not open %s\n", path);
+    return false;
+  }
+  char magic[sizeof(IPASIR_TRACE_MAGIC)];
+  if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) || memcmp(magic, IPASIR_TRACE_MAGIC, sizeof(magic)) != 0) {
+    fprintf(stderr, "c %s is not an IPASIR trace\n", path);
+    fclose(file);
+    return false;
+  }
+  setvbuf(file, NULL, _IOFBF, 1 << 16);
+
+  void* solver = ipasir_init();
+  TraceOperation op;
+  int32_t argument;
+  int calls = 0, mismatches = 0;
+  long clauses = 0, assumptions = 0, queries = 0;
+  double total = 0;
+  while (traceRead(file, op, argument)) {
+    switch (op) {
+    case TRACE_ADD:
+      ipasir_add(solver, argument);
+      if (argument == 0) clauses++;
+      break;
+    case TRACE_ASSUME:
+      ipasir_assume(solver, argument);
+      assumptions++;
+      break;
+    case TRACE_SOLVE: {
+      auto start = std::chrono::steady_clock::now();
+      int result = ipasir_solve(solver);
+      double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      total += ms;
+      calls++;
+      // a recorded 0 means the solver was interrupted, any result is fine then
+      if (argument != 0 && result != argument) mismatches++;
+      if (!quiet) printf("solve %d result %d recorded %d time %.3f ms\n", calls, result, argument, ms);
+      break;
+    }
+    case TRACE_VAL:
+      ipasir_val(solver, argument);
+      queries++;
+      break;
+    case TRACE_FAILED:
+      ipasir_failed(solver, argument);
+      queries++;
+      break;
+    case TRACE_RESERVE:
+      if (ipasir_reserve != NULL) ipasir_reserve(solver, argument);
+      break;
+    default:
+      fprintf(stderr, "c unknown operation %d in %s\n", (int) op, path);
+      mismatches++;
+    }
+  }
+  ipasir_release(solver);
+  fclose(file);
+
+  printf("%s: %s, %ld clauses, %d solve calls, %ld assumptions, %ld queries, %.3f ms solving, %d mismatches\n",
+         path, ipasir_signature(), clauses, calls, assumptions, queries, total, mismatches);
+  return mismatches == 0;
+}
+
+int main(int argc, char** argv) {
+  bool quiet = false, ok = true;
+  int traces = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-q") == 0) {
+      quiet = true;
+    } else {
+      ok &= replay(argv[i], quiet);
+      traces++;
+    }
+  }
+  if (traces == 0) {
+    fprintf(stderr, "usage: %s [-q] <trace> [<trace> ...]\n", argv[0]);
+    return 1;
+  }
+  return ok ? 0 : 1;
+}
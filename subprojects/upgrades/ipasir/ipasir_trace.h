@@ -0,0 +1,67 @@
+/*
+ * Binary format of IPASIR call traces, shared by the recorder in the JNI interface and by ipasir-replay.
+ *
+ * A trace starts with the four bytes "IPT1" and is followed by a sequence of records. Each record is a
+ * single unsigned LEB128 varint: the lowest three bits hold the operation, the remaining bits hold its
+ * zigzag encoded argument. So a clause literal usually takes one or two bytes.
+ *
+ *   ADD     literal (0 terminates the clause)
+ *   ASSUME  literal
+ *   SOLVE   result returned by ipasir_solve (0, 10, or 20)
+ *   VAL     literal
+ *   FAILED  literal
+ *   RESERVE number of variables
+ */
+#ifndef IPASIR_TRACE_H
+#define IPASIR_TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* magic number and version at the start of every trace */
+static const char IPASIR_TRACE_MAGIC[4] = { 'I', 'P', 'T', '1' };
+
+/**
+ * The recorded operations.
+ */
+enum TraceOperation {
+  TRACE_ADD     = 0,
+  TRACE_ASSUME  = 1,
+  TRACE_SOLVE   = 2,
+  TRACE_VAL     = 3,
+  TRACE_FAILED  = 4,
+  TRACE_RESERVE = 5
+};
+
+/**
+ * Append a record to the trace.
+ */
+static inline void traceWrite(FILE* file, TraceOperation op, int32_t argument) {
+  uint64_t zigzag = ((uint64_t) (uint32_t) argument << 1) ^ (uint64_t) (int64_t) (argument >> 31);
+  uint64_t v = (zigzag << 3) | (uint64_t) op;
+  while (v >= 0x80) {
+    putc((int) (v & 0x7f) | 0x80, file);
+    v >>= 7;
+  }
+  putc((int) v, file);
+}
+
+/**
+ * Read the next record of the trace.
+ * @return false at the end of the trace (or if the trace is truncated)
+ */
+static inline bool traceRead(FILE* file, TraceOperation& op, int32_t& argument) {
+  uint64_t v = 0;
+  int shift = 0, c;
+  do {
+    if ((c = getc(file)) == EOF || shift > 63) return false;
+    v |= (uint64_t) (c & 0x7f) << shift;
+    shift += 7;
+  } while (c & 0x80);
+  op = (TraceOperation) (v & 7);
+  uint32_t zigzag = (uint32_t) (v >> 3);
+  argument = (int32_t) ((zigzag >> 1) ^ (0u - (zigzag & 1)));
+  return true;
+}
+
+#endif
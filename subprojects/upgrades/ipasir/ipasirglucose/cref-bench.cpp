@@ -0,0 +1,45 @@
+/*
+ * cref-bench: solves the same random 3-SAT instances (at the threshold ratio 4.26) with the IPASIR solver it is
+ * linked with, and reports the results, the total run time and the peak RSS. Used by "make bench-cref" to compare
+ * the default arena with the WIDE_CREF build.
+ *
+ * Usage: cref-bench [<variables> [<instances>]]   (default: 220 variables, 3 instances with seeds 1, 2, 3)
+ */
+
+/* default includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <sys/resource.h>
+
+/* IPASIR includes */
+extern "C" {
+  #include "ipasir.h"
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? atoi(argv[1]) : 220;
+  int instances = argc > 2 ? atoi(argv[2]) : 3;
+  int m = (int) (n * 4.26);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int seed = 1; seed <= instances; seed++) {
+    srand(seed);
+    void* solver = ipasir_init();
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < 3; j++) {
+        int v = rand() % n + 1;
+        ipasir_add(solver, rand() % 2 ? v : -v);
+      }
+      ipasir_add(solver, 0);
+    }
+    printf("c seed %d: %d\n", seed, ipasir_solve(solver));
+    ipasir_release(solver);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  printf("c %s: %.2f s, peak RSS %.1f MB\n", ipasir_signature(), seconds, usage.ru_maxrss / 1024.0);
+  return 0;
+}
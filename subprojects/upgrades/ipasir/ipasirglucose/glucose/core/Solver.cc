@@ -99,6 +99,10 @@ static DoubleOption opt_random_seed(_cat, "rnd-seed", "Used by the random variab
 static IntOption opt_ccmin_mode(_cat, "ccmin-mode", "Controls conflict clause minimization (0=none, 1=basic, 2=deep)", 2, IntRange(0, 2));
 static IntOption opt_phase_saving(_cat, "phase-saving", "Controls the level of phase saving (0=none, 1=limited, 2=full)", 2, IntRange(0, 2));
 static BoolOption opt_rnd_init_act(_cat, "rnd-init", "Randomize the initial activity", false);
+static BoolOption opt_ternary_watches(_cat, "ternary-watches", "Watch original ternary clauses with inline ternary watchers (fewer arena reads, more memory)", false);
+static BoolOption opt_reuse_trail(_cat, "reuse-trail", "Reuse the trail on restarts and keep matching assumptions between incremental calls", true);
+static IntOption opt_chrono(_cat, "chrono", "Backtrack chronologically if a backjump would skip more than this many levels (-1 = never)", -1, IntRange(-1, INT32_MAX));
+static IntOption opt_confl_to_chrono(_cat, "confl-to-chrono", "Number of conflicts before chronological backtracking is used", 4000, IntRange(0, INT32_MAX));
 static DoubleOption opt_garbage_frac(_cat, "gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered", 0.20, DoubleRange(0, false, HUGE_VAL, false));
 
 //=================================================================================================
@@ -139,6 +143,10 @@ verbosity(0)
 , panicModeLastRemoved(0), panicModeLastRemovedShared(0)
 , useUnaryWatched(false)
 , promoteOneWatchedClause(true)
+, useTernaryWatches(opt_ternary_watches)
+, reuseTrail(opt_reuse_trail)
+, chrono(opt_chrono)
+, confl_to_chrono(opt_confl_to_chrono)
 ,solves(0),starts(0),decisions(0),propagations(0),conflicts(0),conflictsRestarts(0)
 , curRestart(1)
 
@@ -147,6 +155,7 @@ verbosity(0)
 , var_inc(1)
 , watches(WatcherDeleted(ca))
 , watchesBin(WatcherDeleted(ca))
+, watchesTer(TernaryWatcherDeleted(ca))
 , unaryWatches(WatcherDeleted(ca))
 , qhead(0)
 , simpDB_assigns(-1)
@@ -170,6 +179,8 @@ verbosity(0)
 , nbUnsatCalls(0)
 {
     MYFLAG = 0;
+    termCallbackState = NULL;
+    termCallback = NULL;
     // Initialize only first time. Useful for incremental solving (not in // version), useless otherwise
     // Kept here for simplicity
     lbdQueue.initSize(sizeLBDQueue);
@@ -214,6 +225,10 @@ Solver::Solver(const Solver &s) :
 , panicModeLastRemoved(s.panicModeLastRemoved), panicModeLastRemovedShared(s.panicModeLastRemovedShared)
 , useUnaryWatched(s.useUnaryWatched)
 , promoteOneWatchedClause(s.promoteOneWatchedClause)
+, useTernaryWatches(s.useTernaryWatches)
+, reuseTrail(s.reuseTrail)
+, chrono(s.chrono)
+, confl_to_chrono(s.confl_to_chrono)
 // Statistics: (formerly in 'SolverStats')
 //
 ,solves(0),starts(0),decisions(0),propagations(0),conflicts(0),conflictsRestarts(0)
@@ -225,6 +240,7 @@ Solver::Solver(const Solver &s) :
 , var_inc(s.var_inc)
 , watches(WatcherDeleted(ca))
 , watchesBin(WatcherDeleted(ca))
+, watchesTer(TernaryWatcherDeleted(ca))
 , unaryWatches(WatcherDeleted(ca))
 , qhead(s.qhead)
 , simpDB_assigns(s.simpDB_assigns)
@@ -253,6 +269,8 @@ Solver::Solver(const Solver &s) :
 
     // Initialize  other variables
      MYFLAG = 0;
+    termCallbackState = s.termCallbackState;
+    termCallback = s.termCallback;
     // Initialize only first time. Useful for incremental solving (not in // version), useless otherwise
     // Kept here for simplicity
     sumLBD = s.sumLBD;
@@ -261,6 +279,7 @@ Solver::Solver(const Solver &s) :
     // Copy all search vectors
     s.watches.copyTo(watches);
     s.watchesBin.copyTo(watchesBin);
+    s.watchesTer.copyTo(watchesTer);
     s.unaryWatches.copyTo(unaryWatches);
     s.assigns.memCopyTo(assigns);
     s.vardata.memCopyTo(vardata);
@@ -319,6 +338,8 @@ Var Solver::newVar(bool sign, bool dvar) {
     watches .init(mkLit(v, true));
     watchesBin .init(mkLit(v, false));
     watchesBin .init(mkLit(v, true));
+    watchesTer .init(mkLit(v, false));
+    watchesTer .init(mkLit(v, true));
     unaryWatches .init(mkLit(v, false));
     unaryWatches .init(mkLit(v, true));
     assigns .push(l_Undef);
@@ -333,9 +354,102 @@ Var Solver::newVar(bool sign, bool dvar) {
     return v;
 }
 
+void Solver::reserveVars(int n) {
+    // Subsequent calls of newVar() for variables below 'n' will not reallocate.
+    watches     .reserve(2 * n);
+    watchesBin  .reserve(2 * n);
+    watchesTer  .reserve(2 * n);
+    unaryWatches.reserve(2 * n);
+    assigns     .capacity(n);
+    vardata     .capacity(n);
+    activity    .capacity(n);
+    seen        .capacity(n);
+    permDiff    .capacity(n);
+    polarity    .capacity(n);
+    decision    .capacity(n);
+    trail       .capacity(n);
+    order_heap  .reserve(n);
+}
+
+void Solver::reset() {
+    // Clause arena and watcher lists keep their memory, so a new formula can reuse it.
+    watches     .reset();
+    watchesBin  .reset();
+    watchesTer  .reset();
+    unaryWatches.reset();
+    clauses            .clear();
+    learnts            .clear();
+    permanentLearnts   .clear();
+    unaryWatchedClauses.clear();
+    ca.clear();
+
+    // Forget all variables:
+    order_heap.clear();
+    assigns   .clear();
+    vardata   .clear();
+    activity  .clear();
+    seen      .clear();
+    permDiff  .clear();
+    polarity  .clear();
+    decision  .clear();
+    nbpos     .clear();
+    trail     .clear();
+    trail_lim .clear();
+    model     .clear();
+    conflict  .clear();
+    assumptions.clear();
+    trailAssumptions.clear();
+    lastDecisionLevel.clear();
+    analyze_stack  .clear();
+    analyze_toclear.clear();
+    add_tmp        .clear();
+    assumptionPositions.clear();
+    initialPositions   .clear();
+
+    // Restore the search state of a freshly constructed solver. Parameters (including the incremental mode) are
+    // kept, everything the search changes is set to the values of the constructor:
+    ok = true;
+    cla_inc = 1;
+    var_inc = 1;
+    var_decay = opt_var_decay;
+    random_seed = opt_random_seed;
+    qhead = 0;
+    simpDB_assigns = -1;
+    simpDB_props = 0;
+    progress_estimate = 0;
+    remove_satisfied = true;
+    lastLearntClause = CRef_Undef;
+    max_learnts = 0;
+    learntsize_adjust_confl = 0;
+    learntsize_adjust_cnt = 0;
+    conflict_budget = -1;
+    propagation_budget = -1;
+    asynch_interrupt = false;
+    panicModeLastRemoved = panicModeLastRemovedShared = 0;
+    MYFLAG = 0;
+    lbdQueue.clear();
+    lbdQueue.initSize(sizeLBDQueue);
+    trailQueue.clear();
+    trailQueue.initSize(sizeTrailQueue);
+    sumLBD = 0;
+    sumAssumptions = 0;
+    nbclausesbeforereduce = firstReduceDB;
+    curRestart = 1;
+
+    // Statistics:
+    solves = starts = decisions = propagations = conflicts = conflictsRestarts = 0;
+    for (int i = 0; i < stats.size(); i++) stats[i] = 0;
+    nbVarsInitialFormula = INT32_MAX;
+    totalTime4Sat = totalTime4Unsat = 0;
+    nbSatCalls = nbUnsatCalls = 0;
+}
+
 bool Solver::addClause_(vec<Lit>& ps) {
 
-    assert(decisionLevel() == 0);
+    // Clauses are added at the root level. With 'reuseTrail', the last call of solve leaves its assumption
+    // levels on the trail (for the next call), these are dropped here.
+    assert(decisionLevel() == 0 || (reuseTrail && decisionLevel() <= trailAssumptions.size()));
+    cancelUntil(0);
     if (!ok) return false;
 
     // Check if clause is satisfied and remove false/duplicate literals:
@@ -388,12 +502,18 @@ bool Solver::addClause_(vec<Lit>& ps) {
 }
 
 void Solver::attachClause(CRef cr) {
-    const Clause& c = ca[cr];
+    Clause& c = ca[cr];
 
     assert(c.size() > 1);
+    c.setTernary(false);
     if (c.size() == 2) {
         watchesBin[~c[0]].push(Watcher(cr, c[1]));
         watchesBin[~c[1]].push(Watcher(cr, c[0]));
+    } else if (c.size() == 3 && !c.learnt() && useTernaryWatches) {
+        c.setTernary(true);
+        watchesTer[~c[0]].push(TernaryWatcher(cr, c[1], c[2]));
+        watchesTer[~c[1]].push(TernaryWatcher(cr, c[0], c[2]));
+        watchesTer[~c[2]].push(TernaryWatcher(cr, c[0], c[1]));
     } else {
         watches[~c[0]].push(Watcher(cr, c[1]));
         watches[~c[1]].push(Watcher(cr, c[0]));
@@ -423,6 +543,16 @@ void Solver::detachClause(CRef cr, bool strict) {
             watchesBin.smudge(~c[0]);
             watchesBin.smudge(~c[1]);
         }
+    } else if (c.getTernary()) {
+        if (strict) {
+            remove(watchesTer[~c[0]], TernaryWatcher(cr, c[1], c[2]));
+            remove(watchesTer[~c[1]], TernaryWatcher(cr, c[0], c[2]));
+            remove(watchesTer[~c[2]], TernaryWatcher(cr, c[0], c[1]));
+        } else {
+            watchesTer.smudge(~c[0]);
+            watchesTer.smudge(~c[1]);
+            watchesTer.smudge(~c[2]);
+        }
     } else {
         if (strict) {
             remove(watches[~c[0]], Watcher(cr, c[1]));
@@ -599,10 +729,17 @@ void Solver::minimisationWithBinaryResolution(vec<Lit> &out_learnt) {
 // Revert to the state at given level (keeping all assignment at 'level' but not beyond).
 //
 
+// With chronological backtracking, the trail may contain assignments of lower levels above 'trail_lim[level]'.
+// These are kept (in their order) and propagated again.
+
 void Solver::cancelUntil(int level) {
     if (decisionLevel() > level) {
         for (int c = trail.size() - 1; c >= trail_lim[level]; c--) {
             Var x = var(trail[c]);
+            if (chrono >= 0 && vardata[x].level <= level) {
+                kept_tmp.push(trail[c]);
+                continue;
+            }
             assigns [x] = l_Undef;
             if (phase_saving > 1 || ((phase_saving == 1) && c > trail_lim.last())) {
                 polarity[x] = sign(trail[c]);
@@ -612,7 +749,80 @@ void Solver::cancelUntil(int level) {
         qhead = trail_lim[level];
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
+        if (trailAssumptions.size() > level) trailAssumptions.shrink(trailAssumptions.size() - level);
+        for (int c = kept_tmp.size() - 1; c >= 0; c--)
+            trail.push_(kept_tmp[c]);
+        kept_tmp.clear();
+    }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  reuseTrailLevel : (int level)  ->  [int]
+|
+|  Description:
+|    Partial restarts (van der Tak, Ramos, Heule, 2011): a restart to 'level' would make the same
+|    decisions again as long as they are more active than the best unassigned variable, so it
+|    suffices to backtrack to the first decision that is less active than that variable.
+|________________________________________________________________________________________________@*/
+int Solver::reuseTrailLevel(int level) {
+    if (!reuseTrail) return level;
+
+    Var next = var_Undef;
+    while (!order_heap.empty()) {
+        next = order_heap[0];
+        if (value(next) == l_Undef && decision[next]) break;
+        order_heap.removeMin();
+        next = var_Undef;
     }
+    if (next == var_Undef) return level;
+
+    while (level < decisionLevel() && activity[var(trail[trail_lim[level]])] > activity[next])
+        level++;
+    return level;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  findConflictLevel : (confl : CRef) (single : bool&)  ->  [int]
+|
+|  Description:
+|    Chronological backtracking (Nadel, Ryvchin, 2018) keeps assignments of lower levels on the
+|    trail, so a conflicting clause may be falsified below the current decision level. Moves a
+|    literal of the highest level of the clause to position 0 and returns that level. 'single' is
+|    set if it is the only literal of that level, i.e., the clause is unit one level below.
+|________________________________________________________________________________________________@*/
+int Solver::findConflictLevel(CRef confl, bool& single) {
+    Clause& c = ca[confl];
+    int top = 0;
+    for (int k = 1; k < c.size(); k++)
+        if (level(var(c[k])) > level(var(c[top])))
+            top = k;
+    swapWatch(confl, 0, top);
+
+    int conflLevel = level(var(c[0]));
+    single = true;
+    for (int k = 1; k < c.size() && single; k++)
+        if (level(var(c[k])) == conflLevel)
+            single = false;
+    return conflLevel;
+}
+
+
+// Swap the literals at the watched position 'w' (0 or 1) and at position 'k' of the clause. Only long
+// clauses are watched by their first two literals, binary and ternary ones are watched in all literals.
+
+void Solver::swapWatch(CRef cr, int w, int k) {
+    Clause& c = ca[cr];
+    if (k == w) return;
+    if (k > 1 && c.size() > 2 && !c.getTernary()) {
+        remove(watches[~c[w]], Watcher(cr, c[1 - w]));
+        watches[~c[k]].push(Watcher(cr, c[1 - w]));
+    }
+    Lit tmp = c[w];
+    c[w] = c[k], c[k] = tmp;
 }
 
 
@@ -735,9 +945,12 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
             } //else stats[sumResSeen]++;
         }
 
-        // Select next clause to look at:
-        while (!seen[var(trail[index--])]);
-        p = trail[index + 1];
+        // Select next clause to look at (with chronological backtracking, seen literals of lower levels
+        // can be above the current level on the trail):
+        do {
+            while (!seen[var(trail[index--])]);
+            p = trail[index + 1];
+        } while (level(var(p)) < decisionLevel());
         //stats[sumRes]++;
         confl = reason(var(p));
         seen[var(p)] = 0;
@@ -928,6 +1141,13 @@ void Solver::uncheckedEnqueue(Lit p, CRef from) {
     trail.push_(p);
 }
 
+void Solver::uncheckedEnqueue(Lit p, int level, CRef from) {
+    assert(value(p) == l_Undef && level <= decisionLevel());
+    assigns[var(p)] = lbool(!sign(p));
+    vardata[var(p)] = mkVarData(from, level);
+    trail.push_(p);
+}
+
 /*_________________________________________________________________________________________________
 |
 |  propagate : [void]  ->  [Clause*]
@@ -944,9 +1164,11 @@ CRef Solver::propagate() {
     int num_props = 0;
     watches.cleanAll();
     watchesBin.cleanAll();
+    watchesTer.cleanAll();
     unaryWatches.cleanAll();
     while (qhead < trail.size()) {
         Lit p = trail[qhead++]; // 'p' is enqueued fact to propagate.
+        int currLevel = level(var(p)); // below the decision level only with chronological backtracking
         vec<Watcher>& ws = watches[p];
         Watcher *i, *j, *end;
         num_props++;
@@ -963,10 +1185,32 @@ CRef Solver::propagate() {
             }
 
             if (value(imp) == l_Undef) {
-                uncheckedEnqueue(imp, wbin[k].cref);
+                uncheckedEnqueue(imp, currLevel, wbin[k].cref);
             }
         }
 
+        // Then, propagate ternary clauses using the inline literals of the watchers
+        vec<TernaryWatcher>& wter = watchesTer[p];
+        for (int k = 0; k < wter.size(); k++) {
+            lbool v1 = value(wter[k].other1);
+            lbool v2 = value(wter[k].other2);
+            if (v1 == l_True || v2 == l_True || (v1 == l_Undef && v2 == l_Undef))
+                continue;
+
+            if (v1 == l_False && v2 == l_False) {
+                return wter[k].cref;
+            }
+
+            // The clause is unit, reasons have to store the implied literal at position 0:
+            Lit imp = (v1 == l_Undef) ? wter[k].other1 : wter[k].other2;
+            int impLevel = level(var(v1 == l_Undef ? wter[k].other2 : wter[k].other1));
+            if (impLevel < currLevel) impLevel = currLevel;
+            Clause& c = ca[wter[k].cref];
+            if (c[1] == imp) c[1] = c[0], c[0] = imp;
+            else if (c[2] == imp) c[2] = c[0], c[0] = imp;
+            uncheckedEnqueue(imp, impLevel, wter[k].cref);
+        }
+
         // Now propagate other 2-watched clauses
         for (i = j = (Watcher*) ws, end = i + ws.size(); i != end;) {
             // Try to avoid inspecting the clause:
@@ -1034,10 +1278,21 @@ CRef Solver::propagate() {
                 // Copy the remaining watches:
                 while (i < end)
                     *j++ = *i++;
-            } else {
+            } else if (currLevel == decisionLevel()) {
                 uncheckedEnqueue(first, cr);
-
-
+            } else {
+                // The implication belongs to the highest level of the false literals, which is watched
+                // instead of 'false_lit', so that the clause is revisited if that level is undone.
+                int maxLevel = currLevel, max_k = 1;
+                for (int k = 2; k < c.size(); k++)
+                    if (level(var(c[k])) > maxLevel)
+                        maxLevel = level(var(c[k])), max_k = k;
+                if (max_k != 1) {
+                    c[1] = c[max_k], c[max_k] = false_lit;
+                    j--;
+                    watches[~c[1]].push(w);
+                }
+                uncheckedEnqueue(first, maxLevel, cr);
             }
 NextClause:
 	    ;
@@ -1305,6 +1560,25 @@ lbool Solver::search(int nof_conflicts) {
                         (int) stats[dec_vars] - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]), nClauses(), (int) stats[clauses_literals],
                         (int) stats[nbReduceDB], nLearnts(), (int) stats[nbDL2], (int) stats[nbRemovedClauses], progressEstimate()*100);
             }
+            if (chrono >= 0 && !useUnaryWatched) {
+                bool single;
+                int conflLevel = findConflictLevel(confl, single);
+                if (conflLevel == 0)
+                    return l_False;
+                if (single) {
+                    // The clause is unit one level below: undo that level and propagate the clause
+                    Clause& c = ca[confl];
+                    int second = 1;
+                    for (int k = 2; k < c.size(); k++)
+                        if (level(var(c[k])) > level(var(c[second])))
+                            second = k;
+                    swapWatch(confl, 1, second);
+                    cancelUntil(conflLevel - 1);
+                    uncheckedEnqueue(c[0], level(var(c[1])), confl);
+                    continue;
+                }
+                cancelUntil(conflLevel);
+            }
             if (decisionLevel() == 0) {
                 return l_False;
 
@@ -1329,7 +1603,14 @@ lbool Solver::search(int nof_conflicts) {
             lbdQueue.push(nblevels);
             sumLBD += nblevels;
 
-            cancelUntil(backtrack_level);
+            // Chronological backtracking: if the backjump would skip many levels, only undo the conflict
+            // level, the skipped levels would likely be rebuilt anyway.
+            if (learnt_clause.size() > 1 && chrono >= 0 && !useUnaryWatched && conflicts > (uint64_t) confl_to_chrono
+                    && decisionLevel() - backtrack_level > chrono) {
+                stats[nbChronoBacktracks]++;
+                cancelUntil(decisionLevel() - 1);
+            } else
+                cancelUntil(backtrack_level);
 
             if (certifiedUNSAT) {
                 for (int i = 0; i < learnt_clause.size(); i++)
@@ -1362,7 +1643,7 @@ lbool Solver::search(int nof_conflicts) {
                 attachClause(cr);
                 lastLearntClause = cr; // Use in multithread (to hard to put inside ParallelSolver)
                 parallelExportClauseDuringSearch(ca[cr]);
-                uncheckedEnqueue(learnt_clause[0], cr);
+                uncheckedEnqueue(learnt_clause[0], backtrack_level, cr);
 
             }
             varDecayActivity();
@@ -1373,13 +1654,13 @@ lbool Solver::search(int nof_conflicts) {
             // Our dynamic restart, see the SAT09 competition compagnion paper 
 
           if (
-                    (lbdQueue.isvalid() && ((lbdQueue.getavg() * K) > (sumLBD / conflictsRestarts)))) {
+                    (lbdQueue.isvalid() && ((lbdQueue.getavg() * K) > (sumLBD / conflictsRestarts))) || !withinBudget()) {
                 lbdQueue.fastclear();
                 progress_estimate = progressEstimate();
                 int bt = 0;
-                if(incremental) // DO NOT BACKTRACK UNTIL 0.. USELESS
+                if(incremental || reuseTrail) // DO NOT BACKTRACK UNTIL 0.. USELESS
                     bt = (decisionLevel()<assumptions.size()) ? decisionLevel() : assumptions.size();
-                cancelUntil(bt);
+                cancelUntil(withinBudget() ? reuseTrailLevel(bt) : bt);
                 return l_Undef;
             }
 
@@ -1406,6 +1687,7 @@ lbool Solver::search(int nof_conflicts) {
                 if (value(p) == l_True) {
                     // Dummy decision level:
                     newDecisionLevel();
+                    trailAssumptions.push(p);
                 } else if (value(p) == l_False) {
                     analyzeFinal(~p, conflict);
                     return l_False;
@@ -1427,6 +1709,7 @@ lbool Solver::search(int nof_conflicts) {
 
             // Increase decision level and enqueue 'next'
             newDecisionLevel();
+            if (decisionLevel() <= assumptions.size()) trailAssumptions.push(next);
             uncheckedEnqueue(next);
         }
     }
@@ -1482,6 +1765,13 @@ lbool Solver::solve_(bool do_simp, bool turn_off_simp) // Parameters are useless
     if (!ok) return l_False;
     double curTime = cpuTime();
 
+    // Keep the levels of the assumptions this call shares with the previous one
+    int reuse = 0;
+    if (reuseTrail)
+        while (reuse < trailAssumptions.size() && reuse < assumptions.size() && trailAssumptions[reuse] == assumptions[reuse])
+            reuse++;
+    cancelUntil(reuse);
+
     solves++;
             
     
@@ -1541,7 +1831,7 @@ if(chanseokStrategy) {
 
 
 
-    cancelUntil(0);
+    cancelUntil(reuseTrail && ok ? trailAssumptions.size() : 0);
 
 
     double finalTime = cpuTime();
@@ -1645,6 +1935,7 @@ void Solver::relocAll(ClauseAllocator& to) {
     // for (int i = 0; i < watches.size(); i++)
     watches.cleanAll();
     watchesBin.cleanAll();
+    watchesTer.cleanAll();
     unaryWatches.cleanAll();
     for (int v = 0; v < nVars(); v++)
         for (int s = 0; s < 2; s++) {
@@ -1659,6 +1950,9 @@ void Solver::relocAll(ClauseAllocator& to) {
             vec<Watcher>& ws3 = unaryWatches[p];
             for (int j = 0; j < ws3.size(); j++)
                 ca.reloc(ws3[j].cref, to);
+            vec<TernaryWatcher>& ws4 = watchesTer[p];
+            for (int j = 0; j < ws4.size(); j++)
+                ca.reloc(ws4[j].cref, to);
         }
 
     // All reasons:
@@ -1696,8 +1990,8 @@ void Solver::garbageCollect() {
 
     relocAll(to);
     if (verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n",
-            ca.size() * ClauseAllocator::Unit_Size, to.size() * ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+            (uint64_t)ca.size() * ClauseAllocator::Unit_Size, (uint64_t)to.size() * ClauseAllocator::Unit_Size);
     to.moveTo(ca);
 }
 
@@ -86,10 +86,11 @@ enum CoreStats {
   clauses_literals,
   learnts_literals,
   max_literals,
-  tot_literals
+  tot_literals,
+  nbChronoBacktracks
 } ;
 
-#define coreStatsSize 23
+#define coreStatsSize 24
 //=================================================================================================
 // Solver -- the main class:
 
@@ -125,6 +126,8 @@ public:
     // Problem specification:
     //
     virtual Var     newVar    (bool polarity = true, bool dvar = true); // Add a new variable with parameters specifying variable mode.
+    void    reserveVars(int n);                                 // Preallocate all per-variable data structures for 'n' variables.
+    void    reset     ();                                       // Remove all variables and clauses, but keep the allocated memory.
     bool    addClause (const vec<Lit>& ps);                     // Add a clause to the solver. 
     bool    addEmptyClause();                                   // Add the empty clause, making the solver contradictory.
     bool    addClause (Lit p);                                  // Add a unit clause to the solver. 
@@ -251,6 +254,10 @@ public:
     
     bool useUnaryWatched;            // Enable unary watched literals
     bool promoteOneWatchedClause;    // One watched clauses are promotted to two watched clauses if found empty
+    bool useTernaryWatches;          // Watch original ternary clauses with inline ternary watchers (off by default, costs memory)
+    bool reuseTrail;                 // Keep the part of the trail a restart or the next incremental call would rebuild
+    int  chrono;                     // Backtrack chronologically if a backjump would skip more than this many levels (-1 = never)
+    int  confl_to_chrono;            // ... but only after this many conflicts
     
     // Functions useful for multithread solving
     // Useless in the sequential case 
@@ -300,6 +307,24 @@ protected:
         bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
     };
 
+    // Ternary clauses are watched in all three literals, and the watcher holds the two other literals inline,
+    // so propagation only has to look into the clause if it becomes unit or conflicting. The clause itself stays
+    // in the arena (reasons and conflicts are CRefs), hence the watchers cost memory on top of it, they do not save any.
+    struct TernaryWatcher {
+        CRef cref;
+        Lit  other1, other2;
+        TernaryWatcher(CRef cr, Lit p, Lit q) : cref(cr), other1(p), other2(q) {}
+        bool operator==(const TernaryWatcher& w) const { return cref == w.cref; }
+        bool operator!=(const TernaryWatcher& w) const { return cref != w.cref; }
+    };
+
+    struct TernaryWatcherDeleted
+    {
+        const ClauseAllocator& ca;
+        TernaryWatcherDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
+        bool operator()(const TernaryWatcher& w) const { return ca[w.cref].mark() == 1; }
+    };
+
     struct VarOrderLt {
         const vec<double>&  activity;
         bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
@@ -318,6 +343,8 @@ protected:
                         watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
     OccLists<Lit, vec<Watcher>, WatcherDeleted>
                         watchesBin;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<TernaryWatcher>, TernaryWatcherDeleted>
+                        watchesTer;       // 'watchesTer[lit]' lists the original ternary clauses containing '~lit'.
     OccLists<Lit, vec<Watcher>, WatcherDeleted>
                         unaryWatches;       //  Unary watch scheme (clauses are seen when they become empty
     vec<CRef>           clauses;          // List of problem clauses.
@@ -336,6 +363,7 @@ protected:
     int                 simpDB_assigns;   // Number of top-level assignments since last execution of 'simplify()'.
     int64_t             simpDB_props;     // Remaining number of propagations that must be made before next execution of 'simplify()'.
     vec<Lit>            assumptions;      // Current set of assumptions provided to solve by the user.
+    vec<Lit>            trailAssumptions; // Assumptions of the last call whose decision levels are still on the trail.
     Heap<VarOrderLt>    order_heap;       // A priority queue of variables ordered with respect to the variable activity.
     double              progress_estimate;// Set by 'search()'.
     bool                remove_satisfied; // Indicates whether possibly inefficient linear scan for satisfied clauses should be performed in 'simplify'.
@@ -365,6 +393,7 @@ protected:
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    vec<Lit>            kept_tmp;         // Assignments of lower levels that 'cancelUntil' keeps (chronological backtracking).
     unsigned int  MYFLAG;
 
     // Initial reduceDB strategy
@@ -392,10 +421,14 @@ protected:
     Lit      pickBranchLit    ();                                                      // Return the next decision variable.
     void     newDecisionLevel ();                                                      // Begins a new decision level.
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
+    void     uncheckedEnqueue (Lit p, int level, CRef from);                           // Enqueue a literal at the given (possibly lower) level.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
     CRef     propagateUnaryWatches(Lit p);                                                  // Perform propagation on unary watches of p, can find only conflicts
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
+    int      reuseTrailLevel  (int level);                                             // Level a restart to 'level' can stop at while reusing the trail.
+    int      findConflictLevel(CRef confl, bool& single);                              // Highest level of a conflicting clause (chronological backtracking).
+    void     swapWatch        (CRef cr, int w, int k);                                 // Swap the watched literal 'c[w]' with 'c[k]', moving the watch along.
     void     analyze          (CRef confl, vec<Lit>& out_learnt, vec<Lit> & selectors, int& out_btlevel,unsigned int &nblevels,unsigned int &szWithoutSelectors);    // (bt = backtrack)
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()')
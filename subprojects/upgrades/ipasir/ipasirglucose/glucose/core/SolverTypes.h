@@ -153,7 +153,7 @@ class Clause;
 typedef RegionAllocator<uint32_t>::Ref CRef;
 
 #define BITS_LBD 13
-#define BITS_SIZEWITHOUTSEL 19
+#define BITS_SIZEWITHOUTSEL 18
 #define BITS_REALSIZE 21
 class Clause {
     struct {
@@ -168,9 +168,14 @@ class Clause {
       unsigned oneWatched : 1;
       unsigned lbd : BITS_LBD;
       unsigned szWithoutSelectors : BITS_SIZEWITHOUTSEL;
+      unsigned ternary : 1; // watched by inline ternary watchers
     }  header;
 
+#ifdef GLUCOSE_WIDE_CREF
+    union { Lit lit; float act; uint32_t abs; } data[0]; // relocation is split over data[0] and data[1]
+#else
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
+#endif
 
     friend class ClauseAllocator;
 
@@ -188,6 +193,7 @@ class Clause {
 	header.exported = 0; 
 	header.oneWatched = 0;
 	header.seen = 0;
+	header.ternary = 0;
         for (int i = 0; i < ps.size(); i++) 
             data[i].lit = ps[i];
 	
@@ -228,8 +234,13 @@ public:
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
     bool         reloced     ()      const   { return header.reloced; }
+#ifdef GLUCOSE_WIDE_CREF
+    CRef         relocation  ()      const   { return (CRef)data[0].abs | ((CRef)data[1].abs << 32); }
+    void         relocate    (CRef c)        { header.reloced = 1; data[0].abs = (uint32_t)c; data[1].abs = (uint32_t)(c >> 32); }
+#else
     CRef         relocation  ()      const   { return data[0].rel; }
     void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = c; }
+#endif
 
     // NOTE: somewhat unsafe to change the clause in-place! Must manually call 'calcAbstraction' afterwards for
     //       subsumption operations to behave correctly.
@@ -258,6 +269,8 @@ public:
     unsigned int getExported() {return header.exported;}
     void setOneWatched(bool b) {header.oneWatched = b;}
     bool getOneWatched() {return header.oneWatched;}
+    void setTernary(bool b) {header.ternary = b;}
+    bool getTernary() const {return header.ternary;}
     void setSizeWithoutSelectors   (unsigned int n)              {header.szWithoutSelectors = n; }
     unsigned int        sizeWithoutSelectors   () const        { return header.szWithoutSelectors; }
 
@@ -272,11 +285,14 @@ const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
 class ClauseAllocator : public RegionAllocator<uint32_t>
 {
     static int clauseWord32Size(int size, int extra_size){
+#ifdef GLUCOSE_WIDE_CREF
+        if (size + extra_size < 2) extra_size = 2 - size; // room for a 64-bit relocation
+#endif
         return (sizeof(Clause) + (sizeof(Lit) * (size + extra_size))) / sizeof(uint32_t); }
  public:
     bool extra_clause_field;
 
-    ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false){}
+    ClauseAllocator(Size start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false){}
     ClauseAllocator() : extra_clause_field(false){}
 
     void moveTo(ClauseAllocator& to){
@@ -317,11 +333,11 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
         if (c.reloced()) { cr = c.relocation(); return; }
         
         cr = to.alloc(c, c.learnt(), c.wasImported());
-        c.relocate(cr);
         
         // Copy extra data-fields: 
         // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
         to[cr].mark(c.mark());
+        to[cr].setTernary(c.getTernary());
         if (to[cr].learnt())        {
 	  to[cr].activity() = c.activity();
 	  to[cr].setLBD(c.lbd());
@@ -337,6 +353,9 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
             to[cr].setSeen(c.getSeen());
             if (to[cr].has_extra()) to[cr].calcAbstraction();
         }
+
+        // Mark as relocated last, the relocation may overwrite fields of small clauses that are copied above:
+        c.relocate(cr);
     }
 };
 
@@ -356,6 +375,7 @@ class OccLists
     OccLists(const Deleted& d) : deleted(d) {}
     
     void  init      (const Idx& idx){ occs.growTo(toInt(idx)+1); dirty.growTo(toInt(idx)+1, 0); }
+    void  reserve   (int n)         { occs.capacity(n); dirty.capacity(n); }
     // Vec&  operator[](const Idx& idx){ return occs[toInt(idx)]; }
     Vec&  operator[](const Idx& idx){ return occs[toInt(idx)]; }
     Vec&  lookup    (const Idx& idx){ if (dirty[toInt(idx)]) clean(idx); return occs[toInt(idx)]; }
@@ -378,6 +398,11 @@ class OccLists
         }
     }
 
+    void  reset() { // Empty all lists, but keep the memory of the lists.
+        for (int i = 0; i < occs.size(); i++) occs[i].clear(), dirty[i] = 0;
+        dirties.clear();
+    }
+
     void  clear(bool free = true){
         occs   .clear(free);
         dirty  .clear(free);
@@ -418,7 +443,7 @@ template<class T>
 class CMap
 {
     struct CRefHash {
-        uint32_t operator()(CRef cr) const { return (uint32_t)cr; } };
+        uint32_t operator()(CRef cr) const { return (uint32_t)cr ^ (uint32_t)((uint64_t)cr >> 32); } };
 
     typedef Map<CRef, T, CRefHash> HashTable;
     HashTable map;
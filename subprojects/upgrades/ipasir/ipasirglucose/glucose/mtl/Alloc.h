@@ -28,24 +28,36 @@ namespace Glucose {
 
 //=================================================================================================
 // Simple Region-based memory allocator:
+//
+// By default regions are addressed with 32-bit references, which limits the arena to 2^32 units.
+// Compiling with GLUCOSE_WIDE_CREF switches to 64-bit references, at the price of larger
+// references in watchers, reasons, and clause lists.
 
 template<class T>
 class RegionAllocator
 {
-    T*        memory;
-    uint32_t  sz;
-    uint32_t  cap;
-    uint32_t  wasted_;
-
-    void capacity(uint32_t min_cap);
-
  public:
+#ifdef GLUCOSE_WIDE_CREF
+    typedef uint64_t Size;
+#else
+    typedef uint32_t Size;
+#endif
+
     // TODO: make this a class for better type-checking?
-    typedef uint32_t Ref;
-    enum { Ref_Undef = UINT32_MAX };
+    typedef Size Ref;
+    static const Ref Ref_Undef = ~(Ref)0;
     enum { Unit_Size = sizeof(uint32_t) };
 
-    explicit RegionAllocator(uint32_t start_cap = 1024*1024) : memory(NULL), sz(0), cap(0), wasted_(0){ capacity(start_cap); }
+ private:
+    T*    memory;
+    Size  sz;
+    Size  cap;
+    Size  wasted_;
+
+    void capacity(Size min_cap);
+
+ public:
+    explicit RegionAllocator(Size start_cap = 1024*1024) : memory(NULL), sz(0), cap(0), wasted_(0){ capacity(start_cap); }
     ~RegionAllocator()
     {
         if (memory != NULL)
@@ -53,12 +65,13 @@ class RegionAllocator
     }
 
 
-    uint32_t size      () const      { return sz; }
-    uint32_t getCap    () const      { return cap;}
-    uint32_t wasted    () const      { return wasted_; }
+    Size     size      () const      { return sz; }
+    Size     getCap    () const      { return cap;}
+    Size     wasted    () const      { return wasted_; }
 
     Ref      alloc     (int size); 
     void     free      (int size)    { wasted_ += size; }
+    void     clear     ()            { sz = 0; wasted_ = 0; } // Drop all regions, but keep the memory.
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     T&       operator[](Ref r)       { assert(r >= 0 && r < sz); return memory[r]; }
@@ -94,17 +107,24 @@ class RegionAllocator
 };
 
 template<class T>
-void RegionAllocator<T>::capacity(uint32_t min_cap)
+const typename RegionAllocator<T>::Ref RegionAllocator<T>::Ref_Undef;
+
+template<class T>
+void RegionAllocator<T>::capacity(Size min_cap)
 {
     if (cap >= min_cap) return;
 
-    uint32_t prev_cap = cap;
+    Size prev_cap = cap;
     while (cap < min_cap){
         // NOTE: Multiply by a factor (13/8) without causing overflow, then add 2 and make the
         // result even by clearing the least significant bit. The resulting sequence of capacities
         // is carefully chosen to hit a maximum capacity that is close to the '2^32-1' limit when
         // using 'uint32_t' as indices so that as much as possible of this space can be used.
-        uint32_t delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
+        // With 64-bit references the growth factor drops to 5/4 once the region exceeds 2^32
+        // units, so that the overshoot stays moderate at that size. Regions that large are
+        // mmap()-backed, where realloc() remaps pages instead of copying them.
+        Size delta = cap > (Size)UINT32_MAX ? (cap >> 2) & ~(Size)1
+                                            : ((cap >> 1) + (cap >> 3) + 2) & ~(Size)1;
         cap += delta;
 
         if (cap <= prev_cap)
@@ -125,7 +145,7 @@ RegionAllocator<T>::alloc(int size)
     assert(size > 0);
     capacity(sz + size);
 
-    uint32_t prev_sz = sz;
+    Size prev_sz = sz;
     sz += size;
     
     // Handle overflow:
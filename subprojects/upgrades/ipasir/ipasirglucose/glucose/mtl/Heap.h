@@ -87,6 +87,9 @@ class Heap {
 
     void copyTo(Heap& copy) const {heap.copyTo(copy.heap);indices.copyTo(copy.indices);}
 
+    // Make room for 'n' elements without growing the underlying vectors on insert:
+    void reserve(int n) { heap.capacity(n); indices.capacity(n); }
+
     // Safe variant of insert/decrease/increase:
     void update(int n)
     {
@@ -114,11 +114,18 @@ public:
 };
 
 
+// Element storage is moved with realloc (see NOTE above). A vec of vecs (as in OccLists) is fine with that, as a vec
+// only owns a pointer to its data, the compiler just can not know that.
+template<class T>
+static inline void* vecRealloc(T* data, size_t bytes)      { return ::realloc(data, bytes); }
+template<class T>
+static inline void* vecRealloc(vec<T>* data, size_t bytes) { return ::realloc((void*)data, bytes); }
+
 template<class T>
 void vec<T>::capacity(int min_cap) {
     if (cap >= min_cap) return;
     int add = imax((min_cap - cap + 1) & ~1, ((cap >> 1) + 2) & ~1);   // NOTE: grow by approximately 3/2
-    if (add > INT_MAX - cap || ((data = (T*)::realloc(data, (cap += add) * sizeof(T))) == NULL) && errno == ENOMEM)
+    if (add > INT_MAX - cap || ((data = (T*)vecRealloc(data, (cap += add) * sizeof(T))) == NULL) && errno == ENOMEM)
         throw OutOfMemoryException();
  }
 
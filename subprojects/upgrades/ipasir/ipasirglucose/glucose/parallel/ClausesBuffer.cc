@@ -50,21 +50,22 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 /* ClausesBuffer
  *
  * This class is responsible for exchanging clauses between threads.
- * It is based on a fixed-length FIFO array of literals.
- * If the FIFO is full, then old clauses are removed (even if it was not yet sent to all threads)
+ * Every thread owns a fixed-length FIFO array of literals that only it writes to, and that all
+ * other threads read from. Each reader keeps its own cursor into the FIFO of every other thread.
+ * If a FIFO is full, then old clauses are removed (even if they were not yet read by all threads)
+ * when opt_whenFullRemoveOlder is set, otherwise the new clause is dropped.
  *
- * a clause " l1 l2 l3" is pushed in the FIFO with the following 6 unsigned integers
- * 3 nseen origin l1 l2 l3
+ * a clause " l1 l2 l3" is pushed in the FIFO of its thread with the following 4 unsigned integers
+ * 3 l1 l2 l3
  * + 3 is the size of the pushed clause
- * + nseen is the number of thread which imported this clause (initialized with nthreads-1)
- *       (when set to 0, the clause is removed from the fifo)
- * + origin is the thread id of the thread which added this clause to the fifo
  * + l1 l2 l3 are the literals of the clause
  *
- * **********************************************************************************************
- * **CAREFUL** This class is not thread-safe. In glucose-syrup, the SharedCompanion is 
- * responsible for ensuring atomicity of main functions
- * **********************************************************************************************
+ * Positions are counted from the start and never wrap, the FIFO index is position % ringsize.
+ * The writer publishes the clause by moving head, and moves tail before it overwrites old clauses.
+ * A reader that was overtaken restarts at tail; a reader that raced with the writer notices it by
+ * checking tail again after it copied the clause (as in a sequence lock).
+ *
+ * This class is thread-safe without locks, as long as every thread only pushes its own clauses.
  *
  * */
 
@@ -77,159 +78,125 @@ using namespace Glucose;
 extern BoolOption opt_whenFullRemoveOlder;
 extern IntOption  opt_fifoSizeByCore;
 
-// index : size clause
-// index + 1 : nbSeen
-// index + 2 : threadId
-// index + 3 : .. index + 3 + size : Lit of clause
-ClausesBuffer::ClausesBuffer(int _nbThreads, unsigned int _maxsize) : first(0), last(_maxsize-1),  
-    maxsize(_maxsize), queuesize(0), 
-    removedClauses(0),
-    forcedRemovedClauses(0), nbThreads(_nbThreads), 
-    whenFullRemoveOlder(opt_whenFullRemoveOlder), fifoSizeByCore(opt_fifoSizeByCore) {
-	lastOfThread.growTo(_nbThreads);
-	for(int i=0;i<nbThreads;i++) lastOfThread[i] = _maxsize-1;
-	elems.growTo(maxsize);
+ClausesBuffer::ClausesBuffer(int _nbThreads, unsigned int _maxsize) : rings(NULL), cursors(NULL),
+    ringsize(0), maxsize(0), nbThreads(0),
+    whenFullRemoveOlder(opt_whenFullRemoveOlder), fifoSizeByCore(_maxsize / (_nbThreads > 0 ? _nbThreads : 1)) {
+	setNbThreads(_nbThreads);
 } 
 
-ClausesBuffer::ClausesBuffer() : first(0), last(0), maxsize(0), queuesize(0), removedClauses(0), forcedRemovedClauses(0), nbThreads(0),
+ClausesBuffer::ClausesBuffer() : rings(NULL), cursors(NULL), ringsize(0), maxsize(0), nbThreads(0),
                                  whenFullRemoveOlder(opt_whenFullRemoveOlder), fifoSizeByCore(opt_fifoSizeByCore) {}
 
-void ClausesBuffer::setNbThreads(int _nbThreads) {
-    unsigned int _maxsize = fifoSizeByCore*_nbThreads;
-    last = _maxsize -1;
-    maxsize = _maxsize;
-    nbThreads = _nbThreads;
-    lastOfThread.growTo(_nbThreads);
-    for(int i=0;i<nbThreads;i++) lastOfThread[i] = _maxsize-1;
-    elems.growTo(maxsize);
+ClausesBuffer::~ClausesBuffer() {
+    delete [] rings;
+    delete [] cursors;
 }
 
-uint32_t ClausesBuffer::getCap() {
-    return elems.capacity();
-}
-inline unsigned int ClausesBuffer::nextIndex(unsigned int i) {
-    i++;
-    if (i == maxsize)
-	return 0;
-    return i;
+void ClausesBuffer::setNbThreads(int _nbThreads) {
+    delete [] rings;
+    delete [] cursors;
+    nbThreads = _nbThreads;
+    ringsize  = fifoSizeByCore;
+    maxsize   = fifoSizeByCore*_nbThreads;
+    rings     = new Ring[nbThreads];
+    for(int i=0;i<nbThreads;i++) {
+	rings[i].elems = new std::atomic<uint32_t>[ringsize];
+	for(unsigned int j=0;j<ringsize;j++) rings[i].elems[j].store(0, std::memory_order_relaxed);
+    }
+    cursors = new std::atomic<uint64_t>[nbThreads*nbThreads];
+    for(int i=0;i<nbThreads*nbThreads;i++) cursors[i].store(0, std::memory_order_relaxed);
+    nextProducer.clear();
+    for(int i=0;i<nbThreads;i++) nextProducer.push((i+1) % nbThreads);
 }
 
-inline unsigned int ClausesBuffer::addIndex(unsigned int i, unsigned int a) {
-    i += a;
-    if (i >= maxsize)
-	return i - maxsize;
-    return i;
+int ClausesBuffer::size() {
+    uint64_t s = 0;
+    for(int i=0;i<nbThreads;i++)
+	s += rings[i].head.load(std::memory_order_relaxed) - rings[i].tail.load(std::memory_order_relaxed);
+    return (int) s;
 }
 
-void ClausesBuffer::removeLastClause() {
-    assert(queuesize > 0);
-    do {
-	unsigned int size = (unsigned int) elems[nextIndex(last)];
-	unsigned int nextlast = addIndex(last, size+headerSize);
 
+// Return true if the clause was succesfully added
+bool ClausesBuffer::pushClause(int threadId, Clause & c) {
+    assert(threadId < nbThreads);
+    Ring& r    = rings[threadId];
+    uint64_t h = r.head.load(std::memory_order_relaxed);
+    uint64_t t = r.tail.load(std::memory_order_relaxed);
+    uint64_t n = c.size() + headerSize;
+    if (n > ringsize) return false;
+
+    if (!whenFullRemoveOlder) {
+	// Space is reclaimed only once all other threads have read past it
+	uint64_t oldest = h;
 	for(int i=0;i<nbThreads;i++) {
-	    if (lastOfThread[i] == last)
-		lastOfThread[i] = nextlast;
+	    if (i == threadId) continue;
+	    uint64_t cur = cursors[i*nbThreads + threadId].load(std::memory_order_acquire);
+	    if (cur < oldest) oldest = cur;
 	}
+	while (t < oldest) t += at(r, t) + headerSize;
+	assert(t == oldest);
+	if (h + n - t > ringsize) return false;
+    } else {
+	while (h + n - t > ringsize) // We need to remove some old clauses
+	    t += at(r, t) + headerSize;
+    }
 
-	// printf("Removing clause starting at %d of size %d.\n",nextIndex(last), size);
-	for(unsigned int i=0;i<size+headerSize;i++) {
-	    last = nextIndex(last);
-	    assert(queuesize > 0);
-	    queuesize --;
-	}	
-	removedClauses ++;
-	assert(last >= 0);
-	assert(last < maxsize);
-	assert(last == nextlast);
-    } while (queuesize > 0 && (elems[addIndex(last,2)] == 0)); 	
-
-}
-
-
-// Pushes a single uint to the fifo
-inline void ClausesBuffer::noCheckPush(uint32_t x) {
-    elems[first] = x;
-    first = nextIndex(first);
-}
+    // Readers have to see the new tail before any word of the removed clauses is overwritten
+    r.tail.store(t, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
 
-// Pops a single uint from the fifo
-inline uint32_t ClausesBuffer::noCheckPop(uint32_t & index) {
-    index = nextIndex(index);
-    uint32_t ret = elems[index];
-    return ret;
+    r.elems[h % ringsize].store(c.size(), std::memory_order_relaxed);
+    for(int i=0;i<c.size();i++)
+	r.elems[(h + headerSize + i) % ringsize].store(toInt(c[i]), std::memory_order_relaxed);
+    r.head.store(h + n, std::memory_order_release);
+    return true;
 }
 
+// Copies the next clause of the producer into resultClause, returns false if there is none
+bool ClausesBuffer::readClause(int threadId, int producer, vec<Lit> & resultClause) {
+    Ring& r = rings[producer];
+    std::atomic<uint64_t>& cursor = cursors[threadId*nbThreads + producer];
+    uint64_t pos = cursor.load(std::memory_order_relaxed);
+
+    for(;;) {
+	uint64_t h = r.head.load(std::memory_order_acquire);
+	if (pos == h) break;
+	uint64_t t = r.tail.load(std::memory_order_relaxed);
+	if (pos < t) { pos = t; continue; } // The clauses we did not read yet were removed
+
+	uint32_t csize = at(r, pos);
+	if (pos + headerSize + csize <= h) { // Otherwise we read a word that is being overwritten
+	    resultClause.clear();
+	    for(uint32_t i=0;i<csize;i++)
+		resultClause.push(toLit(at(r, pos + headerSize + i)));
+	}
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (r.tail.load(std::memory_order_relaxed) > pos) continue; // Overwritten while we were reading
+	assert(pos + headerSize + csize <= h);
 
-
-// Return true if the clause was succesfully added
-bool ClausesBuffer::pushClause(int threadId, Clause & c) {
-    if (!whenFullRemoveOlder && (queuesize + c.size() + headerSize >= maxsize))
-	return false; // We need to remove some old clauses
-    while (queuesize + c.size() + headerSize >= maxsize) { // We need to remove some old clauses
-	forcedRemovedClauses ++;
-	removeLastClause();
-	assert(queuesize > 0);
+	pos += csize + headerSize;
+	cursor.store(pos, std::memory_order_release);
+	return true;
     }
-    noCheckPush(c.size());
-    noCheckPush(nbThreads>1?nbThreads-1:1);
-    noCheckPush(threadId);
-    for(int i=0;i<c.size();i++)
-	noCheckPush(toInt(c[i]));
-    queuesize += c.size()+headerSize;
-    return true;
-    //  printf(" -> (%d, %d)\n", first, last);
+    cursor.store(pos, std::memory_order_release);
+    return false;
 }
 
 bool ClausesBuffer::getClause(int threadId, int & threadOrigin, vec<Lit> & resultClause,  bool firstFound) {
-    assert(lastOfThread.size() > threadId);
-    unsigned int thislast = lastOfThread[threadId];
-    assert(!firstFound || thislast == last); // FIXME: Gilles has this assertion on his cluster
-
-    // Early exiting
-    if (nextIndex(thislast) == first) return false;
-
-    if ( ( thislast < last && last < first) ||
-	    ( first < thislast && thislast < last ) ||
-	    ( last < first && first < thislast) ) {
-	// Special case where last has moved and lastOfThread[threadId] is no more valid (is behind)
-	thislast = last; 
-    }
+    assert(nextProducer.size() > threadId);
     assert(!firstFound);
-    // Go to next clause for this thread id
-    if (!firstFound) { 
-	while (nextIndex(thislast) != first && elems[addIndex(thislast,3)] == ((unsigned int)threadId)) { // 3 = 2 + 1 
-	    thislast = addIndex(thislast, elems[nextIndex(thislast)] + headerSize); // 
-	    assert(thislast >= 0);
-	    assert(thislast < maxsize);
+    int p = nextProducer[threadId];
+    for(int k=0;k<nbThreads;k++, p = (p+1) % nbThreads) {
+	if (p == threadId) continue;
+	if (readClause(threadId, p, resultClause)) {
+	    threadOrigin = p;
+	    nextProducer[threadId] = (p+1) % nbThreads;
+	    return true;
 	}
-	assert(nextIndex(thislast)==first || elems[addIndex(thislast,3)] != (unsigned int)threadId);
-    }
-
-    if (nextIndex(thislast) == first) {
-	lastOfThread[threadId] = thislast;
-	return false;
-    }  
-    assert(elems[addIndex(thislast,3)] != ((unsigned int) threadId));
-    unsigned int previouslast = thislast;
-    bool removeAfter = false;
-    int csize = noCheckPop(thislast);
-    removeAfter = (--elems[addIndex(thislast,1)] == 0); // We are sure this is not one of our own clause
-    thislast = nextIndex(thislast); // Skips the removeAfter fieldr
-    threadOrigin = noCheckPop(thislast);
-    assert(threadOrigin != threadId);
-    resultClause.clear();
-    for(int i=0;i<csize;i++) {
-	resultClause.push(toLit(noCheckPop(thislast)));
     }
-    if (last == previouslast && removeAfter) {
-	removeLastClause();
-	thislast = last;
-    }
-    lastOfThread[threadId] = thislast;
-    return true;
+    return false;
 }
 
 
 //=================================================================================================
-
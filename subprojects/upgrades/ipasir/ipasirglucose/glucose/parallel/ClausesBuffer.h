@@ -50,6 +50,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef ClausesBuffer_h 
 #define ClausesBuffer_h
 
+#include <atomic>
+
 #include "mtl/Vec.h"
 #include "core/SolverTypes.h"
 #include "core/Solver.h"
@@ -57,54 +59,46 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 //=================================================================================================
 
 namespace Glucose {
-    // index : size clause
-    // index + 1 : nbSeen
-    // index + 2 : threadId
-    // index + 3 : .. index + 3 + size : Lit of clause
+    // One ring per producing thread, words are counted from the start (they never wrap):
+    // position     : size clause
+    // position + 1 : .. position + size : Lit of clause
     class ClausesBuffer {
-	vec<uint32_t>  elems;
-	unsigned int     first;
-	unsigned int	 last;
-	unsigned int     maxsize;
-	unsigned int     queuesize; // Number of current elements (must be < maxsize !)
-	unsigned int     removedClauses;
-	unsigned int     forcedRemovedClauses;
-        static const int  headerSize = 3;
+	struct Ring {
+	    std::atomic<uint32_t>* elems;
+	    std::atomic<uint64_t>  head;  // Next position written by the producer
+	    std::atomic<uint64_t>  tail;  // Position of the oldest clause still in the ring
+	    char padding[64];             // Keep the rings of different producers on different cache lines
+	    Ring() : elems(NULL), head(0), tail(0) {}
+	    ~Ring() { delete [] elems; }
+	};
+
+	Ring*                  rings;
+	std::atomic<uint64_t>* cursors;  // cursors[reader * nbThreads + producer]: next position to read
+	vec<int>               nextProducer; // Ring to look at first, for each reader (round robin)
+	unsigned int           ringsize;
+	unsigned int           maxsize;
+        static const int       headerSize = 1;
 	int       nbThreads;
 	bool      whenFullRemoveOlder;
 	unsigned int fifoSizeByCore;
-	vec<unsigned int> lastOfThread; // Last value for a thread 
+
+	uint32_t  at(const Ring& r, uint64_t pos) const { return r.elems[pos % ringsize].load(std::memory_order_relaxed); }
+	bool      readClause(int threadId, int producer, vec<Lit> & resultClause);
 
 	public:
 	ClausesBuffer(int _nbThreads, unsigned int _maxsize);
 	ClausesBuffer();
+	~ClausesBuffer();
 
 	void setNbThreads(int _nbThreads);
-	unsigned int nextIndex(unsigned int i);
-	unsigned int addIndex(unsigned int i, unsigned int a); 
-	void removeLastClause(); 
-	   
-	void noCheckPush(uint32_t x);
-	uint32_t noCheckPop(unsigned int & index);
-
-	// Return true if the clause was succesfully added
+
+	// Return true if the clause was succesfully added (only thread threadId may push on its ring)
         bool pushClause(int threadId, Clause & c);
         bool getClause(int threadId, int & threadOrigin, vec<Lit> & resultClause, bool firstFound = false); 
 	
 	int maxSize() const {return maxsize;}
-        uint32_t getCap();
-	void growTo(int size) {
-	    assert(0); // Not implemented (essentially for efficiency reasons)
-	    elems.growTo(size); 
-	    first=0; maxsize=size; queuesize = 0;last = 0;
-	    for(int i=0;i<size;i++) elems[i]=0; 
-	}
-
-	void fastclear() {first = 0; last = 0; queuesize=0; } 
-
-	int  size(void)    { return queuesize; }
+	int size(void);
 
-	void clear(bool dealloc = false)   { elems.clear(dealloc); first = 0; maxsize=0; queuesize=0;}
 	inline  int  toInt     (Lit p)              { return p.x; } 
 
     };
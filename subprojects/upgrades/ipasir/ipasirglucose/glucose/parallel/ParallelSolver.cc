@@ -83,6 +83,7 @@ ParallelSolver::ParallelSolver(int threadId) :
 , nbNotExportedBecauseDirectlyReused(0)
 {
     useUnaryWatched = true; // We want to use promoted clauses here !
+    chrono = -1; // Clause sharing expects the trail in order of the levels
     stats.growTo(parallelStatsSize,0);
 }
 
@@ -62,10 +62,12 @@ SharedCompanion::SharedCompanion(int _nbThreads) :
     jobFinishedBy(NULL),
     panicMode(false), // The bug in the SAT2014 competition :)
     jobStatus(l_Undef),
+    nbVars(0),
+    nbUnits(0),
+    unitLit(NULL),
+    isUnary(NULL),
     random_seed(9164825) {
 
-	pthread_mutex_init(&mutexSharedClauseCompanion,NULL); // This is the shared companion lock
-	pthread_mutex_init(&mutexSharedUnitCompanion,NULL); // This is the shared companion lock
 	pthread_mutex_init(&mutexSharedCompanion,NULL); // This is the shared companion lock
 	pthread_mutex_init(&mutexJobFinished,NULL); // This is the shared companion lock
 	if (_nbThreads> 0)  {
@@ -75,9 +77,25 @@ SharedCompanion::SharedCompanion(int _nbThreads) :
 
 }
 
+SharedCompanion::~SharedCompanion() {
+    delete [] unitLit;
+    delete [] isUnary;
+}
+
+// Not multithread safe: called once all variables are known, before the threads are started
 void SharedCompanion::setNbThreads(int _nbThreads) {
    nbThreads = _nbThreads;
    clausesBuffer.setNbThreads(_nbThreads); 
+
+   delete [] unitLit;
+   delete [] isUnary;
+   unitLit = new std::atomic<int>[nbVars];
+   isUnary = new std::atomic<char>[nbVars];
+   for (int i = 0; i < nbVars; i++) {
+       unitLit[i].store(toInt(lit_Undef), std::memory_order_relaxed);
+       isUnary[i].store(false, std::memory_order_relaxed);
+   }
+   nbUnits.store(0, std::memory_order_relaxed);
 }
 
 void SharedCompanion::printStats() {
@@ -94,26 +112,26 @@ bool SharedCompanion::addSolver(ParallelSolver* s) {
 	return true;
 }
 void SharedCompanion::newVar(bool sign) {
-   isUnary .push(l_Undef);
+   nbVars++;
 }
 
+// Each variable is shared at most once, so unitLit cannot overflow
 void SharedCompanion::addLearnt(ParallelSolver *s,Lit unary) {
-  pthread_mutex_lock(&mutexSharedUnitCompanion);
-  if (isUnary[var(unary)]==l_Undef) {
-      unitLit.push(unary);
-      isUnary[var(unary)] = sign(unary)?l_False:l_True;
+  assert(var(unary) < nbVars);
+  if (!isUnary[var(unary)].exchange(true)) {
+      int slot = nbUnits.fetch_add(1);
+      unitLit[slot].store(toInt(unary), std::memory_order_release);
   } 
-  pthread_mutex_unlock(&mutexSharedUnitCompanion);
 }
 
 Lit SharedCompanion::getUnary(ParallelSolver *s) {
   int sn = s->thn;
   Lit ret = lit_Undef;
 
-  pthread_mutex_lock(&mutexSharedUnitCompanion);
-  if (nextUnit[sn] < unitLit.size())
-      ret = unitLit[nextUnit[sn]++];
-  pthread_mutex_unlock(&mutexSharedUnitCompanion);
+  if (nextUnit[sn] < nbUnits.load(std::memory_order_acquire)) {
+      ret = toLit(unitLit[nextUnit[sn]].load(std::memory_order_acquire));
+      if (ret != lit_Undef) nextUnit[sn]++; // Otherwise the slot is reserved, but not yet written
+  }
  return ret;
 }
 
@@ -125,9 +143,7 @@ bool SharedCompanion::addLearnt(ParallelSolver *s, Clause & c) {
   bool ret = false;
   assert(watchedSolvers.size()>sn);
 
-  pthread_mutex_lock(&mutexSharedClauseCompanion);
   ret = clausesBuffer.pushClause(sn, c);
-  pthread_mutex_unlock(&mutexSharedClauseCompanion);
   return ret;
 }
 
@@ -136,9 +152,7 @@ bool SharedCompanion::getNewClause(ParallelSolver *s, int & threadOrigin, vec<Li
   int sn = s->thn;
   
     // First, let's get the clauses on the big blackboard
-    pthread_mutex_lock(&mutexSharedClauseCompanion);
     bool b = clausesBuffer.getClause(sn, threadOrigin, newclause);
-    pthread_mutex_unlock(&mutexSharedClauseCompanion);
  
   return b;
 }
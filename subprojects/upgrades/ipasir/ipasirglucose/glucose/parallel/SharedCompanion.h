@@ -47,8 +47,8 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  **************************************************************************************************/
 
-/* This class is responsible for protecting (by mutex) information exchange between threads.
- * It also allows each solver to send / receive clause / unary clauses.
+/* This class is responsible for protecting information exchange between threads.
+ * It also allows each solver to send / receive clause / unary clauses (without locks).
  *
  * Only one sharedCompanion is created for all the solvers
  */
@@ -56,6 +56,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #ifndef SharedCompanion_h
 #define SharedCompanion_h
+#include <atomic>
 #include "core/SolverTypes.h"
 #include "parallel/ParallelSolver.h"
 #include "parallel/SolverCompanion.h"
@@ -69,6 +70,7 @@ class SharedCompanion : public SolverCompanion {
     friend class ParallelSolver;
 public:
 	SharedCompanion(int nbThreads=0);
+	~SharedCompanion();
 	void setNbThreads(int _nbThreads); // Sets the number of threads (cannot by changed once the solver is running)
 	void newVar(bool sign);            // Adds a var (used to keep track of unary variables)
 	void printStats();                 // Printing statistics of all solvers
@@ -90,8 +92,6 @@ public:
 	
 	// A set of mutex variables
 	pthread_mutex_t mutexSharedCompanion; // mutex for any high level sync between all threads (like reportf)
-	pthread_mutex_t mutexSharedClauseCompanion; // mutex for reading/writing clauses on the blackboard
-	pthread_mutex_t mutexSharedUnitCompanion; // mutex for reading/writing unit clauses on the blackboard 
         pthread_mutex_t mutexJobFinished;
 
 	bool bjobFinished;
@@ -102,8 +102,10 @@ public:
         // Shared clauses are a queue of lits...
 	//	friend class wholearnt;
 	vec<int> nextUnit; // indice of next unit clause to retrieve for solver number i 
-	vec<Lit> unitLit;  // Set of unit literals found so far
-        vec<lbool> isUnary; // sign of the unary var (if proved, or l_Undef if not)	
+	int nbVars;                  // Number of variables (known before the threads are started)
+	std::atomic<int>   nbUnits;  // Number of reserved entries in unitLit
+	std::atomic<int>*  unitLit;  // Set of unit literals found so far (toInt(lit_Undef) while being written)
+	std::atomic<char>* isUnary;  // true if a unit literal of the var was shared
 	double    random_seed;
 
 	// Returns a random float 0 <= x < 1. Seed must never be 0.
@@ -168,6 +168,7 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
     vec<Var> extra_frozen;
     lbool    result = l_True;
     do_simp &= use_simplification;
+    if (do_simp) cancelUntil(0); // Elimination works on the top-level, the trail cannot be reused
 
     if (do_simp){
         // Assumptions must be temporarily frozen to run variable elimination:
@@ -213,6 +214,7 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
 #endif
     int nclauses = clauses.size();
 
+    cancelUntil(0); // see Solver::addClause_, 'implied' has to propagate at the root level
     if (use_rcheck && implied(ps))
         return true;
 
@@ -820,7 +822,7 @@ void SimpSolver::garbageCollect()
     relocAll(to);
     Solver::relocAll(to);
     if (verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n", 
-               ca.size()*ClauseAllocator::Unit_Size, to.size()*ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n", 
+               (uint64_t)ca.size()*ClauseAllocator::Unit_Size, (uint64_t)to.size()*ClauseAllocator::Unit_Size);
     to.moveTo(ca);
 }
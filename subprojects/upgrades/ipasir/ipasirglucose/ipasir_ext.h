@@ -0,0 +1,51 @@
+/* Jdrasil extensions of the generic incremental SAT API 'ipasir'.
+ * See 'LICENSE' for rights to use this software.
+ *
+ * These functions are not part of the IPASIR standard, so a backend
+ * may or may not implement them. Callers see them as weak symbols:
+ * a function that the linked backend does not provide is NULL, and
+ * has to be checked before it is called, e.g.,
+ *
+ *   if (ipasir_reset != NULL && ipasir_reset(solver)) ...
+ *
+ * A backend that implements the extensions defines
+ * IPASIR_EXT_IMPLEMENTATION before including this header.
+ */
+#ifndef ipasir_ext_h_INCLUDED
+#define ipasir_ext_h_INCLUDED
+
+#if defined(IPASIR_EXT_IMPLEMENTATION) || !defined(__GNUC__)
+#define IPASIR_EXT_OPTIONAL
+#elif defined(__APPLE__)
+#define IPASIR_EXT_OPTIONAL __attribute__((weak_import))
+#else
+#define IPASIR_EXT_OPTIONAL __attribute__((weak))
+#endif
+
+/**
+ * Announce that the formula will use the variables 1,...,n.
+ * The solver may use this hint to allocate all variable related
+ * data structures at once, instead of growing them whenever a
+ * new variable appears. Solvers that do not benefit from this
+ * hint may ignore it.
+ *
+ * Required state: INPUT or SAT or UNSAT
+ * State after: unchanged
+ */
+void ipasir_reserve (void * solver, int n) IPASIR_EXT_OPTIONAL;
+
+/**
+ * Reset the solver to the state of a freshly constructed one,
+ * i.e., remove all clauses, variables, and assumptions. Solvers
+ * may keep their allocated memory, so that the next formula can
+ * reuse it. Return 1 if the solver was reset, and 0 if the solver
+ * does not support this operation. In the later case, the solver
+ * is unchanged and the caller has to use ipasir_release and
+ * ipasir_init instead.
+ *
+ * Required state: INPUT or SAT or UNSAT
+ * State after: INPUT (if 1 is returned), unchanged otherwise
+ */
+int ipasir_reset (void * solver) IPASIR_EXT_OPTIONAL;
+
+#endif
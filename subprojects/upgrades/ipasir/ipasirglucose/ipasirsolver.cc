@@ -33,46 +33,58 @@ static double getime (void) {
 
 class IPAsirMiniSAT : public Solver {
   vec<Lit> assumptions, clause;
-  int szfmap; unsigned char * fmap; bool nomodel;
+  vec<char> core; vec<Var> coreVars; bool nomodel;
   unsigned long long calls;
-  void reset () { if (fmap) delete [] fmap, fmap = 0, szfmap = 0; }
   Lit import (int lit) { 
+    if (abs (lit) > nVars ()) reserveVars (abs (lit));
     while (abs (lit) > nVars ()) (void) newVar ();
     return mkLit (Var (abs (lit) - 1), (lit < 0));
   }
+  void clearcore () {
+    // only touch the variables of the last core
+    for (int i = 0; i < coreVars.size (); i++) core[coreVars[i]] = 0;
+    coreVars.clear ();
+  }
   void ana () {
-    fmap = new unsigned char [szfmap = nVars ()];
-    memset (fmap, 0, szfmap);
+    core.growTo (nVars (), 0);
     for (int i = 0; i < conflict.size (); i++) {
       int tmp = var (conflict[i]);
-      assert (0 <= tmp && tmp < szfmap);
-      fmap[tmp] = 1;
+      assert (0 <= tmp && tmp < core.size ());
+      if (!core[tmp]) core[tmp] = 1, coreVars.push (tmp);
     }
   }
   double ps (double s, double t) { return t ? s/t : 0; }
 public:
-  IPAsirMiniSAT () : szfmap (0), fmap (0), nomodel (false), calls (0) {
+  IPAsirMiniSAT () : nomodel (false), calls (0) {
     // MiniSAT by default produces non standard conforming messages.
     // So either we have to set this to '0' or patch the sources.
     verbosity = 0;
   }
-  ~IPAsirMiniSAT () { reset (); }
+  void reserve (int n) { if (n > nVars ()) reserveVars (n); }
+  void recycle () {
+    clearcore ();
+    core.clear ();
+    Solver::reset ();
+    assumptions.clear ();
+    clause.clear ();
+    nomodel = false;
+    calls = 0;
+  }
   void add (int lit) {
-    reset ();
     nomodel = true;
     if (lit) clause.push (import (lit));
     else addClause (clause), clause.clear ();
   }
   void assume (int lit) {
-    reset ();
     nomodel = true;
     assumptions.push (import (lit));
   }
   int solve () {
     calls++;
-    reset ();
     lbool res = solveLimited (assumptions);
     assumptions.clear ();
+    clearcore ();
+    if (res == l_False) ana ();
     nomodel = (res != l_True);
     return (res == l_Undef) ? 0 : (res == l_True ? 10 : 20);
   }
@@ -82,10 +94,8 @@ public:
     return (res == l_True) ? lit : -lit;
   }
   int failed (int lit) {
-    if (!fmap) ana ();
-    int tmp = var (import (lit));
-    assert (0 <= tmp && tmp < nVars ());
-    return fmap[tmp] != 0;
+    int tmp = abs (lit) - 1;
+    return tmp < core.size () && core[tmp] != 0;
   }
   void stats () {
     double t = getime ();
@@ -110,10 +120,14 @@ public:
 
 extern "C" {
 #include "ipasir.h"
+#define IPASIR_EXT_IMPLEMENTATION
+#include "ipasir_ext.h"
 static IPAsirMiniSAT * import (void * s) { return (IPAsirMiniSAT*) s; }
 const char * ipasir_signature () { return sig; }
 void * ipasir_init () { return new IPAsirMiniSAT (); }
 void ipasir_release (void * s) { import (s)->stats (); delete import (s); }
+void ipasir_reserve (void * s, int n) { import (s)->reserve (n); }
+int ipasir_reset (void * s) { import (s)->recycle (); return 1; }
 int ipasir_solve (void * s) { return import (s)->solve (); }
 void ipasir_add (void * s, int l) { import (s)->add (l); }
 void ipasir_assume (void * s, int l) { import (s)->assume (l); }
@@ -1,5 +1,10 @@
 /* default includes */
 #include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 
 /* JNI includes */
@@ -9,15 +14,119 @@
 /* IPASIR includes */
 extern "C" {
   #include "ipasir.h"
+  #include "ipasir_ext.h"
 }
+#include "ipasir_trace.h"
   
 //MARK: helper functions
 
+/**
+ * Everything the termination callback of a solver has to look at. The callback obtains a pointer to
+ * this struct as state, so it can be polled without any JNI upcall or hash lookup.
+ */
+struct Termination {
+  volatile int terminated;                         // set by terminate()
+  volatile jint* shutdown;                         // optional shared word (direct ByteBuffer), non-zero means stop
+  bool hasDeadline;                                // true if a deadline was set
+  std::chrono::steady_clock::time_point deadline;  // absolute point in time at which the search stops
+  unsigned int polls;                              // the clock is only read every few polls
+};
+
 /**
  * Hashmap to store the termination state of a solver.
  */
-typedef std::unordered_map< void*, int > hashmap;
-hashmap isTerminated;
+typedef std::unordered_map< void*, Termination > hashmap;
+hashmap termination;
+std::mutex terminationMutex;
+
+/**
+ * Get the termination state of the given solver (the reference stays valid until the solver is released).
+ */
+static Termination& getTermination(void* instance) {
+  std::lock_guard<std::mutex> lock(terminationMutex);
+  return termination[instance];
+}
+
+/**
+ * A solver that records its calls writes them to a trace file in the given directory (see ipasir_trace.h).
+ */
+struct Trace {
+  FILE* file;
+  std::string directory;
+};
+
+/**
+ * Hashmap to store the traces of recording solvers, solvers that do not record have no entry.
+ */
+std::unordered_map< void*, Trace > traces;
+std::mutex traceMutex;
+std::atomic<bool> recording(false);   // true once any solver records, saves the lookup otherwise
+std::atomic<unsigned int> traceCounter(0);
+
+/**
+ * Get the trace file of the given solver, or NULL if the solver does not record.
+ */
+static FILE* getTrace(void* instance) {
+  if (!recording) return NULL;
+  std::lock_guard<std::mutex> lock(traceMutex);
+  auto it = traces.find(instance);
+  return it == traces.end() ? NULL : it->second.file;
+}
+
+/**
+ * Start a new trace file for the given solver in the given directory, a running trace is closed.
+ */
+static void openTrace(void* instance, const std::string& directory) {
+  std::string name = directory + "/jdrasil-" + std::to_string(getpid()) + "-" + std::to_string(traceCounter++) + ".ipt";
+  FILE* file = fopen(name.c_str(), "wb");
+  if (file == NULL) {
+    fprintf(stderr, "c could not open trace file %s\n", name.c_str());
+    return;
+  }
+  setvbuf(file, NULL, _IOFBF, 1 << 16);
+  fwrite(IPASIR_TRACE_MAGIC, 1, sizeof(IPASIR_TRACE_MAGIC), file);
+
+  std::lock_guard<std::mutex> lock(traceMutex);
+  Trace& trace = traces[instance];
+  if (trace.file != NULL) fclose(trace.file);
+  trace.file = file;
+  trace.directory = directory;
+  recording = true;
+}
+
+/**
+ * Close the trace of the given solver (if any).
+ */
+static void closeTrace(void* instance) {
+  if (!recording) return;
+  std::lock_guard<std::mutex> lock(traceMutex);
+  auto it = traces.find(instance);
+  if (it == traces.end()) return;
+  if (it->second.file != NULL) fclose(it->second.file);
+  traces.erase(it);
+}
+
+/**
+ * Append an operation to the trace of the given solver, if it records.
+ */
+static void record(void* instance, TraceOperation op, int argument) {
+  if (!recording) return;
+  std::lock_guard<std::mutex> lock(traceMutex); // held while writing, so closeAllTraces() can not pull the file away
+  auto it = traces.find(instance);
+  if (it != traces.end() && it->second.file != NULL) traceWrite(it->second.file, op, argument);
+}
+
+/**
+ * Close the traces of all solvers, solvers that are still alive stop recording.
+ */
+static void closeAllTraces() {
+  if (!recording) return;
+  std::lock_guard<std::mutex> lock(traceMutex);
+  for (auto& entry : traces) {
+    if (entry.second.file != NULL) fclose(entry.second.file);
+  }
+  traces.clear();
+}
 
 /**
  * The three possible states a IPASIR solver can be in.
@@ -56,8 +165,12 @@ static void* getInstance(JNIEnv* env, jobject callingObject) {
 /**
  * During the solving proccess, the sat solver will call this method to check if it has to stop.
  */
-static int terminationCallback(void* instance) {
-  return isTerminated[instance];
+static int terminationCallback(void* state) {
+  Termination* t = (Termination*) state;
+  if (t->terminated) return 1;
+  if (t->shutdown != NULL && *(t->shutdown) != 0) return 1;
+  if (!t->hasDeadline || (t->polls++ & 63) != 0) return 0;
+  return std::chrono::steady_clock::now() >= t->deadline;
 }
 
 /**
@@ -83,35 +196,65 @@ JNIEXPORT jstring JNICALL Java_jdrasil_sat_NativeSATSolver_signature(JNIEnv* env
 
 JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_init(JNIEnv* env, jobject callingObject) {
   void* instance = ipasir_init();
-  isTerminated[instance] = 0;  
+  getTermination(instance);
   setInstance(env, callingObject, instance);
   setSolverState(env, callingObject, INPUT);  
 }
 
 JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_release(JNIEnv* env, jobject callingObject) {
   void* instance = getInstance(env, callingObject);
+  closeTrace(instance);
   ipasir_release(instance);
   fflush(stdout);
+  std::lock_guard<std::mutex> lock(terminationMutex);
+  termination.erase(instance);
+}
+
+JNIEXPORT jboolean JNICALL Java_jdrasil_sat_NativeSATSolver_reset(JNIEnv* env, jobject callingObject) {
+  void* instance = getInstance(env, callingObject);
+  if (ipasir_reset == NULL || !ipasir_reset(instance)) return (jboolean) 0; // optional extension
+  getTermination(instance).terminated = 0;
+  if (getTrace(instance) != NULL) { // every formula gets its own trace
+    std::string directory;
+    {
+      std::lock_guard<std::mutex> lock(traceMutex);
+      directory = traces[instance].directory;
+    }
+    openTrace(instance, directory);
+  }
+  setSolverState(env, callingObject, INPUT);
+  return (jboolean) 1;
+}
+
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_reserve(JNIEnv* env, jobject callingObject, jint n) {
+  void* instance = getInstance(env, callingObject);
+  record(instance, TRACE_RESERVE, n);
+  if (ipasir_reserve != NULL) ipasir_reserve(instance, n); // optional extension, only a hint
 }
 
 JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_add(JNIEnv* env, jobject callingObject, jint literal) {
   void* instance = getInstance(env, callingObject);  
+  record(instance, TRACE_ADD, literal);
   ipasir_add(instance, literal);
   setSolverState(env, callingObject, INPUT);
 }
 
 JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_assume(JNIEnv* env, jobject callingObject, jint literal) {
   void* instance = getInstance(env, callingObject);
+  record(instance, TRACE_ASSUME, literal);
   ipasir_assume(instance, literal);
   setSolverState(env, callingObject, INPUT);
 }
 
 JNIEXPORT jint JNICALL Java_jdrasil_sat_NativeSATSolver_solve(JNIEnv* env, jobject callingObject) {
   void* instance = getInstance(env, callingObject);
-  isTerminated[instance] = 0;
-  ipasir_set_terminate(instance, instance, terminationCallback);
+  Termination& t = getTermination(instance);
+  t.terminated = 0;
+  t.polls = 0;
+  ipasir_set_terminate(instance, &t, terminationCallback);
 
   int result = ipasir_solve(instance);
+  record(instance, TRACE_SOLVE, result);
   switch (result) {
   case 10:
       setSolverState(env, callingObject, SAT);
@@ -127,15 +270,40 @@ JNIEXPORT jint JNICALL Java_jdrasil_sat_NativeSATSolver_solve(JNIEnv* env, jobje
 
 JNIEXPORT jint JNICALL Java_jdrasil_sat_NativeSATSolver_val(JNIEnv* env, jobject callingObject, jint literal) {
   void* instance = getInstance(env, callingObject);
+  record(instance, TRACE_VAL, literal);
   return ipasir_val(instance, literal);
 }
 
 JNIEXPORT jboolean JNICALL Java_jdrasil_sat_NativeSATSolver_failed(JNIEnv* env, jobject callingObject, jint literal) {
   void* instance = getInstance(env, callingObject);
+  record(instance, TRACE_FAILED, literal);
   return (jboolean) ipasir_failed(instance, literal);
 }
 
 JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_terminate(JNIEnv* env, jobject callingObject) {
   void* instance = getInstance(env, callingObject);
-  isTerminated[instance] = 1;
+  getTermination(instance).terminated = 1;
+}
+
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_setTimeout(JNIEnv* env, jobject callingObject, jlong nanos) {
+  void* instance = getInstance(env, callingObject);
+  Termination& t = getTermination(instance);
+  t.deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(nanos > 0 ? nanos : 0);
+  t.hasDeadline = true;
+}
+
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_setShutdownWord(JNIEnv* env, jobject callingObject, jobject buffer) {
+  void* instance = getInstance(env, callingObject);
+  getTermination(instance).shutdown = buffer == NULL ? NULL : (volatile jint*) env->GetDirectBufferAddress(buffer);
+}
+
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_record(JNIEnv* env, jobject callingObject, jstring directory) {
+  void* instance = getInstance(env, callingObject);
+  const char* path = env->GetStringUTFChars(directory, NULL);
+  openTrace(instance, path);
+  env->ReleaseStringUTFChars(directory, path);
+}
+
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_closeTraces(JNIEnv* env, jclass callingClass) {
+  closeAllTraces();
 }
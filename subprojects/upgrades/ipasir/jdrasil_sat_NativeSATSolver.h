@@ -31,6 +31,22 @@ JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_init
 JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_release
   (JNIEnv *, jobject);
 
+/*
+ * Class:     jdrasil_sat_NativeSATSolver
+ * Method:    reset
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_jdrasil_sat_NativeSATSolver_reset
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     jdrasil_sat_NativeSATSolver
+ * Method:    reserve
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_reserve
+  (JNIEnv *, jobject, jint);
+
 /*
  * Class:     jdrasil_sat_NativeSATSolver
  * Method:    add
@@ -79,6 +95,38 @@ JNIEXPORT jboolean JNICALL Java_jdrasil_sat_NativeSATSolver_failed
 JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_terminate
   (JNIEnv *, jobject);
 
+/*
+ * Class:     jdrasil_sat_NativeSATSolver
+ * Method:    setTimeout
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_setTimeout
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     jdrasil_sat_NativeSATSolver
+ * Method:    setShutdownWord
+ * Signature: (Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_setShutdownWord
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     jdrasil_sat_NativeSATSolver
+ * Method:    record
+ * Signature: (Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_record
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     jdrasil_sat_NativeSATSolver
+ * Method:    closeTraces
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_jdrasil_sat_NativeSATSolver_closeTraces
+  (JNIEnv *, jclass);
+
 #ifdef __cplusplus
 }
 #endif